@@ -21,6 +21,8 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2023-XX-XX: Platform: Added ImGui_ImplGlfw_SetSwapInterval()/ImGui_ImplGlfw_PresentMainViewport() so that only one viewport swap per frame waits for vsync.
+//  2023-XX-XX: Platform: Added ImGui_ImplGlfw_SetWindowPoolSize() to recycle hidden secondary viewport windows instead of destroying them.
 //  2023-XX-XX: Platform: Added support for multiple windows via the ImGuiPlatformIO interface.
 //  2023-04-04: Inputs: Added support for io.AddMouseSourceEvent() to discriminate ImGuiMouseSource_Mouse/ImGuiMouseSource_TouchScreen/ImGuiMouseSource_Pen on Windows ONLY, using a custom WndProc hook. (#2702)
 //  2023-03-16: Inputs: Fixed key modifiers handling on secondary viewports (docking branch). Broken on 2023/01/04. (#6248, #6034)
@@ -129,6 +131,12 @@ enum GlfwClientApi
     GlfwClientApi_Vulkan
 };
 
+struct ImGui_ImplGlfw_PooledWindow
+{
+    GLFWwindow*             Window;
+    ImGuiViewportFlags      Flags;  // Creation flags, see ImGui_ImplGlfw_WindowPoolFlags
+};
+
 struct ImGui_ImplGlfw_Data
 {
     GLFWwindow*             Window;
@@ -142,6 +150,19 @@ struct ImGui_ImplGlfw_Data
     bool                    CallbacksChainForAllWindows;
     bool                    WantUpdateMonitors;
 
+    // Hidden secondary viewport windows kept for reuse
+    ImVector<ImGui_ImplGlfw_PooledWindow> WindowPool;
+    int                     WindowPoolMax;
+    int                     WindowPoolHits;
+    int                     WindowPoolMisses;
+
+    // Presentation: only one swap per frame waits for vsync
+    int                     SwapInterval;
+    int                     MainSwapInterval;       // Interval currently set on the main window context, -1 when unknown
+    float                   MainPresentTime;
+    bool                    MainViewportWaits;      // Main viewport is visible this frame and waits for vsync
+    bool                    SecondaryViewportWaited;
+
     // Chain GLFW callbacks: our callbacks will call the user's previously installed callbacks, if any.
     GLFWwindowfocusfun      PrevUserCallbackWindowFocus;
     GLFWcursorposfun        PrevUserCallbackCursorPos;
@@ -606,6 +627,9 @@ static bool ImGui_ImplGlfw_Init(GLFWwindow* window, bool install_callbacks, Glfw
     bd->Window = window;
     bd->Time = 0.0;
     bd->WantUpdateMonitors = true;
+    bd->WindowPoolMax = 4;
+    bd->MainSwapInterval = -1;
+    bd->MainViewportWaits = true;
 
     io.SetClipboardTextFn = ImGui_ImplGlfw_SetClipboardText;
     io.GetClipboardTextFn = ImGui_ImplGlfw_GetClipboardText;
@@ -938,6 +962,40 @@ void ImGui_ImplGlfw_NewFrame()
 
     // Update game controllers (if enabled and available)
     ImGui_ImplGlfw_UpdateGamepads();
+
+    // Decide which swap waits for vsync this frame
+    bd->MainViewportWaits = glfwGetWindowAttrib(bd->Window, GLFW_VISIBLE) && !glfwGetWindowAttrib(bd->Window, GLFW_ICONIFIED);
+    bd->SecondaryViewportWaited = false;
+}
+
+void ImGui_ImplGlfw_SetSwapInterval(int swap_interval)
+{
+    ImGui_ImplGlfw_Data* bd = ImGui_ImplGlfw_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplGlfw_InitForXXX()?");
+    bd->SwapInterval = swap_interval;
+}
+
+// Swap with the given interval, which is only changed on the context (current) when needed
+static void ImGui_ImplGlfw_Present(GLFWwindow* window, int swap_interval, int* current_swap_interval, float* out_present_time)
+{
+    if (*current_swap_interval != swap_interval)
+    {
+        glfwSwapInterval(swap_interval);
+        *current_swap_interval = swap_interval;
+    }
+    double start_time = glfwGetTime();
+    glfwSwapBuffers(window);
+    *out_present_time = (float)(glfwGetTime() - start_time);
+}
+
+void ImGui_ImplGlfw_PresentMainViewport()
+{
+    ImGui_ImplGlfw_Data* bd = ImGui_ImplGlfw_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplGlfw_InitForXXX()?");
+    if (bd->ClientApi != GlfwClientApi_OpenGL)
+        return;
+    glfwMakeContextCurrent(bd->Window);
+    ImGui_ImplGlfw_Present(bd->Window, bd->MainViewportWaits ? bd->SwapInterval : 0, &bd->MainSwapInterval, &bd->MainPresentTime);
 }
 
 //--------------------------------------------------------------------------------------------------------
@@ -953,8 +1011,10 @@ struct ImGui_ImplGlfw_ViewportData
     bool        WindowOwned;
     int         IgnoreWindowPosEventFrame;
     int         IgnoreWindowSizeEventFrame;
+    int         SwapInterval;   // Interval currently set on the window context, -1 when unknown (e.g. reused from the window pool)
+    float       PresentTime;
 
-    ImGui_ImplGlfw_ViewportData()  { Window = nullptr; WindowOwned = false; IgnoreWindowSizeEventFrame = IgnoreWindowPosEventFrame = -1; }
+    ImGui_ImplGlfw_ViewportData()  { Window = nullptr; WindowOwned = false; IgnoreWindowSizeEventFrame = IgnoreWindowPosEventFrame = -1; SwapInterval = -1; PresentTime = 0.0f; }
     ~ImGui_ImplGlfw_ViewportData() { IM_ASSERT(Window == nullptr); }
 };
 
@@ -1000,11 +1060,12 @@ static void ImGui_ImplGlfw_WindowSizeCallback(GLFWwindow* window, int, int)
     }
 }
 
-static void ImGui_ImplGlfw_CreateWindow(ImGuiViewport* viewport)
+// Viewport flags which are baked into a window when creating it, pooled windows are only reused for matching viewports
+static const ImGuiViewportFlags ImGui_ImplGlfw_WindowPoolFlags = ImGuiViewportFlags_NoDecoration | ImGuiViewportFlags_TopMost | ImGuiViewportFlags_NoTaskBarIcon;
+
+static GLFWwindow* ImGui_ImplGlfw_CreatePlatformWindow(int width, int height, ImGuiViewportFlags flags)
 {
     ImGui_ImplGlfw_Data* bd = ImGui_ImplGlfw_GetBackendData();
-    ImGui_ImplGlfw_ViewportData* vd = IM_NEW(ImGui_ImplGlfw_ViewportData)();
-    viewport->PlatformUserData = vd;
 
     // GLFW 3.2 unfortunately always set focus on glfwCreateWindow() if GLFW_VISIBLE is set, regardless of GLFW_FOCUSED
     // With GLFW 3.3, the hint GLFW_FOCUS_ON_SHOW fixes this problem
@@ -1013,12 +1074,57 @@ static void ImGui_ImplGlfw_CreateWindow(ImGuiViewport* viewport)
 #if GLFW_HAS_FOCUS_ON_SHOW
     glfwWindowHint(GLFW_FOCUS_ON_SHOW, false);
  #endif
-    glfwWindowHint(GLFW_DECORATED, (viewport->Flags & ImGuiViewportFlags_NoDecoration) ? false : true);
+    glfwWindowHint(GLFW_DECORATED, (flags & ImGuiViewportFlags_NoDecoration) ? false : true);
 #if GLFW_HAS_WINDOW_TOPMOST
-    glfwWindowHint(GLFW_FLOATING, (viewport->Flags & ImGuiViewportFlags_TopMost) ? true : false);
+    glfwWindowHint(GLFW_FLOATING, (flags & ImGuiViewportFlags_TopMost) ? true : false);
 #endif
     GLFWwindow* share_window = (bd->ClientApi == GlfwClientApi_OpenGL) ? bd->Window : nullptr;
-    vd->Window = glfwCreateWindow((int)viewport->Size.x, (int)viewport->Size.y, "No Title Yet", nullptr, share_window);
+    GLFWwindow* window = glfwCreateWindow(width, height, "No Title Yet", nullptr, share_window);
+
+    // Install GLFW callbacks for secondary viewports
+    glfwSetWindowFocusCallback(window, ImGui_ImplGlfw_WindowFocusCallback);
+    glfwSetCursorEnterCallback(window, ImGui_ImplGlfw_CursorEnterCallback);
+    glfwSetCursorPosCallback(window, ImGui_ImplGlfw_CursorPosCallback);
+    glfwSetMouseButtonCallback(window, ImGui_ImplGlfw_MouseButtonCallback);
+    glfwSetScrollCallback(window, ImGui_ImplGlfw_ScrollCallback);
+    glfwSetKeyCallback(window, ImGui_ImplGlfw_KeyCallback);
+    glfwSetCharCallback(window, ImGui_ImplGlfw_CharCallback);
+    glfwSetWindowCloseCallback(window, ImGui_ImplGlfw_WindowCloseCallback);
+    glfwSetWindowPosCallback(window, ImGui_ImplGlfw_WindowPosCallback);
+    glfwSetWindowSizeCallback(window, ImGui_ImplGlfw_WindowSizeCallback);
+    if (bd->ClientApi == GlfwClientApi_OpenGL)
+    {
+        glfwMakeContextCurrent(window);
+        glfwSwapInterval(0);
+    }
+    return window;
+}
+
+static void ImGui_ImplGlfw_CreateWindow(ImGuiViewport* viewport)
+{
+    ImGui_ImplGlfw_Data* bd = ImGui_ImplGlfw_GetBackendData();
+    ImGui_ImplGlfw_ViewportData* vd = IM_NEW(ImGui_ImplGlfw_ViewportData)();
+    viewport->PlatformUserData = vd;
+
+    // Reuse a hidden window created with the same flags if we have one, it only needs to be moved and resized
+    const ImGuiViewportFlags flags = viewport->Flags & ImGui_ImplGlfw_WindowPoolFlags;
+    for (int n = bd->WindowPool.Size - 1; n >= 0 && vd->Window == nullptr; n--)
+        if (bd->WindowPool[n].Flags == flags)
+        {
+            vd->Window = bd->WindowPool[n].Window;
+            bd->WindowPool.erase(bd->WindowPool.Data + n);
+        }
+    vd->IgnoreWindowSizeEventFrame = vd->IgnoreWindowPosEventFrame = ImGui::GetFrameCount();
+    if (vd->Window != nullptr)
+    {
+        bd->WindowPoolHits++;
+        glfwSetWindowSize(vd->Window, (int)viewport->Size.x, (int)viewport->Size.y);
+    }
+    else
+    {
+        bd->WindowPoolMisses++;
+        vd->Window = ImGui_ImplGlfw_CreatePlatformWindow((int)viewport->Size.x, (int)viewport->Size.y, flags);
+    }
     vd->WindowOwned = true;
     viewport->PlatformHandle = (void*)vd->Window;
 #ifdef _WIN32
@@ -1027,23 +1133,6 @@ static void ImGui_ImplGlfw_CreateWindow(ImGuiViewport* viewport)
     viewport->PlatformHandleRaw = (void*)glfwGetCocoaWindow(vd->Window);
 #endif
     glfwSetWindowPos(vd->Window, (int)viewport->Pos.x, (int)viewport->Pos.y);
-
-    // Install GLFW callbacks for secondary viewports
-    glfwSetWindowFocusCallback(vd->Window, ImGui_ImplGlfw_WindowFocusCallback);
-    glfwSetCursorEnterCallback(vd->Window, ImGui_ImplGlfw_CursorEnterCallback);
-    glfwSetCursorPosCallback(vd->Window, ImGui_ImplGlfw_CursorPosCallback);
-    glfwSetMouseButtonCallback(vd->Window, ImGui_ImplGlfw_MouseButtonCallback);
-    glfwSetScrollCallback(vd->Window, ImGui_ImplGlfw_ScrollCallback);
-    glfwSetKeyCallback(vd->Window, ImGui_ImplGlfw_KeyCallback);
-    glfwSetCharCallback(vd->Window, ImGui_ImplGlfw_CharCallback);
-    glfwSetWindowCloseCallback(vd->Window, ImGui_ImplGlfw_WindowCloseCallback);
-    glfwSetWindowPosCallback(vd->Window, ImGui_ImplGlfw_WindowPosCallback);
-    glfwSetWindowSizeCallback(vd->Window, ImGui_ImplGlfw_WindowSizeCallback);
-    if (bd->ClientApi == GlfwClientApi_OpenGL)
-    {
-        glfwMakeContextCurrent(vd->Window);
-        glfwSwapInterval(0);
-    }
 }
 
 static void ImGui_ImplGlfw_DestroyWindow(ImGuiViewport* viewport)
@@ -1063,8 +1152,28 @@ static void ImGui_ImplGlfw_DestroyWindow(ImGuiViewport* viewport)
             for (int i = 0; i < IM_ARRAYSIZE(bd->KeyOwnerWindows); i++)
                 if (bd->KeyOwnerWindows[i] == vd->Window)
                     ImGui_ImplGlfw_KeyCallback(vd->Window, i, 0, GLFW_RELEASE, 0); // Later params are only used for main viewport, on which this function is never called.
+            if (bd->MouseWindow == vd->Window)
+                bd->MouseWindow = nullptr;
 
-            glfwDestroyWindow(vd->Window);
+            if (bd->WindowPool.Size < bd->WindowPoolMax)
+            {
+                // Hide and undo per-viewport changes so the window can be handed to another viewport
+#if !GLFW_HAS_MOUSE_PASSTHROUGH && GLFW_HAS_WINDOW_HOVERED && defined(_WIN32)
+                ::SetWindowLongPtr(hwnd, GWLP_WNDPROC, (LONG_PTR)bd->GlfwWndProc);
+#endif
+#if GLFW_HAS_WINDOW_ALPHA
+                glfwSetWindowOpacity(vd->Window, 1.0f);
+#endif
+                glfwHideWindow(vd->Window);
+                ImGui_ImplGlfw_PooledWindow pooled_window;
+                pooled_window.Window = vd->Window;
+                pooled_window.Flags = viewport->Flags & ImGui_ImplGlfw_WindowPoolFlags;
+                bd->WindowPool.push_back(pooled_window);
+            }
+            else
+            {
+                glfwDestroyWindow(vd->Window);
+            }
         }
         vd->Window = nullptr;
         IM_DELETE(vd);
@@ -1202,11 +1311,23 @@ static void ImGui_ImplGlfw_SwapBuffers(ImGuiViewport* viewport, void*)
     ImGui_ImplGlfw_ViewportData* vd = (ImGui_ImplGlfw_ViewportData*)viewport->PlatformUserData;
     if (bd->ClientApi == GlfwClientApi_OpenGL)
     {
+        // Wait for vsync here only if the main viewport won't
+        const bool wait = !bd->MainViewportWaits && !bd->SecondaryViewportWaited;
+        bd->SecondaryViewportWaited |= wait;
         glfwMakeContextCurrent(vd->Window);
-        glfwSwapBuffers(vd->Window);
+        ImGui_ImplGlfw_Present(vd->Window, wait ? bd->SwapInterval : 0, &vd->SwapInterval, &vd->PresentTime);
     }
 }
 
+float ImGui_ImplGlfw_GetViewportPresentTime(ImGuiViewport* viewport)
+{
+    ImGui_ImplGlfw_Data* bd = ImGui_ImplGlfw_GetBackendData();
+    if (viewport == ImGui::GetMainViewport())
+        return bd->MainPresentTime;
+    ImGui_ImplGlfw_ViewportData* vd = (ImGui_ImplGlfw_ViewportData*)viewport->PlatformUserData;
+    return vd ? vd->PresentTime : 0.0f;
+}
+
 //--------------------------------------------------------------------------------------------------------
 // Vulkan support (the Vulkan renderer needs to call a platform-side support function to create the surface)
 //--------------------------------------------------------------------------------------------------------
@@ -1275,6 +1396,44 @@ static void ImGui_ImplGlfw_InitPlatformInterface()
 static void ImGui_ImplGlfw_ShutdownPlatformInterface()
 {
     ImGui::DestroyPlatformWindows();
+    ImGui_ImplGlfw_SetWindowPoolSize(0);
+}
+
+void ImGui_ImplGlfw_SetWindowPoolSize(int max_count, int prewarm_count)
+{
+    ImGui_ImplGlfw_Data* bd = ImGui_ImplGlfw_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplGlfw_InitForXXX()?");
+    IM_ASSERT(max_count >= 0 && prewarm_count <= max_count);
+    bd->WindowPoolMax = max_count;
+    while (bd->WindowPool.Size > max_count)
+    {
+        glfwDestroyWindow(bd->WindowPool.back().Window);
+        bd->WindowPool.pop_back();
+    }
+
+    // Alternate between popup/menu and tooltip flags, restoring the current context which window creation changes
+    if (prewarm_count > bd->WindowPool.Size)
+    {
+        GLFWwindow* backup_current_context = (bd->ClientApi == GlfwClientApi_OpenGL) ? glfwGetCurrentContext() : nullptr;
+        for (int n = bd->WindowPool.Size; n < prewarm_count; n++)
+        {
+            ImGui_ImplGlfw_PooledWindow pooled_window;
+            pooled_window.Flags = ImGuiViewportFlags_NoDecoration | ImGuiViewportFlags_NoTaskBarIcon | ((n & 1) ? ImGuiViewportFlags_TopMost : 0);
+            pooled_window.Window = ImGui_ImplGlfw_CreatePlatformWindow(64, 64, pooled_window.Flags);
+            bd->WindowPool.push_back(pooled_window);
+        }
+        if (bd->ClientApi == GlfwClientApi_OpenGL)
+            glfwMakeContextCurrent(backup_current_context);
+    }
+}
+
+void ImGui_ImplGlfw_GetWindowPoolStats(ImGui_ImplGlfw_WindowPoolStats* out_stats)
+{
+    ImGui_ImplGlfw_Data* bd = ImGui_ImplGlfw_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplGlfw_InitForXXX()?");
+    out_stats->PooledWindows = bd->WindowPool.Size;
+    out_stats->Hits = bd->WindowPoolHits;
+    out_stats->Misses = bd->WindowPoolMisses;
 }
 
 #if defined(__clang__)
@@ -50,3 +50,27 @@ IMGUI_IMPL_API void     ImGui_ImplGlfw_ScrollCallback(GLFWwindow* window, double
 IMGUI_IMPL_API void     ImGui_ImplGlfw_KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
 IMGUI_IMPL_API void     ImGui_ImplGlfw_CharCallback(GLFWwindow* window, unsigned int c);
 IMGUI_IMPL_API void     ImGui_ImplGlfw_MonitorCallback(GLFWmonitor* monitor, int event);
+
+// Platform window pool (multi-viewports)
+// - Windows of closed viewports (tooltips, popups, menus..) are hidden and kept for reuse instead of being destroyed,
+//   as creating a GLFW window with a shared GL context can take tens of milliseconds.
+// - Windows are only reused for viewports with the same decoration/top-most/task bar flags. Set 'max_count=0' to disable pooling.
+// - 'prewarm_count' windows are created hidden right away, using the flags of popups and tooltips.
+struct ImGui_ImplGlfw_WindowPoolStats
+{
+    int     PooledWindows;  // Hidden windows waiting for reuse
+    int     Hits;           // Viewports which reused a pooled window
+    int     Misses;         // Viewports which created a new window
+};
+IMGUI_IMPL_API void     ImGui_ImplGlfw_SetWindowPoolSize(int max_count, int prewarm_count = 0);
+IMGUI_IMPL_API void     ImGui_ImplGlfw_GetWindowPoolStats(ImGui_ImplGlfw_WindowPoolStats* out_stats);
+
+// Presentation (multi-viewports)
+// - ImGui::RenderPlatformWindowsDefault() presents secondary viewports before the application presents the main one. With vsync
+//   every swap may block for a full refresh, so only one swap per frame waits for 'swap_interval' and the other ones use interval 0.
+//   The main viewport waits, unless it is minimized or hidden in which case the first secondary viewport presented in the frame does.
+// - Call ImGui_ImplGlfw_PresentMainViewport() instead of glfwSwapBuffers() on the main window for the policy to apply to it (OpenGL only).
+// - Present time is the CPU time spent in the last glfwSwapBuffers() call of a viewport, in seconds.
+IMGUI_IMPL_API void     ImGui_ImplGlfw_SetSwapInterval(int swap_interval);
+IMGUI_IMPL_API void     ImGui_ImplGlfw_PresentMainViewport();
+IMGUI_IMPL_API float    ImGui_ImplGlfw_GetViewportPresentTime(ImGuiViewport* viewport);
@@ -0,0 +1,475 @@
+// dear imgui: Platform Backend for offscreen rendering (EGL surfaceless / OSMesa)
+// This needs to be used along with the OpenGL3 Renderer (imgui_impl_opengl3)
+// (Info: creates a headless OpenGL context without any window system, rendering to a framebuffer object which can be read back into memory.
+//  libEGL / libOSMesa are loaded at runtime, so neither is needed to build.)
+
+// Implemented features:
+//  [X] Platform: OpenGL 3.3 core context from EGL (EGL_MESA_platform_surfaceless or default display, no surface) or OSMesa (software).
+//  [X] Platform: Frame read back with ImGui_ImplOffscreen_ReadPixels().
+//  [ ] Platform: Inputs. Feed them yourself with io.AddMousePosEvent(), io.AddKeyEvent() etc.
+//  [ ] Platform: Multi-viewport support.
+
+// You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
+// If you are new to Dear ImGui, read documentation from the docs/ folder + read the top of imgui.cpp.
+// Read online: https://github.com/ocornut/imgui/tree/master/docs
+
+// CHANGELOG
+//  2023-XX-XX: Initial version.
+
+#include "imgui.h"
+#include "imgui_impl_offscreen.h"
+#include <string.h>     // memcpy
+#include <chrono>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#define IMGUI_IMPL_OFFSCREEN_APIENTRY __stdcall
+#else
+#include <dlfcn.h>
+#define IMGUI_IMPL_OFFSCREEN_APIENTRY
+#endif
+
+// Clang warnings with -Weverything
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wold-style-cast"     // warning: use of old-style cast
+#pragma clang diagnostic ignored "-Wcast-function-type" // warning: cast between incompatible function types
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcast-function-type"   // warning: cast between incompatible function types
+#endif
+
+// Minimal EGL / OSMesa / GL declarations, we don't include their headers as the libraries are loaded at runtime
+#define IMGUI_EGL_NONE                                  0x3038
+#define IMGUI_EGL_RENDERABLE_TYPE                       0x3040
+#define IMGUI_EGL_OPENGL_BIT                            0x0008
+#define IMGUI_EGL_OPENGL_API                            0x30A2
+#define IMGUI_EGL_CONTEXT_MAJOR_VERSION                 0x3098
+#define IMGUI_EGL_CONTEXT_MINOR_VERSION                 0x30FB
+#define IMGUI_EGL_CONTEXT_OPENGL_PROFILE_MASK           0x30FD
+#define IMGUI_EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT       0x0001
+#define IMGUI_EGL_PLATFORM_SURFACELESS_MESA             0x31DD
+#define IMGUI_OSMESA_FORMAT                             0x22
+#define IMGUI_OSMESA_DEPTH_BITS                         0x30
+#define IMGUI_OSMESA_STENCIL_BITS                       0x31
+#define IMGUI_OSMESA_PROFILE                            0x33
+#define IMGUI_OSMESA_CORE_PROFILE                       0x34
+#define IMGUI_OSMESA_CONTEXT_MAJOR_VERSION              0x36
+#define IMGUI_OSMESA_CONTEXT_MINOR_VERSION              0x37
+#define IMGUI_GL_RGBA                                   0x1908
+#define IMGUI_GL_RGBA8                                  0x8058
+#define IMGUI_GL_UNSIGNED_BYTE                          0x1401
+#define IMGUI_GL_PACK_ALIGNMENT                         0x0D05
+#define IMGUI_GL_FRAMEBUFFER                            0x8D40
+#define IMGUI_GL_RENDERBUFFER                           0x8D41
+#define IMGUI_GL_COLOR_ATTACHMENT0                      0x8CE0
+#define IMGUI_GL_FRAMEBUFFER_COMPLETE                   0x8CD5
+#define IMGUI_GL_FRAMEBUFFER_BINDING                    0x8CA6
+
+typedef ImGui_ImplOffscreen_Proc (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_GetProcAddress)(const char* name);
+typedef void* (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_eglGetDisplay)(void* native_display);
+typedef void* (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_eglGetPlatformDisplayEXT)(unsigned int platform, void* native_display, const int* attrib_list);
+typedef unsigned int (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_eglInitialize)(void* dpy, int* major, int* minor);
+typedef unsigned int (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_eglTerminate)(void* dpy);
+typedef unsigned int (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_eglBindAPI)(unsigned int api);
+typedef unsigned int (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_eglChooseConfig)(void* dpy, const int* attrib_list, void** configs, int config_size, int* num_config);
+typedef void* (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_eglCreateContext)(void* dpy, void* config, void* share_context, const int* attrib_list);
+typedef unsigned int (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_eglDestroyContext)(void* dpy, void* ctx);
+typedef unsigned int (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_eglMakeCurrent)(void* dpy, void* draw, void* read, void* ctx);
+typedef void* (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_OSMesaCreateContextAttribs)(const int* attrib_list, void* sharelist);
+typedef void* (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_OSMesaCreateContextExt)(unsigned int format, int depth_bits, int stencil_bits, int accum_bits, void* sharelist);
+typedef void (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_OSMesaDestroyContext)(void* ctx);
+typedef unsigned char (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_OSMesaMakeCurrent)(void* ctx, void* buffer, unsigned int type, int width, int height);
+typedef void (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_glGenFramebuffers)(int n, unsigned int* framebuffers);
+typedef void (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_glDeleteFramebuffers)(int n, const unsigned int* framebuffers);
+typedef void (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_glBindFramebuffer)(unsigned int target, unsigned int framebuffer);
+typedef unsigned int (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_glCheckFramebufferStatus)(unsigned int target);
+typedef void (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_glGenRenderbuffers)(int n, unsigned int* renderbuffers);
+typedef void (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_glDeleteRenderbuffers)(int n, const unsigned int* renderbuffers);
+typedef void (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_glBindRenderbuffer)(unsigned int target, unsigned int renderbuffer);
+typedef void (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_glRenderbufferStorage)(unsigned int target, unsigned int internalformat, int width, int height);
+typedef void (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_glFramebufferRenderbuffer)(unsigned int target, unsigned int attachment, unsigned int renderbuffertarget, unsigned int renderbuffer);
+typedef void (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_glGetIntegerv)(unsigned int pname, int* data);
+typedef void (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_glPixelStorei)(unsigned int pname, int param);
+typedef void (IMGUI_IMPL_OFFSCREEN_APIENTRY *PFN_glReadPixels)(int x, int y, int width, int height, unsigned int format, unsigned int type, void* pixels);
+
+struct ImGui_ImplOffscreen_Data
+{
+    ImGui_ImplOffscreen_Api Api;
+    void*                   Library;            // libEGL / libOSMesa
+    void*                   Display;            // EGLDisplay
+    void*                   Context;            // EGLContext / OSMesaContext
+    unsigned char           DummyBuffer[4];     // OSMesa needs a color buffer to make the context current, we render to our framebuffer instead
+    unsigned int            Framebuffer;
+    unsigned int            Renderbuffer;
+    int                     Width;
+    int                     Height;
+    double                  Time;
+    ImVector<unsigned char> ReadBuffer;
+
+    PFN_GetProcAddress      GetProcAddress;
+    PFN_eglTerminate        eglTerminate;
+    PFN_eglDestroyContext   eglDestroyContext;
+    PFN_eglMakeCurrent      eglMakeCurrent;
+    PFN_OSMesaDestroyContext OSMesaDestroyContext;
+    PFN_OSMesaMakeCurrent   OSMesaMakeCurrent;
+
+    PFN_glGenFramebuffers           glGenFramebuffers;
+    PFN_glDeleteFramebuffers        glDeleteFramebuffers;
+    PFN_glBindFramebuffer           glBindFramebuffer;
+    PFN_glCheckFramebufferStatus    glCheckFramebufferStatus;
+    PFN_glGenRenderbuffers          glGenRenderbuffers;
+    PFN_glDeleteRenderbuffers       glDeleteRenderbuffers;
+    PFN_glBindRenderbuffer          glBindRenderbuffer;
+    PFN_glRenderbufferStorage       glRenderbufferStorage;
+    PFN_glFramebufferRenderbuffer   glFramebufferRenderbuffer;
+    PFN_glGetIntegerv               glGetIntegerv;
+    PFN_glPixelStorei               glPixelStorei;
+    PFN_glReadPixels                glReadPixels;
+
+    ImGui_ImplOffscreen_Data()  { memset((void*)this, 0, sizeof(*this)); }
+};
+
+// Backend data stored in io.BackendPlatformUserData to allow support for multiple Dear ImGui contexts
+static ImGui_ImplOffscreen_Data* ImGui_ImplOffscreen_GetBackendData()
+{
+    return ImGui::GetCurrentContext() ? (ImGui_ImplOffscreen_Data*)ImGui::GetIO().BackendPlatformUserData : nullptr;
+}
+
+// Shared library helpers
+static void* ImGui_ImplOffscreen_LoadLibrary(const char* const* names)
+{
+    for (; *names != nullptr; names++)
+    {
+#ifdef _WIN32
+        if (void* library = (void*)::LoadLibraryA(*names))
+#else
+        if (void* library = dlopen(*names, RTLD_NOW | RTLD_LOCAL))
+#endif
+            return library;
+    }
+    return nullptr;
+}
+
+static void ImGui_ImplOffscreen_FreeLibrary(void* library)
+{
+#ifdef _WIN32
+    ::FreeLibrary((HMODULE)library);
+#else
+    dlclose(library);
+#endif
+}
+
+static ImGui_ImplOffscreen_Proc ImGui_ImplOffscreen_GetLibraryProc(void* library, const char* name)
+{
+#ifdef _WIN32
+    return (ImGui_ImplOffscreen_Proc)::GetProcAddress((HMODULE)library, name);
+#else
+    return (ImGui_ImplOffscreen_Proc)dlsym(library, name);
+#endif
+}
+
+static bool ImGui_ImplOffscreen_CreateContextEGL(ImGui_ImplOffscreen_Data* bd)
+{
+    static const char* const names[] = {
+#ifdef _WIN32
+        "libEGL.dll",
+#else
+        "libEGL.so.1", "libEGL.so",
+#endif
+        nullptr };
+    bd->Library = ImGui_ImplOffscreen_LoadLibrary(names);
+    if (bd->Library == nullptr)
+        return false;
+
+    bd->GetProcAddress = (PFN_GetProcAddress)ImGui_ImplOffscreen_GetLibraryProc(bd->Library, "eglGetProcAddress");
+    PFN_eglGetDisplay eglGetDisplay = (PFN_eglGetDisplay)ImGui_ImplOffscreen_GetLibraryProc(bd->Library, "eglGetDisplay");
+    PFN_eglInitialize eglInitialize = (PFN_eglInitialize)ImGui_ImplOffscreen_GetLibraryProc(bd->Library, "eglInitialize");
+    PFN_eglBindAPI eglBindAPI = (PFN_eglBindAPI)ImGui_ImplOffscreen_GetLibraryProc(bd->Library, "eglBindAPI");
+    PFN_eglChooseConfig eglChooseConfig = (PFN_eglChooseConfig)ImGui_ImplOffscreen_GetLibraryProc(bd->Library, "eglChooseConfig");
+    PFN_eglCreateContext eglCreateContext = (PFN_eglCreateContext)ImGui_ImplOffscreen_GetLibraryProc(bd->Library, "eglCreateContext");
+    bd->eglTerminate = (PFN_eglTerminate)ImGui_ImplOffscreen_GetLibraryProc(bd->Library, "eglTerminate");
+    bd->eglDestroyContext = (PFN_eglDestroyContext)ImGui_ImplOffscreen_GetLibraryProc(bd->Library, "eglDestroyContext");
+    bd->eglMakeCurrent = (PFN_eglMakeCurrent)ImGui_ImplOffscreen_GetLibraryProc(bd->Library, "eglMakeCurrent");
+    if (!bd->GetProcAddress || !eglGetDisplay || !eglInitialize || !eglBindAPI || !eglChooseConfig || !eglCreateContext || !bd->eglTerminate || !bd->eglDestroyContext || !bd->eglMakeCurrent)
+        return false;
+
+    // Prefer the surfaceless platform which needs neither a window system nor a GPU
+    PFN_eglGetPlatformDisplayEXT eglGetPlatformDisplayEXT = (PFN_eglGetPlatformDisplayEXT)bd->GetProcAddress("eglGetPlatformDisplayEXT");
+    if (eglGetPlatformDisplayEXT)
+        bd->Display = eglGetPlatformDisplayEXT(IMGUI_EGL_PLATFORM_SURFACELESS_MESA, nullptr, nullptr);
+    int major = 0, minor = 0;
+    if (bd->Display == nullptr || !eglInitialize(bd->Display, &major, &minor))
+    {
+        bd->Display = eglGetDisplay(nullptr);
+        if (bd->Display == nullptr || !eglInitialize(bd->Display, &major, &minor))
+        {
+            bd->Display = nullptr;
+            return false;
+        }
+    }
+
+    const int config_attribs[] = { IMGUI_EGL_RENDERABLE_TYPE, IMGUI_EGL_OPENGL_BIT, IMGUI_EGL_NONE };
+    const int context_attribs[] = { IMGUI_EGL_CONTEXT_MAJOR_VERSION, 3, IMGUI_EGL_CONTEXT_MINOR_VERSION, 3, IMGUI_EGL_CONTEXT_OPENGL_PROFILE_MASK, IMGUI_EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, IMGUI_EGL_NONE };
+    void* config = nullptr;
+    int num_configs = 0;
+    if (eglBindAPI(IMGUI_EGL_OPENGL_API))
+    {
+        // EGL_KHR_no_config_context first, then any configuration able to render with OpenGL
+        bd->Context = eglCreateContext(bd->Display, nullptr, nullptr, context_attribs);
+        if (bd->Context == nullptr && eglChooseConfig(bd->Display, config_attribs, &config, 1, &num_configs) && num_configs > 0)
+            bd->Context = eglCreateContext(bd->Display, config, nullptr, context_attribs);
+    }
+    if (bd->Context == nullptr || !bd->eglMakeCurrent(bd->Display, nullptr, nullptr, bd->Context))
+        return false;
+    return true;
+}
+
+static bool ImGui_ImplOffscreen_CreateContextOSMesa(ImGui_ImplOffscreen_Data* bd)
+{
+    static const char* const names[] = {
+#ifdef _WIN32
+        "osmesa.dll",
+#else
+        "libOSMesa.so.8", "libOSMesa.so.6", "libOSMesa.so",
+#endif
+        nullptr };
+    bd->Library = ImGui_ImplOffscreen_LoadLibrary(names);
+    if (bd->Library == nullptr)
+        return false;
+
+    bd->GetProcAddress = (PFN_GetProcAddress)ImGui_ImplOffscreen_GetLibraryProc(bd->Library, "OSMesaGetProcAddress");
+    PFN_OSMesaCreateContextAttribs OSMesaCreateContextAttribs = (PFN_OSMesaCreateContextAttribs)ImGui_ImplOffscreen_GetLibraryProc(bd->Library, "OSMesaCreateContextAttribs");
+    PFN_OSMesaCreateContextExt OSMesaCreateContextExt = (PFN_OSMesaCreateContextExt)ImGui_ImplOffscreen_GetLibraryProc(bd->Library, "OSMesaCreateContextExt");
+    bd->OSMesaDestroyContext = (PFN_OSMesaDestroyContext)ImGui_ImplOffscreen_GetLibraryProc(bd->Library, "OSMesaDestroyContext");
+    bd->OSMesaMakeCurrent = (PFN_OSMesaMakeCurrent)ImGui_ImplOffscreen_GetLibraryProc(bd->Library, "OSMesaMakeCurrent");
+    if (!bd->GetProcAddress || !bd->OSMesaDestroyContext || !bd->OSMesaMakeCurrent)
+        return false;
+
+    // Core profile needs OSMesaCreateContextAttribs() (Mesa 11.2+), older versions only give a legacy context
+    const int context_attribs[] = { IMGUI_OSMESA_FORMAT, IMGUI_GL_RGBA, IMGUI_OSMESA_DEPTH_BITS, 0, IMGUI_OSMESA_STENCIL_BITS, 0, IMGUI_OSMESA_PROFILE, IMGUI_OSMESA_CORE_PROFILE, IMGUI_OSMESA_CONTEXT_MAJOR_VERSION, 3, IMGUI_OSMESA_CONTEXT_MINOR_VERSION, 3, 0 };
+    if (OSMesaCreateContextAttribs)
+        bd->Context = OSMesaCreateContextAttribs(context_attribs, nullptr);
+    if (bd->Context == nullptr && OSMesaCreateContextExt)
+        bd->Context = OSMesaCreateContextExt(IMGUI_GL_RGBA, 0, 0, 0, nullptr);
+    if (bd->Context == nullptr || !bd->OSMesaMakeCurrent(bd->Context, bd->DummyBuffer, IMGUI_GL_UNSIGNED_BYTE, 1, 1))
+        return false;
+    return true;
+}
+
+static void ImGui_ImplOffscreen_DestroyContext(ImGui_ImplOffscreen_Data* bd)
+{
+    if (bd->Context != nullptr)
+    {
+        if (bd->Api == ImGui_ImplOffscreen_Api_EGL)
+        {
+            bd->eglMakeCurrent(bd->Display, nullptr, nullptr, nullptr);
+            bd->eglDestroyContext(bd->Display, bd->Context);
+        }
+        else
+        {
+            bd->OSMesaDestroyContext(bd->Context);
+        }
+        bd->Context = nullptr;
+    }
+    if (bd->Display != nullptr)
+    {
+        bd->eglTerminate(bd->Display);
+        bd->Display = nullptr;
+    }
+    if (bd->Library != nullptr)
+    {
+        ImGui_ImplOffscreen_FreeLibrary(bd->Library);
+        bd->Library = nullptr;
+    }
+}
+
+static bool ImGui_ImplOffscreen_CreateFramebuffer(ImGui_ImplOffscreen_Data* bd)
+{
+    bd->glGenFramebuffers(1, &bd->Framebuffer);
+    bd->glGenRenderbuffers(1, &bd->Renderbuffer);
+    bd->glBindRenderbuffer(IMGUI_GL_RENDERBUFFER, bd->Renderbuffer);
+    bd->glRenderbufferStorage(IMGUI_GL_RENDERBUFFER, IMGUI_GL_RGBA8, bd->Width, bd->Height);
+    bd->glBindFramebuffer(IMGUI_GL_FRAMEBUFFER, bd->Framebuffer);
+    bd->glFramebufferRenderbuffer(IMGUI_GL_FRAMEBUFFER, IMGUI_GL_COLOR_ATTACHMENT0, IMGUI_GL_RENDERBUFFER, bd->Renderbuffer);
+    return bd->glCheckFramebufferStatus(IMGUI_GL_FRAMEBUFFER) == IMGUI_GL_FRAMEBUFFER_COMPLETE;
+}
+
+static void ImGui_ImplOffscreen_DestroyFramebuffer(ImGui_ImplOffscreen_Data* bd)
+{
+    if (bd->Framebuffer) { bd->glDeleteFramebuffers(1, &bd->Framebuffer); bd->Framebuffer = 0; }
+    if (bd->Renderbuffer) { bd->glDeleteRenderbuffers(1, &bd->Renderbuffer); bd->Renderbuffer = 0; }
+}
+
+bool ImGui_ImplOffscreen_Init(int width, int height, ImGui_ImplOffscreen_Api api)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IM_ASSERT(io.BackendPlatformUserData == nullptr && "Already initialized a platform backend!");
+    IM_ASSERT(width > 0 && height > 0);
+
+    ImGui_ImplOffscreen_Data* bd = IM_NEW(ImGui_ImplOffscreen_Data)();
+    bd->Width = width;
+    bd->Height = height;
+
+    // Create a context with the first API that works
+    bool created = false;
+    if (!created && (api == ImGui_ImplOffscreen_Api_Auto || api == ImGui_ImplOffscreen_Api_EGL))
+    {
+        bd->Api = ImGui_ImplOffscreen_Api_EGL;
+        created = ImGui_ImplOffscreen_CreateContextEGL(bd);
+        if (!created)
+            ImGui_ImplOffscreen_DestroyContext(bd);
+    }
+    if (!created && (api == ImGui_ImplOffscreen_Api_Auto || api == ImGui_ImplOffscreen_Api_OSMesa))
+    {
+        bd->Api = ImGui_ImplOffscreen_Api_OSMesa;
+        created = ImGui_ImplOffscreen_CreateContextOSMesa(bd);
+        if (!created)
+            ImGui_ImplOffscreen_DestroyContext(bd);
+    }
+    if (!created)
+    {
+        IM_DELETE(bd);
+        return false;
+    }
+
+    bd->glGenFramebuffers = (PFN_glGenFramebuffers)bd->GetProcAddress("glGenFramebuffers");
+    bd->glDeleteFramebuffers = (PFN_glDeleteFramebuffers)bd->GetProcAddress("glDeleteFramebuffers");
+    bd->glBindFramebuffer = (PFN_glBindFramebuffer)bd->GetProcAddress("glBindFramebuffer");
+    bd->glCheckFramebufferStatus = (PFN_glCheckFramebufferStatus)bd->GetProcAddress("glCheckFramebufferStatus");
+    bd->glGenRenderbuffers = (PFN_glGenRenderbuffers)bd->GetProcAddress("glGenRenderbuffers");
+    bd->glDeleteRenderbuffers = (PFN_glDeleteRenderbuffers)bd->GetProcAddress("glDeleteRenderbuffers");
+    bd->glBindRenderbuffer = (PFN_glBindRenderbuffer)bd->GetProcAddress("glBindRenderbuffer");
+    bd->glRenderbufferStorage = (PFN_glRenderbufferStorage)bd->GetProcAddress("glRenderbufferStorage");
+    bd->glFramebufferRenderbuffer = (PFN_glFramebufferRenderbuffer)bd->GetProcAddress("glFramebufferRenderbuffer");
+    bd->glGetIntegerv = (PFN_glGetIntegerv)bd->GetProcAddress("glGetIntegerv");
+    bd->glPixelStorei = (PFN_glPixelStorei)bd->GetProcAddress("glPixelStorei");
+    bd->glReadPixels = (PFN_glReadPixels)bd->GetProcAddress("glReadPixels");
+    if (!bd->glGenFramebuffers || !bd->glGenRenderbuffers || !bd->glReadPixels || !ImGui_ImplOffscreen_CreateFramebuffer(bd))
+    {
+        // Legacy context without framebuffer objects
+        if (bd->glGenFramebuffers)
+            ImGui_ImplOffscreen_DestroyFramebuffer(bd);
+        ImGui_ImplOffscreen_DestroyContext(bd);
+        IM_DELETE(bd);
+        return false;
+    }
+
+    // Setup backend capabilities flags
+    io.BackendPlatformUserData = (void*)bd;
+    io.BackendPlatformName = (bd->Api == ImGui_ImplOffscreen_Api_EGL) ? "imgui_impl_offscreen (EGL)" : "imgui_impl_offscreen (OSMesa)";
+    io.DisplaySize = ImVec2((float)width, (float)height);
+    io.DisplayFramebufferScale = ImVec2(1.0f, 1.0f);
+    return true;
+}
+
+void ImGui_ImplOffscreen_Shutdown()
+{
+    ImGui_ImplOffscreen_Data* bd = ImGui_ImplOffscreen_GetBackendData();
+    IM_ASSERT(bd != nullptr && "No platform backend to shutdown, or already shutdown?");
+    ImGuiIO& io = ImGui::GetIO();
+
+    ImGui_ImplOffscreen_DestroyFramebuffer(bd);
+    ImGui_ImplOffscreen_DestroyContext(bd);
+
+    io.BackendPlatformName = nullptr;
+    io.BackendPlatformUserData = nullptr;
+    IM_DELETE(bd);
+}
+
+void ImGui_ImplOffscreen_NewFrame(float delta_time)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplOffscreen_Data* bd = ImGui_ImplOffscreen_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOffscreen_Init()?");
+
+    // Setup display size (every frame to accommodate for resizing)
+    io.DisplaySize = ImVec2((float)bd->Width, (float)bd->Height);
+    io.DisplayFramebufferScale = ImVec2(1.0f, 1.0f);
+
+    // Setup time step
+    double current_time = ImGui_ImplOffscreen_GetTime();
+    if (delta_time > 0.0f)
+        io.DeltaTime = delta_time;
+    else
+        io.DeltaTime = bd->Time > 0.0 && current_time > bd->Time ? (float)(current_time - bd->Time) : (float)(1.0f / 60.0f);
+    bd->Time = current_time;
+
+    bd->glBindFramebuffer(IMGUI_GL_FRAMEBUFFER, bd->Framebuffer);
+}
+
+ImGui_ImplOffscreen_Proc ImGui_ImplOffscreen_GetProcAddress(const char* name)
+{
+    ImGui_ImplOffscreen_Data* bd = ImGui_ImplOffscreen_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOffscreen_Init()?");
+    ImGui_ImplOffscreen_Proc proc = bd->GetProcAddress(name);
+
+    // Older EGL implementations only return extension functions, core ones are exported by the library
+    if (proc == nullptr)
+        proc = ImGui_ImplOffscreen_GetLibraryProc(bd->Library, name);
+    return proc;
+}
+
+ImGui_ImplOffscreen_Api ImGui_ImplOffscreen_GetApi()
+{
+    ImGui_ImplOffscreen_Data* bd = ImGui_ImplOffscreen_GetBackendData();
+    return bd ? bd->Api : ImGui_ImplOffscreen_Api_Auto;
+}
+
+double ImGui_ImplOffscreen_GetTime()
+{
+    using clock = std::chrono::steady_clock;
+    static const clock::time_point start_time = clock::now();
+    return std::chrono::duration<double>(clock::now() - start_time).count();
+}
+
+void ImGui_ImplOffscreen_SetSize(int width, int height)
+{
+    ImGui_ImplOffscreen_Data* bd = ImGui_ImplOffscreen_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOffscreen_Init()?");
+    IM_ASSERT(width > 0 && height > 0);
+    if (width == bd->Width && height == bd->Height)
+        return;
+    bd->Width = width;
+    bd->Height = height;
+    bd->glBindRenderbuffer(IMGUI_GL_RENDERBUFFER, bd->Renderbuffer);
+    bd->glRenderbufferStorage(IMGUI_GL_RENDERBUFFER, IMGUI_GL_RGBA8, width, height);
+}
+
+unsigned int ImGui_ImplOffscreen_GetFramebuffer()
+{
+    ImGui_ImplOffscreen_Data* bd = ImGui_ImplOffscreen_GetBackendData();
+    return bd ? bd->Framebuffer : 0;
+}
+
+void ImGui_ImplOffscreen_ReadPixels(void* out_pixels)
+{
+    ImGui_ImplOffscreen_Data* bd = ImGui_ImplOffscreen_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOffscreen_Init()?");
+
+    int last_framebuffer, last_pack_alignment;
+    bd->glGetIntegerv(IMGUI_GL_FRAMEBUFFER_BINDING, &last_framebuffer);
+    bd->glGetIntegerv(IMGUI_GL_PACK_ALIGNMENT, &last_pack_alignment);
+    bd->glBindFramebuffer(IMGUI_GL_FRAMEBUFFER, bd->Framebuffer);
+    bd->glPixelStorei(IMGUI_GL_PACK_ALIGNMENT, 4);
+
+    // GL rows are bottom-up
+    const int pitch = bd->Width * 4;
+    bd->ReadBuffer.resize(pitch * bd->Height);
+    bd->glReadPixels(0, 0, bd->Width, bd->Height, IMGUI_GL_RGBA, IMGUI_GL_UNSIGNED_BYTE, bd->ReadBuffer.Data);
+    for (int y = 0; y < bd->Height; y++)
+        memcpy((unsigned char*)out_pixels + y * pitch, bd->ReadBuffer.Data + (bd->Height - 1 - y) * pitch, (size_t)pitch);
+
+    bd->glPixelStorei(IMGUI_GL_PACK_ALIGNMENT, last_pack_alignment);
+    bd->glBindFramebuffer(IMGUI_GL_FRAMEBUFFER, (unsigned int)last_framebuffer);
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,45 @@
+// dear imgui: Platform Backend for offscreen rendering (EGL surfaceless / OSMesa)
+// This needs to be used along with the OpenGL3 Renderer (imgui_impl_opengl3)
+// (Info: creates a headless OpenGL context without any window system, rendering to a framebuffer object which can be read back into memory.
+//  libEGL / libOSMesa are loaded at runtime, so neither is needed to build.)
+
+// Implemented features:
+//  [X] Platform: OpenGL 3.3 core context from EGL (EGL_MESA_platform_surfaceless or default display, no surface) or OSMesa (software).
+//  [X] Platform: Frame read back with ImGui_ImplOffscreen_ReadPixels().
+//  [ ] Platform: Inputs. Feed them yourself with io.AddMousePosEvent(), io.AddKeyEvent() etc.
+//  [ ] Platform: Multi-viewport support.
+
+// You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
+// If you are new to Dear ImGui, read documentation from the docs/ folder + read the top of imgui.cpp.
+// Read online: https://github.com/ocornut/imgui/tree/master/docs
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+
+enum ImGui_ImplOffscreen_Api
+{
+    ImGui_ImplOffscreen_Api_Auto,       // EGL, then OSMesa
+    ImGui_ImplOffscreen_Api_EGL,
+    ImGui_ImplOffscreen_Api_OSMesa,
+};
+
+typedef void (*ImGui_ImplOffscreen_Proc)(void);
+
+// Backend API
+// - Init creates the context, makes it current and binds the framebuffer. It returns false when no API could create a context.
+// - Load your GL functions with ImGui_ImplOffscreen_GetProcAddress() (e.g. gladLoadGL()) before calling ImGui_ImplOpenGL3_Init().
+// - NewFrame binds the framebuffer. Pass 'delta_time' > 0 for fixed time steps, otherwise elapsed time is used.
+IMGUI_IMPL_API bool     ImGui_ImplOffscreen_Init(int width, int height, ImGui_ImplOffscreen_Api api = ImGui_ImplOffscreen_Api_Auto);
+IMGUI_IMPL_API void     ImGui_ImplOffscreen_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplOffscreen_NewFrame(float delta_time = 0.0f);
+
+IMGUI_IMPL_API ImGui_ImplOffscreen_Proc ImGui_ImplOffscreen_GetProcAddress(const char* name);
+IMGUI_IMPL_API ImGui_ImplOffscreen_Api  ImGui_ImplOffscreen_GetApi();
+IMGUI_IMPL_API double   ImGui_ImplOffscreen_GetTime();
+
+// Framebuffer
+// - ReadPixels writes width*height*4 bytes of RGBA, top row first.
+IMGUI_IMPL_API void     ImGui_ImplOffscreen_SetSize(int width, int height);
+IMGUI_IMPL_API unsigned int ImGui_ImplOffscreen_GetFramebuffer();
+IMGUI_IMPL_API void     ImGui_ImplOffscreen_ReadPixels(void* out_pixels);
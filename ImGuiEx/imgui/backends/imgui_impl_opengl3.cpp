@@ -7,6 +7,11 @@
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture identifier as void*/ImTextureID. Read the FAQ about ImTextureID!
 //  [X] Renderer: Large meshes support (64k+ vertices) with 16-bit indices (Desktop OpenGL only).
 //  [X] Renderer: Multi-viewport support (multiple windows). Enable with 'io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable'.
+//  [X] Renderer: Instanced rectangles and glyphs (ImDrawCmd::InstCount) (Desktop OpenGL 3.3+ and OpenGL ES 3.0 only).
+//  [X] Renderer: Per-command 2D transforms (ImDrawCmd::TransformIdx).
+//  [X] Renderer: External geometry referenced by ImDrawList::AddExternalGeometry(), CPU data or GL buffer objects.
+//  [X] Renderer: Dynamic textures updated by dirty rectangles (ImGui_ImplOpenGL3_CreateDynamicTexture), optionally staged through a pixel buffer object.
+//  [X] Renderer: On-disk program binary cache. Enable with ImGui_ImplOpenGL3_SetShaderCachePath() (Desktop OpenGL 4.1+ / GL_ARB_get_program_binary and OpenGL ES 3.0 only).
 
 // You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
 // Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
@@ -15,6 +20,11 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2023-XX-XX: OpenGL: Draw ImDrawCallback_ExternalGeometry commands from application buffers, enable ImGuiBackendFlags_RendererHasExternalGeometry flag.
+//  2023-XX-XX: OpenGL: Added ImGui_ImplOpenGL3_CreateDynamicTexture()/UpdateDynamicTexture()/DestroyDynamicTexture(). Dirty rectangles are uploaded with glTexSubImage2D() at the start of RenderDrawData().
+//  2023-XX-XX: OpenGL: Added ImGui_ImplOpenGL3_SetShaderCachePath() to store linked program binaries on disk and skip shader compilation on next startup.
+//  2023-XX-XX: OpenGL: Apply ImDrawCmd::TransformIdx in the projection matrix, enable ImGuiBackendFlags_RendererHasTransform flag.
+//  2023-XX-XX: OpenGL: Added instanced path for ImDrawInstance commands, enable ImGuiBackendFlags_RendererHasInstancing flag on GL 3.3+ and ES 3.0.
 //  2023-XX-XX: Platform: Added support for multiple windows via the ImGuiPlatformIO interface.
 //  2023-05-09: OpenGL: Support for glBindSampler() backup/restore on ES3. (#6375)
 //  2023-04-18: OpenGL: Restore front and back polygon mode separately when supported by context. (#6333)
@@ -184,11 +194,26 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
 #endif
 
+// Desktop GL 3.3+ and GL ES 3.0+ have glVertexAttribDivisor() and glDrawArraysInstanced()
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && (defined(IMGUI_IMPL_OPENGL_ES3) || defined(GL_VERSION_3_3))
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+#endif
+
 // Desktop GL 3.1+ has GL_PRIMITIVE_RESTART state
 #if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_VERSION_3_1)
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
 #endif
 
+// Desktop GL 4.1+ (or GL_ARB_get_program_binary) and GL ES 3.0+ have glGetProgramBinary()/glProgramBinary()
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && (defined(IMGUI_IMPL_OPENGL_ES3) || defined(GL_VERSION_4_1))
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+#endif
+
+// Desktop GL 3.0+ and GL ES 3.0+ have pixel buffer objects with glMapBufferRange()
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_PIXEL_UNPACK_BUFFER
+#endif
+
 // Desktop GL use extension detection
 #if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3)
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_EXTENSIONS
@@ -203,6 +228,27 @@
 #define GL_CALL(_CALL)      _CALL   // Call without error check
 #endif
 
+// Texture created by ImGui_ImplOpenGL3_CreateDynamicTexture(), pixels are owned by the caller
+struct ImGui_ImplOpenGL3_DynamicTexture
+{
+    GLuint          TextureId;
+    GLuint          PboHandle;               // Staging buffer, 0 = upload straight from Pixels
+    const unsigned char* Pixels;             // Width * Height * BytesPerPixel, tightly packed
+    int             Width;
+    int             Height;
+    int             BytesPerPixel;
+    GLenum          Format;                  // GL_RGBA, GL_RED or GL_ALPHA
+    ImVector<ImVec4> DirtyRects;             // Pending uploads, in pixels (x0, y0, x1, y1)
+};
+
+// CPU side ImDrawExternalBuffer copied into our streaming buffers for the frame, whatever the number of commands drawing it
+struct ImGui_ImplOpenGL3_ExternalUpload
+{
+    const ImDrawExternalBuffer* Buffer;
+    GLintptr        VtxOffset;               // In ExternalVboHandle
+    GLintptr        IdxOffset;               // In ExternalElementsHandle, all of the buffer's indices
+};
+
 // OpenGL Data
 struct ImGui_ImplOpenGL3_Data
 {
@@ -219,11 +265,31 @@ struct ImGui_ImplOpenGL3_Data
     GLuint          AttribLocationVtxPos;    // Vertex attributes location
     GLuint          AttribLocationVtxUV;
     GLuint          AttribLocationVtxColor;
-    unsigned int    VboHandle, ElementsHandle;
+    GLuint          InstanceShaderHandle;    // Program for ImDrawCmd::InstCount commands (ImGuiBackendFlags_RendererHasInstancing)
+    GLint           InstanceAttribLocationTex;
+    GLint           InstanceAttribLocationProjMtx;
+    GLuint          InstanceAttribLocationRect;
+    GLuint          InstanceAttribLocationUV;
+    GLuint          InstanceAttribLocationColor;
+    GLuint          InstanceAttribLocationRounding;
+    GLuint          InstanceAttribLocationCorners;
+    unsigned int    VboHandle, ElementsHandle, InstanceVboHandle;
+    unsigned int    ExternalVboHandle, ExternalElementsHandle; // Streaming buffers for CPU side ImDrawExternalBuffer data
+    ImVector<ImGui_ImplOpenGL3_ExternalUpload> ExternalUploads; // CPU side buffers uploaded this frame
+    ImVector<unsigned char> ExternalVtxData, ExternalIdxData;   // Staging for the upload
+    float           ProjMtx[4][4];                      // Orthographic projection set by SetupRenderState()
+    const ImDrawTransform* ShaderTransform;             // Transform currently combined into each program's ProjMtx uniform (nullptr = none)
+    const ImDrawTransform* InstanceShaderTransform;
     GLsizeiptr      VertexBufferSize;
     GLsizeiptr      IndexBufferSize;
     bool            HasClipOrigin;
+    bool            HasProgramBinary;
     bool            UseBufferSubData;
+    char*           ShaderCachePath;                    // Set by ImGui_ImplOpenGL3_SetShaderCachePath(), nullptr = disabled
+    ImVector<unsigned char> ShaderCache;                // Contents of the cache file, see ImGui_ImplOpenGL3_LoadShaderCache()
+    bool            ShaderCacheDirty;
+    ImVector<ImGui_ImplOpenGL3_DynamicTexture*> DynamicTextures;
+    int             DynamicTexturesDirtyCount;          // Number of DynamicTextures[] with DirtyRects
 
     ImGui_ImplOpenGL3_Data() { memset((void*)this, 0, sizeof(*this)); }
 };
@@ -326,6 +392,8 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     if (bd->GlVersion >= 320)
         io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
 #endif
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTransform;  // We can honor the ImDrawCmd::TransformIdx field, applied to the projection matrix.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasExternalGeometry;  // We can draw ImDrawCallback_ExternalGeometry commands from application buffers.
     io.BackendFlags |= ImGuiBackendFlags_RendererHasViewports;  // We can create multi-viewports on the Renderer side (optional)
 
     // Store GLSL version string so we can refer to it later in case we recreate shaders.
@@ -346,6 +414,14 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     strcpy(bd->GlslVersionString, glsl_version);
     strcat(bd->GlslVersionString, "\n");
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    // Instanced rectangles need glVertexAttribDivisor() (GL 3.3, GL ES 3.0) and gl_VertexID (GLSL 130, GLSL ES 300)
+    int glsl_version_number = 0;
+    sscanf(bd->GlslVersionString, "#version %d", &glsl_version_number);
+    if ((bd->GlVersion >= 330 || bd->GlProfileIsES3) && glsl_version_number >= 130)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasInstancing;  // We can draw ImDrawCmd::InstCount rectangles from ImDrawList::InstBuffer.
+#endif
+
     // Make an arbitrary GL call (we don't actually need the result)
     // IF YOU GET A CRASH HERE: it probably means the OpenGL function loader didn't do its job. Let us know!
     GLint current_texture;
@@ -353,6 +429,7 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
 
     // Detect extensions we support
     bd->HasClipOrigin = (bd->GlVersion >= 450);
+    bd->HasProgramBinary = (bd->GlVersion >= 410 || bd->GlProfileIsES3);
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_EXTENSIONS
     GLint num_extensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &num_extensions);
@@ -361,8 +438,19 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
         const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
         if (extension != nullptr && strcmp(extension, "GL_ARB_clip_control") == 0)
             bd->HasClipOrigin = true;
+        if (extension != nullptr && strcmp(extension, "GL_ARB_get_program_binary") == 0)
+            bd->HasProgramBinary = true;
     }
 #endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+    // Drivers may expose the entry points but no binary format (e.g. Mesa with its own shader cache disabled)
+    GLint num_program_binary_formats = 0;
+    if (bd->HasProgramBinary)
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_program_binary_formats);
+    bd->HasProgramBinary = (num_program_binary_formats > 0);
+#else
+    bd->HasProgramBinary = false;
+#endif
 
     if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
         ImGui_ImplOpenGL3_InitPlatformInterface();
@@ -378,12 +466,31 @@ void    ImGui_ImplOpenGL3_Shutdown()
 
     ImGui_ImplOpenGL3_ShutdownPlatformInterface();
     ImGui_ImplOpenGL3_DestroyDeviceObjects();
+    while (bd->DynamicTextures.Size > 0)
+        ImGui_ImplOpenGL3_DestroyDynamicTexture((ImTextureID)(intptr_t)bd->DynamicTextures.back()->TextureId);
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
-    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasViewports);
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasInstancing | ImGuiBackendFlags_RendererHasTransform | ImGuiBackendFlags_RendererHasExternalGeometry | ImGuiBackendFlags_RendererHasViewports);
+    IM_FREE(bd->ShaderCachePath);
     IM_DELETE(bd);
 }
 
+void    ImGui_ImplOpenGL3_SetShaderCachePath(const char* path)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+    IM_FREE(bd->ShaderCachePath);
+    bd->ShaderCachePath = nullptr;
+    if (path != nullptr)
+    {
+        size_t path_size = strlen(path) + 1;
+        bd->ShaderCachePath = (char*)IM_ALLOC(path_size);
+        memcpy(bd->ShaderCachePath, path, path_size);
+    }
+    bd->ShaderCache.clear();
+    bd->ShaderCacheDirty = false;
+}
+
 void    ImGui_ImplOpenGL3_NewFrame()
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
@@ -393,7 +500,27 @@ void    ImGui_ImplOpenGL3_NewFrame()
         ImGui_ImplOpenGL3_CreateDeviceObjects();
 }
 
-static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
+// Upload bd->ProjMtx combined with an ImDrawCmd transform to the ProjMtx uniform of the current program
+static void ImGui_ImplOpenGL3_SetupTransform(GLint proj_mtx_location, const ImDrawTransform* transform)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    if (transform == nullptr)
+    {
+        glUniformMatrix4fv(proj_mtx_location, 1, GL_FALSE, &bd->ProjMtx[0][0]);
+        return;
+    }
+    float mtx[4][4];
+    memcpy(mtx, bd->ProjMtx, sizeof(mtx));
+    for (int row = 0; row < 4; row++)
+    {
+        mtx[0][row] = bd->ProjMtx[0][row] * transform->AxisX.x + bd->ProjMtx[1][row] * transform->AxisX.y;
+        mtx[1][row] = bd->ProjMtx[0][row] * transform->AxisY.x + bd->ProjMtx[1][row] * transform->AxisY.y;
+        mtx[3][row] = bd->ProjMtx[0][row] * transform->Origin.x + bd->ProjMtx[1][row] * transform->Origin.y + bd->ProjMtx[3][row];
+    }
+    glUniformMatrix4fv(proj_mtx_location, 1, GL_FALSE, &mtx[0][0]);
+}
+
+static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object, GLuint instance_array_object)
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
 
@@ -441,6 +568,14 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
         { 0.0f,         0.0f,        -1.0f,   0.0f },
         { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
     };
+    memcpy(bd->ProjMtx, ortho_projection, sizeof(ortho_projection));
+    bd->ShaderTransform = bd->InstanceShaderTransform = nullptr;
+    if (bd->InstanceShaderHandle)
+    {
+        glUseProgram(bd->InstanceShaderHandle);
+        glUniform1i(bd->InstanceAttribLocationTex, 0);
+        glUniformMatrix4fv(bd->InstanceAttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+    }
     glUseProgram(bd->ShaderHandle);
     glUniform1i(bd->AttribLocationTex, 0);
     glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
@@ -451,6 +586,24 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
 #endif
 
     (void)vertex_array_object;
+    (void)instance_array_object;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    // Setup per-instance attributes for ImDrawInstance. Pointers are set for each command as we don't rely on glDrawArraysInstancedBaseInstance() (GL 4.2)
+    if (instance_array_object != 0)
+    {
+        glBindVertexArray(instance_array_object);
+        GL_CALL(glEnableVertexAttribArray(bd->InstanceAttribLocationRect));
+        GL_CALL(glEnableVertexAttribArray(bd->InstanceAttribLocationUV));
+        GL_CALL(glEnableVertexAttribArray(bd->InstanceAttribLocationColor));
+        GL_CALL(glEnableVertexAttribArray(bd->InstanceAttribLocationRounding));
+        GL_CALL(glEnableVertexAttribArray(bd->InstanceAttribLocationCorners));
+        GL_CALL(glVertexAttribDivisor(bd->InstanceAttribLocationRect, 1));
+        GL_CALL(glVertexAttribDivisor(bd->InstanceAttribLocationUV, 1));
+        GL_CALL(glVertexAttribDivisor(bd->InstanceAttribLocationColor, 1));
+        GL_CALL(glVertexAttribDivisor(bd->InstanceAttribLocationRounding, 1));
+        GL_CALL(glVertexAttribDivisor(bd->InstanceAttribLocationCorners, 1));
+    }
+#endif
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
     glBindVertexArray(vertex_array_object);
 #endif
@@ -466,6 +619,88 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col)));
 }
 
+// Copy CPU side external buffers drawn this frame into our streaming buffers, once each, with two uploads in total
+static void ImGui_ImplOpenGL3_UploadExternalGeometry(ImDrawData* draw_data)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    bd->ExternalUploads.resize(0);
+    bd->ExternalVtxData.resize(0);
+    bd->ExternalIdxData.resize(0);
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        for (const ImDrawExternalGeometry& geometry : draw_data->CmdLists[n]->ExternalBuffer)
+        {
+            const ImDrawExternalBuffer* buffer = geometry.Buffer;
+            if (buffer->VtxBufferId != 0 && buffer->IdxBufferId != 0)
+                continue;
+            bool uploaded = false;
+            for (const ImGui_ImplOpenGL3_ExternalUpload& upload : bd->ExternalUploads) // Few buffers per frame
+                uploaded |= upload.Buffer == buffer;
+            if (uploaded)
+                continue;
+
+            // Offsets stay 4 bytes aligned for float attributes and 32-bit indices
+            ImGui_ImplOpenGL3_ExternalUpload upload;
+            upload.Buffer = buffer;
+            upload.VtxOffset = upload.IdxOffset = 0;
+            if (buffer->VtxBufferId == 0)
+            {
+                const int size = buffer->VtxCount * buffer->VtxStride;
+                upload.VtxOffset = (GLintptr)bd->ExternalVtxData.Size;
+                bd->ExternalVtxData.resize(bd->ExternalVtxData.Size + ((size + 3) & ~3));
+                memcpy(bd->ExternalVtxData.Data + upload.VtxOffset, buffer->VtxData, (size_t)size);
+            }
+            if (buffer->IdxBufferId == 0)
+            {
+                const int size = buffer->IdxCount * buffer->IdxSize;
+                upload.IdxOffset = (GLintptr)bd->ExternalIdxData.Size;
+                bd->ExternalIdxData.resize(bd->ExternalIdxData.Size + ((size + 3) & ~3));
+                memcpy(bd->ExternalIdxData.Data + upload.IdxOffset, buffer->IdxData, (size_t)size);
+            }
+            bd->ExternalUploads.push_back(upload);
+        }
+    }
+    if (bd->ExternalUploads.Size == 0)
+        return;
+
+    // The element array binding is part of our VAO, restore it
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->ExternalVboHandle));
+    GL_CALL(glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)bd->ExternalVtxData.Size, (const GLvoid*)bd->ExternalVtxData.Data, GL_STREAM_DRAW));
+    GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ExternalElementsHandle));
+    GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)bd->ExternalIdxData.Size, (const GLvoid*)bd->ExternalIdxData.Data, GL_STREAM_DRAW));
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle));
+    GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle));
+}
+
+// Draw an ImDrawCallback_ExternalGeometry command with our ImDrawVert program and state, pointing the attributes at the application's buffers
+static void ImGui_ImplOpenGL3_RenderExternalGeometry(const ImDrawExternalGeometry& geometry)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    const ImDrawExternalBuffer* buffer = geometry.Buffer;
+
+    // Buffer objects are used as is, CPU data was streamed by ImGui_ImplOpenGL3_UploadExternalGeometry()
+    const ImGui_ImplOpenGL3_ExternalUpload* upload = nullptr;
+    for (const ImGui_ImplOpenGL3_ExternalUpload& it : bd->ExternalUploads)
+        if (it.Buffer == buffer)
+            upload = &it;
+    IM_ASSERT(upload != nullptr || (buffer->VtxBufferId != 0 && buffer->IdxBufferId != 0));
+    const GLintptr vtx_offset = (buffer->VtxBufferId != 0) ? 0 : upload->VtxOffset;
+    const GLintptr idx_offset = (GLintptr)geometry.IdxOffset * buffer->IdxSize + ((buffer->IdxBufferId != 0) ? 0 : upload->IdxOffset);
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, (buffer->VtxBufferId != 0) ? buffer->VtxBufferId : bd->ExternalVboHandle));
+    GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (buffer->IdxBufferId != 0) ? buffer->IdxBufferId : bd->ExternalElementsHandle));
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, buffer->VtxStride, (GLvoid*)(vtx_offset + buffer->VtxPosOffset)));
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, buffer->VtxStride, (GLvoid*)(vtx_offset + buffer->VtxUvOffset)));
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  buffer->VtxStride, (GLvoid*)(vtx_offset + buffer->VtxColOffset)));
+    GL_CALL(glDrawElements(GL_TRIANGLES, (GLsizei)geometry.IdxCount, buffer->IdxSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)idx_offset));
+
+    // Back to the draw list buffers (the element array binding is part of the VAO)
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle));
+    GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle));
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos)));
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv)));
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col)));
+}
+
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
@@ -518,14 +753,23 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     GLboolean last_enable_primitive_restart = (bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
 #endif
 
+    // Flush dynamic textures (texture binding is restored below)
+    if (bd->DynamicTexturesDirtyCount > 0)
+        ImGui_ImplOpenGL3_UploadDynamicTextures();
+
     // Setup desired GL state
     // Recreate the VAO every time (this is to easily allow multiple GL contexts to be rendered to. VAO are not shared among GL contexts)
     // The renderer would actually work without any VAO bound, but then our VertexAttrib calls would overwrite the default one currently bound.
     GLuint vertex_array_object = 0;
+    GLuint instance_array_object = 0;
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
     GL_CALL(glGenVertexArrays(1, &vertex_array_object));
+    if (bd->InstanceShaderHandle && draw_data->TotalInstCount > 0)
+        GL_CALL(glGenVertexArrays(1, &instance_array_object));
 #endif
-    ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+    ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object, instance_array_object);
+    ImGui_ImplOpenGL3_UploadExternalGeometry(draw_data);
+    bool instance_state_bound = false;
 
     // Will project scissor/clipping rectangles into framebuffer space
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
@@ -535,6 +779,15 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+        if (instance_state_bound)
+        {
+            glUseProgram(bd->ShaderHandle);
+            glBindVertexArray(vertex_array_object);
+            glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle);
+            instance_state_bound = false;
+        }
+#endif
 
         // Upload vertex/index buffers
         // - OpenGL drivers are in a very sorry state nowadays....
@@ -566,24 +819,40 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
             GL_CALL(glBufferData(GL_ARRAY_BUFFER, vtx_buffer_size, (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW));
             GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx_buffer_size, (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW));
         }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+        if (cmd_list->InstBuffer.Size > 0)
+        {
+            IM_ASSERT(bd->InstanceShaderHandle != 0);
+            GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->InstanceVboHandle));
+            GL_CALL(glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->InstBuffer.Size * (int)sizeof(ImDrawInstance), (const GLvoid*)cmd_list->InstBuffer.Data, GL_STREAM_DRAW));
+            GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle));
+        }
+#endif
 
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
             const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
-            if (pcmd->UserCallback != nullptr)
+            if (pcmd->UserCallback != nullptr && pcmd->UserCallback != ImDrawCallback_ExternalGeometry)
             {
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
-                    ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+                {
+                    ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object, instance_array_object);
+                    instance_state_bound = false;
+                }
                 else
                     pcmd->UserCallback(cmd_list, pcmd);
             }
             else
             {
+                // Clipping rectangle is in the same space as vertices when the command has a transform
+                const ImDrawTransform* transform = pcmd->TransformIdx ? &cmd_list->TransformBuffer[pcmd->TransformIdx] : nullptr;
+                const ImVec4 clip_rect = transform ? transform->ApplyToRect(pcmd->ClipRect) : pcmd->ClipRect;
+
                 // Project scissor/clipping rectangles into framebuffer space
-                ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
-                ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+                ImVec2 clip_min((clip_rect.x - clip_off.x) * clip_scale.x, (clip_rect.y - clip_off.y) * clip_scale.y);
+                ImVec2 clip_max((clip_rect.z - clip_off.x) * clip_scale.x, (clip_rect.w - clip_off.y) * clip_scale.y);
                 if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
                     continue;
 
@@ -592,6 +861,50 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 
                 // Bind texture, Draw
                 GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID()));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+                if (pcmd->InstCount > 0)
+                {
+                    // Instanced rectangles: one 4 vertices triangle strip per ImDrawInstance, expanded in the vertex shader. Drawn before the command's triangles.
+                    if (!instance_state_bound)
+                    {
+                        glUseProgram(bd->InstanceShaderHandle);
+                        glBindVertexArray(instance_array_object);
+                        glBindBuffer(GL_ARRAY_BUFFER, bd->InstanceVboHandle);
+                        instance_state_bound = true;
+                    }
+                    if (bd->InstanceShaderTransform != transform)
+                    {
+                        ImGui_ImplOpenGL3_SetupTransform(bd->InstanceAttribLocationProjMtx, transform);
+                        bd->InstanceShaderTransform = transform;
+                    }
+                    const intptr_t inst_offset = (intptr_t)pcmd->InstOffset * (intptr_t)sizeof(ImDrawInstance);
+                    GL_CALL(glVertexAttribPointer(bd->InstanceAttribLocationRect,     4, GL_FLOAT,         GL_FALSE, sizeof(ImDrawInstance), (GLvoid*)(inst_offset + IM_OFFSETOF(ImDrawInstance, Min))));   // Min + Max
+                    GL_CALL(glVertexAttribPointer(bd->InstanceAttribLocationUV,       4, GL_FLOAT,         GL_FALSE, sizeof(ImDrawInstance), (GLvoid*)(inst_offset + IM_OFFSETOF(ImDrawInstance, UvMin)))); // UvMin + UvMax
+                    GL_CALL(glVertexAttribPointer(bd->InstanceAttribLocationColor,    4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawInstance), (GLvoid*)(inst_offset + IM_OFFSETOF(ImDrawInstance, Col))));
+                    GL_CALL(glVertexAttribPointer(bd->InstanceAttribLocationRounding, 1, GL_FLOAT,         GL_FALSE, sizeof(ImDrawInstance), (GLvoid*)(inst_offset + IM_OFFSETOF(ImDrawInstance, Rounding))));
+                    GL_CALL(glVertexAttribPointer(bd->InstanceAttribLocationCorners,  4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawInstance), (GLvoid*)(inst_offset + IM_OFFSETOF(ImDrawInstance, Corners))));
+                    GL_CALL(glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)pcmd->InstCount));
+                    if (pcmd->ElemCount == 0)
+                        continue;
+                }
+                if (instance_state_bound)
+                {
+                    glUseProgram(bd->ShaderHandle);
+                    glBindVertexArray(vertex_array_object);
+                    glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle);
+                    instance_state_bound = false;
+                }
+#endif
+                if (bd->ShaderTransform != transform)
+                {
+                    ImGui_ImplOpenGL3_SetupTransform(bd->AttribLocationProjMtx, transform);
+                    bd->ShaderTransform = transform;
+                }
+                if (pcmd->UserCallback == ImDrawCallback_ExternalGeometry)
+                {
+                    ImGui_ImplOpenGL3_RenderExternalGeometry(cmd_list->ExternalBuffer[(int)(intptr_t)pcmd->UserCallbackData]);
+                    continue;
+                }
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                 if (bd->GlVersion >= 320)
                     GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset));
@@ -605,7 +918,10 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     // Destroy the temporary VAO
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
     GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
+    if (instance_array_object)
+        GL_CALL(glDeleteVertexArrays(1, &instance_array_object));
 #endif
+    (void)instance_state_bound;
 
     // Restore modified GL state
     // This "glIsProgram()" check is required because if the program is "pending deletion" at the time of binding backup, it will have been deleted by now and will cause an OpenGL error. See #6220.
@@ -699,6 +1015,226 @@ void ImGui_ImplOpenGL3_DestroyFontsTexture()
     }
 }
 
+static ImGui_ImplOpenGL3_DynamicTexture* ImGui_ImplOpenGL3_FindDynamicTexture(ImTextureID tex_id)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    for (ImGui_ImplOpenGL3_DynamicTexture* tex : bd->DynamicTextures)
+        if (tex->TextureId == (GLuint)(intptr_t)tex_id)
+            return tex;
+    return nullptr;
+}
+
+ImTextureID ImGui_ImplOpenGL3_CreateDynamicTexture(const void* pixels, int width, int height, ImGui_ImplOpenGL3_TextureFormat format, bool use_pbo)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+    IM_ASSERT(pixels != nullptr && width > 0 && height > 0);
+
+    ImGui_ImplOpenGL3_DynamicTexture* tex = IM_NEW(ImGui_ImplOpenGL3_DynamicTexture)();
+    tex->PboHandle = 0;
+    tex->Pixels = (const unsigned char*)pixels;
+    tex->Width = width;
+    tex->Height = height;
+    tex->BytesPerPixel = (format == ImGui_ImplOpenGL3_TextureFormat_Alpha8) ? 1 : 4;
+
+    // Alpha8 is sampled as (1,1,1,a) like GetTexDataAsAlpha8() data would expect: GL_ALPHA is gone from core profiles, use a swizzled GL_R8 there.
+    GLint internal_format = GL_RGBA;
+    tex->Format = GL_RGBA;
+    bool swizzle = false;
+    if (format == ImGui_ImplOpenGL3_TextureFormat_Alpha8)
+    {
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+        swizzle = (bd->GlVersion >= 330 || bd->GlProfileIsES3);
+#endif
+        internal_format = swizzle ? GL_R8 : GL_ALPHA;
+        tex->Format = swizzle ? GL_RED : GL_ALPHA;
+    }
+
+    GLint last_texture;
+    GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
+    GL_CALL(glGenTextures(1, &tex->TextureId));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, tex->TextureId));
+    GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+    GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+    if (swizzle)
+    {
+        GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_ONE));
+        GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_ONE));
+        GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_ONE));
+        GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED));
+    }
+#endif
+    GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+#ifdef GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
+    GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+#endif
+    GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, tex->Format, GL_UNSIGNED_BYTE, pixels));
+    GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture));
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PIXEL_UNPACK_BUFFER
+    if (use_pbo && (bd->GlVersion >= 300 || bd->GlProfileIsES3))
+        GL_CALL(glGenBuffers(1, &tex->PboHandle));
+#else
+    IM_UNUSED(use_pbo);
+#endif
+
+    bd->DynamicTextures.push_back(tex);
+    return (ImTextureID)(intptr_t)tex->TextureId;
+}
+
+static ImVec4 ImGui_ImplOpenGL3_MergeRects(const ImVec4& a, const ImVec4& b)
+{
+    return ImVec4(a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y, a.z > b.z ? a.z : b.z, a.w > b.w ? a.w : b.w);
+}
+
+void ImGui_ImplOpenGL3_UpdateDynamicTexture(ImTextureID tex_id, int x, int y, int w, int h)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    ImGui_ImplOpenGL3_DynamicTexture* tex = ImGui_ImplOpenGL3_FindDynamicTexture(tex_id);
+    IM_ASSERT(tex != nullptr && "Not a texture created by ImGui_ImplOpenGL3_CreateDynamicTexture()");
+
+    ImVec4 r((float)(x > 0 ? x : 0), (float)(y > 0 ? y : 0), (float)(x + w < tex->Width ? x + w : tex->Width), (float)(y + h < tex->Height ? y + h : tex->Height));
+    if (r.x >= r.z || r.y >= r.w)
+        return;
+    if (tex->DirtyRects.Size == 0)
+        bd->DynamicTexturesDirtyCount++;
+
+    // Merge with an overlapping rectangle, keep the list short by collapsing it to its bounds past a few entries.
+    const int max_rects = 16;
+    for (ImVec4& dirty : tex->DirtyRects)
+        if (r.x <= dirty.z && r.z >= dirty.x && r.y <= dirty.w && r.w >= dirty.y)
+        {
+            dirty = ImGui_ImplOpenGL3_MergeRects(dirty, r);
+            return;
+        }
+    if (tex->DirtyRects.Size < max_rects)
+    {
+        tex->DirtyRects.push_back(r);
+        return;
+    }
+    for (const ImVec4& dirty : tex->DirtyRects)
+        r = ImGui_ImplOpenGL3_MergeRects(dirty, r);
+    tex->DirtyRects.resize(1);
+    tex->DirtyRects[0] = r;
+}
+
+void ImGui_ImplOpenGL3_DestroyDynamicTexture(ImTextureID tex_id)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    ImGui_ImplOpenGL3_DynamicTexture* tex = ImGui_ImplOpenGL3_FindDynamicTexture(tex_id);
+    IM_ASSERT(tex != nullptr && "Not a texture created by ImGui_ImplOpenGL3_CreateDynamicTexture()");
+    if (tex->DirtyRects.Size > 0)
+        bd->DynamicTexturesDirtyCount--;
+    glDeleteTextures(1, &tex->TextureId);
+    if (tex->PboHandle)
+        glDeleteBuffers(1, &tex->PboHandle);
+    bd->DynamicTextures.find_erase_unsorted(tex);
+    IM_DELETE(tex);
+}
+
+// Upload pending dirty rectangles of all dynamic textures. Changes the current GL_TEXTURE_2D binding.
+void ImGui_ImplOpenGL3_UploadDynamicTextures()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    if (bd->DynamicTexturesDirtyCount == 0)
+        return;
+
+    // Backup pixel unpack state
+    GLint last_unpack_alignment; glGetIntegerv(GL_UNPACK_ALIGNMENT, &last_unpack_alignment);
+#ifdef GL_UNPACK_ROW_LENGTH
+    GLint last_unpack_row_length; glGetIntegerv(GL_UNPACK_ROW_LENGTH, &last_unpack_row_length);
+    GLint last_unpack_skip_pixels; glGetIntegerv(GL_UNPACK_SKIP_PIXELS, &last_unpack_skip_pixels);
+    GLint last_unpack_skip_rows; glGetIntegerv(GL_UNPACK_SKIP_ROWS, &last_unpack_skip_rows);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PIXEL_UNPACK_BUFFER
+    GLint last_pixel_unpack_buffer = 0;
+    if (bd->GlVersion >= 300 || bd->GlProfileIsES3)
+        glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &last_pixel_unpack_buffer);
+#endif
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    for (ImGui_ImplOpenGL3_DynamicTexture* tex : bd->DynamicTextures)
+    {
+        if (tex->DirtyRects.Size == 0)
+            continue;
+        glBindTexture(GL_TEXTURE_2D, tex->TextureId);
+        const int bpp = tex->BytesPerPixel;
+#ifndef GL_UNPACK_ROW_LENGTH
+        // No sub-row addressing on ES 2.0: upload whole rows
+        for (ImVec4& r : tex->DirtyRects)
+            r.x = 0.0f, r.z = (float)tex->Width;
+#endif
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PIXEL_UNPACK_BUFFER
+        if (tex->PboHandle)
+        {
+            // Pack all rectangles tightly into an orphaned staging buffer, the driver copies it to the texture asynchronously.
+            GLsizeiptr total_size = 0;
+            for (const ImVec4& r : tex->DirtyRects)
+                total_size += (GLsizeiptr)(r.z - r.x) * (GLsizeiptr)(r.w - r.y) * bpp;
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, tex->PboHandle);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, total_size, nullptr, GL_STREAM_DRAW);
+            if (unsigned char* dst = (unsigned char*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, total_size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT))
+            {
+                unsigned char* dst_begin = dst;
+                for (const ImVec4& r : tex->DirtyRects)
+                {
+                    const int row_size = (int)(r.z - r.x) * bpp;
+                    for (int y = (int)r.y; y < (int)r.w; y++, dst += row_size)
+                        memcpy(dst, tex->Pixels + ((size_t)y * tex->Width + (size_t)r.x) * bpp, row_size);
+                }
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+                glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+                glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+                GLsizeiptr offset = 0;
+                for (const ImVec4& r : tex->DirtyRects)
+                {
+                    glTexSubImage2D(GL_TEXTURE_2D, 0, (GLint)r.x, (GLint)r.y, (GLsizei)(r.z - r.x), (GLsizei)(r.w - r.y), tex->Format, GL_UNSIGNED_BYTE, (const void*)(intptr_t)offset);
+                    offset += (GLsizeiptr)(r.z - r.x) * (GLsizeiptr)(r.w - r.y) * bpp;
+                }
+                IM_ASSERT(dst == dst_begin + total_size);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                tex->DirtyRects.resize(0);
+                bd->DynamicTexturesDirtyCount--;
+                continue;
+            }
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0); // Mapping failed: fall back to client memory upload
+        }
+#endif
+
+#ifdef GL_UNPACK_ROW_LENGTH
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, tex->Width);
+        for (const ImVec4& r : tex->DirtyRects)
+        {
+            glPixelStorei(GL_UNPACK_SKIP_PIXELS, (GLint)r.x);
+            glPixelStorei(GL_UNPACK_SKIP_ROWS, (GLint)r.y);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, (GLint)r.x, (GLint)r.y, (GLsizei)(r.z - r.x), (GLsizei)(r.w - r.y), tex->Format, GL_UNSIGNED_BYTE, tex->Pixels);
+        }
+#else
+        for (const ImVec4& r : tex->DirtyRects)
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, (GLint)r.y, tex->Width, (GLsizei)(r.w - r.y), tex->Format, GL_UNSIGNED_BYTE, tex->Pixels + (size_t)r.y * tex->Width * bpp);
+#endif
+        tex->DirtyRects.resize(0);
+        bd->DynamicTexturesDirtyCount--;
+    }
+    IM_ASSERT(bd->DynamicTexturesDirtyCount == 0);
+
+    // Restore pixel unpack state
+    glPixelStorei(GL_UNPACK_ALIGNMENT, last_unpack_alignment);
+#ifdef GL_UNPACK_ROW_LENGTH
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, last_unpack_row_length);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, last_unpack_skip_pixels);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, last_unpack_skip_rows);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PIXEL_UNPACK_BUFFER
+    if (bd->GlVersion >= 300 || bd->GlProfileIsES3)
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, last_pixel_unpack_buffer);
+#endif
+}
+
 // If you get an error please report on github. You may try different GL context version or GLSL version. See GL<>GLSL version table at the top of this file.
 static bool CheckShader(GLuint handle, const char* desc)
 {
@@ -737,6 +1273,213 @@ static bool CheckProgram(GLuint handle, const char* desc)
     return (GLboolean)status == GL_TRUE;
 }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+// Program binary cache file: a header followed by { ImU32 Key, ImU32 BinaryFormat, ImU32 Size, ImU8 Binary[Size] } entries.
+// Entries are keyed by a hash of the GL vendor/renderer/version strings and the shader sources, so that a driver
+// update or a shader change misses the cache instead of feeding the driver a stale binary.
+static const ImU32 ShaderCacheMagic = 0x43534D49; // "IMSC"
+static const ImU32 ShaderCacheVersion = 1;
+
+static ImU32 ImGui_ImplOpenGL3_HashString(ImU32 hash, const char* str)
+{
+    // FNV-1a
+    if (str != nullptr)
+        for (const unsigned char* p = (const unsigned char*)str; *p; p++)
+            hash = (hash ^ *p) * 16777619u;
+    return hash;
+}
+
+static ImU32 ImGui_ImplOpenGL3_GetShaderCacheKey(const GLchar* vertex_shader, const GLchar* fragment_shader)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    ImU32 hash = 2166136261u;
+    hash = ImGui_ImplOpenGL3_HashString(hash, (const char*)glGetString(GL_VENDOR));
+    hash = ImGui_ImplOpenGL3_HashString(hash, (const char*)glGetString(GL_RENDERER));
+    hash = ImGui_ImplOpenGL3_HashString(hash, (const char*)glGetString(GL_VERSION));
+    hash = ImGui_ImplOpenGL3_HashString(hash, bd->GlslVersionString);
+    hash = ImGui_ImplOpenGL3_HashString(hash, vertex_shader);
+    hash = ImGui_ImplOpenGL3_HashString(hash, fragment_shader);
+    return hash;
+}
+
+// Return offset of the entry header in bd->ShaderCache, or -1
+static int ImGui_ImplOpenGL3_FindShaderCacheEntry(ImU32 key)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    const int header_size = sizeof(ImU32) * 3;
+    for (int offset = sizeof(ImU32) * 2; offset + header_size <= bd->ShaderCache.Size; )
+    {
+        ImU32 entry[3];
+        memcpy(entry, bd->ShaderCache.Data + offset, sizeof(entry));
+        if ((ImU32)(bd->ShaderCache.Size - offset - header_size) < entry[2])
+            break;
+        if (entry[0] == key)
+            return offset;
+        offset += header_size + (int)entry[2];
+    }
+    return -1;
+}
+
+static void ImGui_ImplOpenGL3_RemoveShaderCacheEntry(ImU32 key)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    int offset = ImGui_ImplOpenGL3_FindShaderCacheEntry(key);
+    if (offset < 0)
+        return;
+    ImU32 entry[3];
+    memcpy(entry, bd->ShaderCache.Data + offset, sizeof(entry));
+    unsigned char* entry_begin = bd->ShaderCache.Data + offset;
+    bd->ShaderCache.erase(entry_begin, entry_begin + sizeof(entry) + entry[2]);
+    bd->ShaderCacheDirty = true;
+}
+
+static void ImGui_ImplOpenGL3_LoadShaderCache()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    bd->ShaderCache.clear();
+    bd->ShaderCacheDirty = false;
+    if (FILE* f = fopen(bd->ShaderCachePath, "rb"))
+    {
+        if (fseek(f, 0, SEEK_END) == 0)
+        {
+            long file_size = ftell(f);
+            if (file_size > 0 && fseek(f, 0, SEEK_SET) == 0)
+            {
+                bd->ShaderCache.resize((int)file_size);
+                if (fread(bd->ShaderCache.Data, 1, (size_t)file_size, f) != (size_t)file_size)
+                    bd->ShaderCache.clear();
+            }
+        }
+        fclose(f);
+    }
+
+    // Discard unrecognized files, they will be overwritten on next save
+    ImU32 header[2] = { 0, 0 };
+    if (bd->ShaderCache.Size >= (int)sizeof(header))
+        memcpy(header, bd->ShaderCache.Data, sizeof(header));
+    if (header[0] != ShaderCacheMagic || header[1] != ShaderCacheVersion)
+        bd->ShaderCache.clear();
+}
+
+static void ImGui_ImplOpenGL3_SaveShaderCache()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    bd->ShaderCacheDirty = false;
+    if (FILE* f = fopen(bd->ShaderCachePath, "wb"))
+    {
+        fwrite(bd->ShaderCache.Data, 1, (size_t)bd->ShaderCache.Size, f);
+        fclose(f);
+    }
+}
+
+// Try to create a program from a cached binary. Returns 0 if not found or rejected by the driver.
+static GLuint ImGui_ImplOpenGL3_LoadProgramBinary(ImU32 key)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    int offset = ImGui_ImplOpenGL3_FindShaderCacheEntry(key);
+    if (offset < 0)
+        return 0;
+    ImU32 entry[3];
+    memcpy(entry, bd->ShaderCache.Data + offset, sizeof(entry));
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, (GLenum)entry[1], bd->ShaderCache.Data + offset + sizeof(entry), (GLsizei)entry[2]);
+    GLint status = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if ((GLboolean)status == GL_TRUE)
+        return program;
+
+    // Driver changed its binary format: drop the entry and let the caller recompile
+    glDeleteProgram(program);
+    ImGui_ImplOpenGL3_RemoveShaderCacheEntry(key);
+    return 0;
+}
+
+static void ImGui_ImplOpenGL3_StoreProgramBinary(ImU32 key, GLuint program)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    GLint binary_length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_length);
+    if (binary_length <= 0)
+        return;
+
+    ImGui_ImplOpenGL3_RemoveShaderCacheEntry(key);
+    if (bd->ShaderCache.empty())
+    {
+        ImU32 header[2] = { ShaderCacheMagic, ShaderCacheVersion };
+        bd->ShaderCache.resize(sizeof(header));
+        memcpy(bd->ShaderCache.Data, header, sizeof(header));
+    }
+    const int offset = bd->ShaderCache.Size;
+    bd->ShaderCache.resize(offset + (int)(sizeof(ImU32) * 3) + binary_length);
+    GLsizei length = 0;
+    GLenum format = 0;
+    glGetProgramBinary(program, binary_length, &length, &format, bd->ShaderCache.Data + offset + sizeof(ImU32) * 3);
+    if (length <= 0)
+    {
+        bd->ShaderCache.resize(offset);
+        return;
+    }
+    ImU32 entry[3] = { key, (ImU32)format, (ImU32)length };
+    memcpy(bd->ShaderCache.Data + offset, entry, sizeof(entry));
+    bd->ShaderCache.resize(offset + (int)sizeof(entry) + length);
+    bd->ShaderCacheDirty = true;
+}
+#endif
+
+// Compile and link a program, prepending our GLSL version string to both shaders. Returns 0 on failure.
+// When the program binary cache is enabled, a previously linked binary is used instead of compiling.
+static GLuint CreateProgram(const GLchar* vertex_shader, const GLchar* fragment_shader, const char* desc)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+    const bool use_cache = (bd->HasProgramBinary && bd->ShaderCachePath != nullptr);
+    const ImU32 cache_key = use_cache ? ImGui_ImplOpenGL3_GetShaderCacheKey(vertex_shader, fragment_shader) : 0;
+    if (use_cache)
+        if (GLuint program = ImGui_ImplOpenGL3_LoadProgramBinary(cache_key))
+            return program;
+#endif
+
+    // Create shaders
+    const GLchar* vertex_shader_with_version[2] = { bd->GlslVersionString, vertex_shader };
+    GLuint vert_handle = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vert_handle, 2, vertex_shader_with_version, nullptr);
+    glCompileShader(vert_handle);
+    CheckShader(vert_handle, "vertex shader");
+
+    const GLchar* fragment_shader_with_version[2] = { bd->GlslVersionString, fragment_shader };
+    GLuint frag_handle = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(frag_handle, 2, fragment_shader_with_version, nullptr);
+    glCompileShader(frag_handle);
+    CheckShader(frag_handle, "fragment shader");
+
+    // Link
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vert_handle);
+    glAttachShader(program, frag_handle);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+    if (use_cache)
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+    glLinkProgram(program);
+    bool linked = CheckProgram(program, desc);
+
+    glDetachShader(program, vert_handle);
+    glDetachShader(program, frag_handle);
+    glDeleteShader(vert_handle);
+    glDeleteShader(frag_handle);
+    if (!linked)
+    {
+        glDeleteProgram(program);
+        return 0;
+    }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+    if (use_cache)
+        ImGui_ImplOpenGL3_StoreProgramBinary(cache_key, program);
+#endif
+    return program;
+}
+
 bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
@@ -754,6 +1497,11 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
     int glsl_version = 130;
     sscanf(bd->GlslVersionString, "#version %d", &glsl_version);
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+    if (bd->HasProgramBinary && bd->ShaderCachePath != nullptr)
+        ImGui_ImplOpenGL3_LoadShaderCache();
+#endif
+
     const GLchar* vertex_shader_glsl_120 =
         "uniform mat4 ProjMtx;\n"
         "attribute vec2 Position;\n"
@@ -879,29 +1627,7 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
     }
 
     // Create shaders
-    const GLchar* vertex_shader_with_version[2] = { bd->GlslVersionString, vertex_shader };
-    GLuint vert_handle = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vert_handle, 2, vertex_shader_with_version, nullptr);
-    glCompileShader(vert_handle);
-    CheckShader(vert_handle, "vertex shader");
-
-    const GLchar* fragment_shader_with_version[2] = { bd->GlslVersionString, fragment_shader };
-    GLuint frag_handle = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(frag_handle, 2, fragment_shader_with_version, nullptr);
-    glCompileShader(frag_handle);
-    CheckShader(frag_handle, "fragment shader");
-
-    // Link
-    bd->ShaderHandle = glCreateProgram();
-    glAttachShader(bd->ShaderHandle, vert_handle);
-    glAttachShader(bd->ShaderHandle, frag_handle);
-    glLinkProgram(bd->ShaderHandle);
-    CheckProgram(bd->ShaderHandle, "shader program");
-
-    glDetachShader(bd->ShaderHandle, vert_handle);
-    glDetachShader(bd->ShaderHandle, frag_handle);
-    glDeleteShader(vert_handle);
-    glDeleteShader(frag_handle);
+    bd->ShaderHandle = CreateProgram(vertex_shader, fragment_shader, "shader program");
 
     bd->AttribLocationTex = glGetUniformLocation(bd->ShaderHandle, "Texture");
     bd->AttribLocationProjMtx = glGetUniformLocation(bd->ShaderHandle, "ProjMtx");
@@ -912,9 +1638,194 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
     // Create buffers
     glGenBuffers(1, &bd->VboHandle);
     glGenBuffers(1, &bd->ElementsHandle);
+    glGenBuffers(1, &bd->ExternalVboHandle);
+    glGenBuffers(1, &bd->ExternalElementsHandle);
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    // Create instanced rectangles program (ImGuiBackendFlags_RendererHasInstancing)
+    // The quad corner is derived from gl_VertexID, rounded corners coverage is computed from the distance to the rounded rectangle.
+    ImGuiIO& io = ImGui::GetIO();
+    if (io.BackendFlags & ImGuiBackendFlags_RendererHasInstancing)
+    {
+        const GLchar* instance_vertex_shader_glsl_130 =
+            "uniform mat4 ProjMtx;\n"
+            "in vec4 InstRect;\n"
+            "in vec4 InstUV;\n"
+            "in vec4 InstColor;\n"
+            "in float InstRounding;\n"
+            "in vec4 InstCorners;\n"
+            "out vec2 Frag_UV;\n"
+            "out vec4 Frag_Color;\n"
+            "out vec2 Frag_Pos;\n"
+            "out vec3 Frag_Shape;\n"
+            "out vec4 Frag_Corners;\n"
+            "void main()\n"
+            "{\n"
+            "    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));\n"
+            "    vec2 pad = vec2(InstRounding > 0.0 ? 1.0 : 0.0);\n"
+            "    vec2 pos = mix(InstRect.xy - pad, InstRect.zw + pad, corner);\n"
+            "    Frag_UV = mix(InstUV.xy, InstUV.zw, corner);\n"
+            "    Frag_Color = InstColor;\n"
+            "    Frag_Pos = pos - (InstRect.xy + InstRect.zw) * 0.5;\n"
+            "    Frag_Shape = vec3(abs(InstRect.zw - InstRect.xy) * 0.5, InstRounding);\n"
+            "    Frag_Corners = InstCorners;\n"
+            "    gl_Position = ProjMtx * vec4(pos.xy,0,1);\n"
+            "}\n";
+
+        const GLchar* instance_vertex_shader_glsl_300_es =
+            "precision highp float;\n"
+            "layout (location = 0) in vec4 InstRect;\n"
+            "layout (location = 1) in vec4 InstUV;\n"
+            "layout (location = 2) in vec4 InstColor;\n"
+            "layout (location = 3) in float InstRounding;\n"
+            "layout (location = 4) in vec4 InstCorners;\n"
+            "uniform mat4 ProjMtx;\n"
+            "out vec2 Frag_UV;\n"
+            "out vec4 Frag_Color;\n"
+            "out vec2 Frag_Pos;\n"
+            "out vec3 Frag_Shape;\n"
+            "out vec4 Frag_Corners;\n"
+            "void main()\n"
+            "{\n"
+            "    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));\n"
+            "    vec2 pad = vec2(InstRounding > 0.0 ? 1.0 : 0.0);\n"
+            "    vec2 pos = mix(InstRect.xy - pad, InstRect.zw + pad, corner);\n"
+            "    Frag_UV = mix(InstUV.xy, InstUV.zw, corner);\n"
+            "    Frag_Color = InstColor;\n"
+            "    Frag_Pos = pos - (InstRect.xy + InstRect.zw) * 0.5;\n"
+            "    Frag_Shape = vec3(abs(InstRect.zw - InstRect.xy) * 0.5, InstRounding);\n"
+            "    Frag_Corners = InstCorners;\n"
+            "    gl_Position = ProjMtx * vec4(pos.xy,0,1);\n"
+            "}\n";
+
+        const GLchar* instance_vertex_shader_glsl_410_core =
+            "layout (location = 0) in vec4 InstRect;\n"
+            "layout (location = 1) in vec4 InstUV;\n"
+            "layout (location = 2) in vec4 InstColor;\n"
+            "layout (location = 3) in float InstRounding;\n"
+            "layout (location = 4) in vec4 InstCorners;\n"
+            "uniform mat4 ProjMtx;\n"
+            "out vec2 Frag_UV;\n"
+            "out vec4 Frag_Color;\n"
+            "out vec2 Frag_Pos;\n"
+            "out vec3 Frag_Shape;\n"
+            "out vec4 Frag_Corners;\n"
+            "void main()\n"
+            "{\n"
+            "    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));\n"
+            "    vec2 pad = vec2(InstRounding > 0.0 ? 1.0 : 0.0);\n"
+            "    vec2 pos = mix(InstRect.xy - pad, InstRect.zw + pad, corner);\n"
+            "    Frag_UV = mix(InstUV.xy, InstUV.zw, corner);\n"
+            "    Frag_Color = InstColor;\n"
+            "    Frag_Pos = pos - (InstRect.xy + InstRect.zw) * 0.5;\n"
+            "    Frag_Shape = vec3(abs(InstRect.zw - InstRect.xy) * 0.5, InstRounding);\n"
+            "    Frag_Corners = InstCorners;\n"
+            "    gl_Position = ProjMtx * vec4(pos.xy,0,1);\n"
+            "}\n";
+
+        const GLchar* instance_fragment_shader_glsl_130 =
+            "uniform sampler2D Texture;\n"
+            "in vec2 Frag_UV;\n"
+            "in vec4 Frag_Color;\n"
+            "in vec2 Frag_Pos;\n"
+            "in vec3 Frag_Shape;\n"
+            "in vec4 Frag_Corners;\n"
+            "out vec4 Out_Color;\n"
+            "void main()\n"
+            "{\n"
+            "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+            "    if (Frag_Shape.z > 0.0)\n"
+            "    {\n"
+            "        vec2 r2 = Frag_Pos.x < 0.0 ? Frag_Corners.xw : Frag_Corners.yz;\n"
+            "        float r = Frag_Shape.z * (Frag_Pos.y < 0.0 ? r2.x : r2.y);\n"
+            "        vec2 q = abs(Frag_Pos) - Frag_Shape.xy + r;\n"
+            "        float d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - r;\n"
+            "        Out_Color.a *= clamp(0.5 - d / max(length(vec2(dFdx(d), dFdy(d))), 0.0001), 0.0, 1.0);\n"
+            "    }\n"
+            "}\n";
+
+        const GLchar* instance_fragment_shader_glsl_300_es =
+            "precision highp float;\n"
+            "uniform sampler2D Texture;\n"
+            "in vec2 Frag_UV;\n"
+            "in vec4 Frag_Color;\n"
+            "in vec2 Frag_Pos;\n"
+            "in vec3 Frag_Shape;\n"
+            "in vec4 Frag_Corners;\n"
+            "layout (location = 0) out vec4 Out_Color;\n"
+            "void main()\n"
+            "{\n"
+            "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+            "    if (Frag_Shape.z > 0.0)\n"
+            "    {\n"
+            "        vec2 r2 = Frag_Pos.x < 0.0 ? Frag_Corners.xw : Frag_Corners.yz;\n"
+            "        float r = Frag_Shape.z * (Frag_Pos.y < 0.0 ? r2.x : r2.y);\n"
+            "        vec2 q = abs(Frag_Pos) - Frag_Shape.xy + r;\n"
+            "        float d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - r;\n"
+            "        Out_Color.a *= clamp(0.5 - d / max(length(vec2(dFdx(d), dFdy(d))), 0.0001), 0.0, 1.0);\n"
+            "    }\n"
+            "}\n";
+
+        const GLchar* instance_fragment_shader_glsl_410_core =
+            "in vec2 Frag_UV;\n"
+            "in vec4 Frag_Color;\n"
+            "in vec2 Frag_Pos;\n"
+            "in vec3 Frag_Shape;\n"
+            "in vec4 Frag_Corners;\n"
+            "uniform sampler2D Texture;\n"
+            "layout (location = 0) out vec4 Out_Color;\n"
+            "void main()\n"
+            "{\n"
+            "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+            "    if (Frag_Shape.z > 0.0)\n"
+            "    {\n"
+            "        vec2 r2 = Frag_Pos.x < 0.0 ? Frag_Corners.xw : Frag_Corners.yz;\n"
+            "        float r = Frag_Shape.z * (Frag_Pos.y < 0.0 ? r2.x : r2.y);\n"
+            "        vec2 q = abs(Frag_Pos) - Frag_Shape.xy + r;\n"
+            "        float d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - r;\n"
+            "        Out_Color.a *= clamp(0.5 - d / max(length(vec2(dFdx(d), dFdy(d))), 0.0001), 0.0, 1.0);\n"
+            "    }\n"
+            "}\n";
+
+        const GLchar* instance_vertex_shader = instance_vertex_shader_glsl_130;
+        const GLchar* instance_fragment_shader = instance_fragment_shader_glsl_130;
+        if (glsl_version >= 410)
+        {
+            instance_vertex_shader = instance_vertex_shader_glsl_410_core;
+            instance_fragment_shader = instance_fragment_shader_glsl_410_core;
+        }
+        else if (glsl_version == 300)
+        {
+            instance_vertex_shader = instance_vertex_shader_glsl_300_es;
+            instance_fragment_shader = instance_fragment_shader_glsl_300_es;
+        }
+        bd->InstanceShaderHandle = CreateProgram(instance_vertex_shader, instance_fragment_shader, "instance shader program");
+        if (bd->InstanceShaderHandle)
+        {
+            bd->InstanceAttribLocationTex = glGetUniformLocation(bd->InstanceShaderHandle, "Texture");
+            bd->InstanceAttribLocationProjMtx = glGetUniformLocation(bd->InstanceShaderHandle, "ProjMtx");
+            bd->InstanceAttribLocationRect = (GLuint)glGetAttribLocation(bd->InstanceShaderHandle, "InstRect");
+            bd->InstanceAttribLocationUV = (GLuint)glGetAttribLocation(bd->InstanceShaderHandle, "InstUV");
+            bd->InstanceAttribLocationColor = (GLuint)glGetAttribLocation(bd->InstanceShaderHandle, "InstColor");
+            bd->InstanceAttribLocationRounding = (GLuint)glGetAttribLocation(bd->InstanceShaderHandle, "InstRounding");
+            bd->InstanceAttribLocationCorners = (GLuint)glGetAttribLocation(bd->InstanceShaderHandle, "InstCorners");
+            glGenBuffers(1, &bd->InstanceVboHandle);
+        }
+        else
+        {
+            io.BackendFlags &= ~ImGuiBackendFlags_RendererHasInstancing; // Fallback to triangles
+        }
+    }
+#endif
 
     ImGui_ImplOpenGL3_CreateFontsTexture();
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+    if (bd->ShaderCacheDirty)
+        ImGui_ImplOpenGL3_SaveShaderCache();
+    bd->ShaderCache.clear();
+#endif
+
     // Restore modified GL state
     glBindTexture(GL_TEXTURE_2D, last_texture);
     glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
@@ -930,7 +1841,11 @@ void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
     if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
     if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
+    if (bd->InstanceVboHandle) { glDeleteBuffers(1, &bd->InstanceVboHandle); bd->InstanceVboHandle = 0; }
+    if (bd->ExternalVboHandle) { glDeleteBuffers(1, &bd->ExternalVboHandle); bd->ExternalVboHandle = 0; }
+    if (bd->ExternalElementsHandle) { glDeleteBuffers(1, &bd->ExternalElementsHandle); bd->ExternalElementsHandle = 0; }
     if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
+    if (bd->InstanceShaderHandle) { glDeleteProgram(bd->InstanceShaderHandle); bd->InstanceShaderHandle = 0; }
     ImGui_ImplOpenGL3_DestroyFontsTexture();
 }
 
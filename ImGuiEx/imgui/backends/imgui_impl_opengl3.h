@@ -33,6 +33,23 @@ IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyFontsTexture();
 IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_CreateDeviceObjects();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyDeviceObjects();
 
+// (Optional) Dynamic textures: GL textures mirroring a CPU-side buffer which stays owned by the caller (must outlive the texture).
+// Mark modified areas with UpdateDynamicTexture(), they are uploaded with glTexSubImage2D() at the start of the next RenderDrawData().
+// 'use_pbo' stages uploads through a pixel buffer object (Desktop GL 3.0+ and GL ES 3.0 only, ignored otherwise).
+enum ImGui_ImplOpenGL3_TextureFormat
+{
+    ImGui_ImplOpenGL3_TextureFormat_RGBA32,     // 4 bytes per pixel
+    ImGui_ImplOpenGL3_TextureFormat_Alpha8,     // 1 byte per pixel, sampled as (1,1,1,a)
+};
+IMGUI_IMPL_API ImTextureID ImGui_ImplOpenGL3_CreateDynamicTexture(const void* pixels, int width, int height, ImGui_ImplOpenGL3_TextureFormat format, bool use_pbo = false);
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_UpdateDynamicTexture(ImTextureID tex_id, int x, int y, int w, int h);
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyDynamicTexture(ImTextureID tex_id);
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_UploadDynamicTextures();  // Called by RenderDrawData(), call earlier if you need the contents before that
+
+// (Optional) Store linked program binaries in a file to skip shader compilation on next startup. Call after Init, nullptr to disable (default).
+// Ignored when the driver doesn't support program binaries (needs GL 4.1, GL_ARB_get_program_binary or GL ES 3.0).
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetShaderCachePath(const char* path);
+
 // Specific OpenGL ES versions
 //#define IMGUI_IMPL_OPENGL_ES2     // Auto-detected on Emscripten
 //#define IMGUI_IMPL_OPENGL_ES3     // Auto-detected on iOS/Android
@@ -995,6 +995,9 @@ static const float NAV_WINDOWING_LIST_APPEAR_DELAY          = 0.15f;    // Time
 static const float WINDOWS_HOVER_PADDING                    = 4.0f;     // Extend outside window for hovering/resizing (maxxed with TouchPadding) and inside windows for borders. Affect FindHoveredWindow().
 static const float WINDOWS_RESIZE_FROM_EDGES_FEEDBACK_TIMER = 0.04f;    // Reduce visual noise by only highlighting the border after a certain time.
 static const float WINDOWS_MOUSE_WHEEL_SCROLL_LOCK_TIMER    = 0.70f;    // Lock scrolled window (so it doesn't pick child windows that are scrolling through) for a certain time, unless mouse moved.
+static const float WINDOWS_HIT_GRID_CELL_SIZE               = 256.0f;   // Cell size of g.WindowsHitGrid. Affect FindHoveredWindow().
+static const int   WINDOWS_HIT_GRID_MAX_CELLS               = 64;       // Windows covering more cells are tested by every FindHoveredWindow() query instead.
+static const int   WINDOWS_HIT_GRID_COMPACT_MIN_CELLS       = 256;      // g.WindowsHitGrid is rebuilt when it has more cells than this and less than a quarter of them are used.
 
 // Docking
 static const float DOCKING_TRANSPARENT_PAYLOAD_ALPHA        = 0.50f;    // For use with io.ConfigDockingTransparentPayload. Apply to Viewport _or_ WindowBg in host viewport.
@@ -1006,6 +1009,9 @@ static const float DOCKING_SPLITTER_SIZE                    = 2.0f;
 
 static void             SetCurrentWindow(ImGuiWindow* window);
 static void             FindHoveredWindow();
+static void             WindowHitGridUpdate(ImGuiWindow* window);
+static void             WindowHitGridRemove(ImGuiWindow* window);
+static void             WindowHitGridCompact();
 static ImGuiWindow*     CreateNewWindow(const char* name, ImGuiWindowFlags flags);
 static ImVec2           CalcNextScrollFromScrollTargetAndClamp(ImGuiWindow* window);
 
@@ -1062,6 +1068,7 @@ static void             UpdateKeyRoutingTable(ImGuiKeyRoutingTable* rt);
 
 // Misc
 static void             UpdateSettings();
+static void             UpdateWindowsOcclusionCulling();
 static bool             UpdateWindowManualResize(ImGuiWindow* window, const ImVec2& size_auto_fit, int* border_held, int resize_grip_count, ImU32 resize_grip_col[4], const ImRect& visibility_rect);
 static void             RenderWindowOuterBorders(ImGuiWindow* window);
 static void             RenderWindowDecorations(ImGuiWindow* window, const ImRect& title_bar_rect, bool title_bar_is_highlight, bool handle_borders_and_resize_grips, int resize_grip_count, const ImU32 resize_grip_col[4], float resize_grip_draw_size);
@@ -1128,6 +1135,9 @@ static ImGuiMemAllocFunc    GImAllocatorAllocFunc = MallocWrapper;
 static ImGuiMemFreeFunc     GImAllocatorFreeFunc = FreeWrapper;
 static void*                GImAllocatorUserData = NULL;
 
+// Last ImGuiContext::WindowHandleSerial handed out, so that handles filled by a destroyed context never match a new one
+static ImU32                GWindowHandleSerial = 0;
+
 //-----------------------------------------------------------------------------
 // [SECTION] USER FACING STRUCTURES (ImGuiStyle, ImGuiIO)
 //-----------------------------------------------------------------------------
@@ -1269,6 +1279,7 @@ ImGuiIO::ImGuiIO()
     ConfigDragClickToInputText = false;
     ConfigWindowsResizeFromEdges = true;
     ConfigWindowsMoveFromTitleBarOnly = false;
+    ConfigWindowsOcclusionCulling = false;
     ConfigMemoryCompactTimer = 60.0f;
     ConfigDebugBeginReturnValueOnce = false;
     ConfigDebugBeginReturnValueLoop = false;
@@ -1942,68 +1953,268 @@ void ImFormatStringToTempBufferV(const char** out_buf, const char** out_buf_end,
     }
 }
 
-// CRC32 needs a 1KB lookup table (not cache friendly)
+// CRC32 needs lookup tables (not cache friendly)
 // Although the code to generate the table is simple and shorter than the table itself, using a const table allows us to easily:
 // - avoid an unnecessary branch/memory tap, - keep the ImHashXXX functions usable by static constructors, - make it thread-safe.
-static const ImU32 GCrc32LookupTable[256] =
-{
-    0x00000000,0x77073096,0xEE0E612C,0x990951BA,0x076DC419,0x706AF48F,0xE963A535,0x9E6495A3,0x0EDB8832,0x79DCB8A4,0xE0D5E91E,0x97D2D988,0x09B64C2B,0x7EB17CBD,0xE7B82D07,0x90BF1D91,
-    0x1DB71064,0x6AB020F2,0xF3B97148,0x84BE41DE,0x1ADAD47D,0x6DDDE4EB,0xF4D4B551,0x83D385C7,0x136C9856,0x646BA8C0,0xFD62F97A,0x8A65C9EC,0x14015C4F,0x63066CD9,0xFA0F3D63,0x8D080DF5,
-    0x3B6E20C8,0x4C69105E,0xD56041E4,0xA2677172,0x3C03E4D1,0x4B04D447,0xD20D85FD,0xA50AB56B,0x35B5A8FA,0x42B2986C,0xDBBBC9D6,0xACBCF940,0x32D86CE3,0x45DF5C75,0xDCD60DCF,0xABD13D59,
-    0x26D930AC,0x51DE003A,0xC8D75180,0xBFD06116,0x21B4F4B5,0x56B3C423,0xCFBA9599,0xB8BDA50F,0x2802B89E,0x5F058808,0xC60CD9B2,0xB10BE924,0x2F6F7C87,0x58684C11,0xC1611DAB,0xB6662D3D,
-    0x76DC4190,0x01DB7106,0x98D220BC,0xEFD5102A,0x71B18589,0x06B6B51F,0x9FBFE4A5,0xE8B8D433,0x7807C9A2,0x0F00F934,0x9609A88E,0xE10E9818,0x7F6A0DBB,0x086D3D2D,0x91646C97,0xE6635C01,
-    0x6B6B51F4,0x1C6C6162,0x856530D8,0xF262004E,0x6C0695ED,0x1B01A57B,0x8208F4C1,0xF50FC457,0x65B0D9C6,0x12B7E950,0x8BBEB8EA,0xFCB9887C,0x62DD1DDF,0x15DA2D49,0x8CD37CF3,0xFBD44C65,
-    0x4DB26158,0x3AB551CE,0xA3BC0074,0xD4BB30E2,0x4ADFA541,0x3DD895D7,0xA4D1C46D,0xD3D6F4FB,0x4369E96A,0x346ED9FC,0xAD678846,0xDA60B8D0,0x44042D73,0x33031DE5,0xAA0A4C5F,0xDD0D7CC9,
-    0x5005713C,0x270241AA,0xBE0B1010,0xC90C2086,0x5768B525,0x206F85B3,0xB966D409,0xCE61E49F,0x5EDEF90E,0x29D9C998,0xB0D09822,0xC7D7A8B4,0x59B33D17,0x2EB40D81,0xB7BD5C3B,0xC0BA6CAD,
-    0xEDB88320,0x9ABFB3B6,0x03B6E20C,0x74B1D29A,0xEAD54739,0x9DD277AF,0x04DB2615,0x73DC1683,0xE3630B12,0x94643B84,0x0D6D6A3E,0x7A6A5AA8,0xE40ECF0B,0x9309FF9D,0x0A00AE27,0x7D079EB1,
-    0xF00F9344,0x8708A3D2,0x1E01F268,0x6906C2FE,0xF762575D,0x806567CB,0x196C3671,0x6E6B06E7,0xFED41B76,0x89D32BE0,0x10DA7A5A,0x67DD4ACC,0xF9B9DF6F,0x8EBEEFF9,0x17B7BE43,0x60B08ED5,
-    0xD6D6A3E8,0xA1D1937E,0x38D8C2C4,0x4FDFF252,0xD1BB67F1,0xA6BC5767,0x3FB506DD,0x48B2364B,0xD80D2BDA,0xAF0A1B4C,0x36034AF6,0x41047A60,0xDF60EFC3,0xA867DF55,0x316E8EEF,0x4669BE79,
-    0xCB61B38C,0xBC66831A,0x256FD2A0,0x5268E236,0xCC0C7795,0xBB0B4703,0x220216B9,0x5505262F,0xC5BA3BBE,0xB2BD0B28,0x2BB45A92,0x5CB36A04,0xC2D7FFA7,0xB5D0CF31,0x2CD99E8B,0x5BDEAE1D,
-    0x9B64C2B0,0xEC63F226,0x756AA39C,0x026D930A,0x9C0906A9,0xEB0E363F,0x72076785,0x05005713,0x95BF4A82,0xE2B87A14,0x7BB12BAE,0x0CB61B38,0x92D28E9B,0xE5D5BE0D,0x7CDCEFB7,0x0BDBDF21,
-    0x86D3D2D4,0xF1D4E242,0x68DDB3F8,0x1FDA836E,0x81BE16CD,0xF6B9265B,0x6FB077E1,0x18B74777,0x88085AE6,0xFF0F6A70,0x66063BCA,0x11010B5C,0x8F659EFF,0xF862AE69,0x616BFFD3,0x166CCF45,
-    0xA00AE278,0xD70DD2EE,0x4E048354,0x3903B3C2,0xA7672661,0xD06016F7,0x4969474D,0x3E6E77DB,0xAED16A4A,0xD9D65ADC,0x40DF0B66,0x37D83BF0,0xA9BCAE53,0xDEBB9EC5,0x47B2CF7F,0x30B5FFE9,
-    0xBDBDF21C,0xCABAC28A,0x53B39330,0x24B4A3A6,0xBAD03605,0xCDD70693,0x54DE5729,0x23D967BF,0xB3667A2E,0xC4614AB8,0x5D681B02,0x2A6F2B94,0xB40BBE37,0xC30C8EA1,0x5A05DF1B,0x2D02EF8D,
+// GCrc32LookupTable[0] is the classic byte-at-a-time table, [1..7] extend it to process 8 bytes per step ("slicing-by-8", 8KB).
+static const ImU32 GCrc32LookupTable[8][256] =
+{
+    {
+        0x00000000,0x77073096,0xEE0E612C,0x990951BA,0x076DC419,0x706AF48F,0xE963A535,0x9E6495A3,0x0EDB8832,0x79DCB8A4,0xE0D5E91E,0x97D2D988,0x09B64C2B,0x7EB17CBD,0xE7B82D07,0x90BF1D91,
+        0x1DB71064,0x6AB020F2,0xF3B97148,0x84BE41DE,0x1ADAD47D,0x6DDDE4EB,0xF4D4B551,0x83D385C7,0x136C9856,0x646BA8C0,0xFD62F97A,0x8A65C9EC,0x14015C4F,0x63066CD9,0xFA0F3D63,0x8D080DF5,
+        0x3B6E20C8,0x4C69105E,0xD56041E4,0xA2677172,0x3C03E4D1,0x4B04D447,0xD20D85FD,0xA50AB56B,0x35B5A8FA,0x42B2986C,0xDBBBC9D6,0xACBCF940,0x32D86CE3,0x45DF5C75,0xDCD60DCF,0xABD13D59,
+        0x26D930AC,0x51DE003A,0xC8D75180,0xBFD06116,0x21B4F4B5,0x56B3C423,0xCFBA9599,0xB8BDA50F,0x2802B89E,0x5F058808,0xC60CD9B2,0xB10BE924,0x2F6F7C87,0x58684C11,0xC1611DAB,0xB6662D3D,
+        0x76DC4190,0x01DB7106,0x98D220BC,0xEFD5102A,0x71B18589,0x06B6B51F,0x9FBFE4A5,0xE8B8D433,0x7807C9A2,0x0F00F934,0x9609A88E,0xE10E9818,0x7F6A0DBB,0x086D3D2D,0x91646C97,0xE6635C01,
+        0x6B6B51F4,0x1C6C6162,0x856530D8,0xF262004E,0x6C0695ED,0x1B01A57B,0x8208F4C1,0xF50FC457,0x65B0D9C6,0x12B7E950,0x8BBEB8EA,0xFCB9887C,0x62DD1DDF,0x15DA2D49,0x8CD37CF3,0xFBD44C65,
+        0x4DB26158,0x3AB551CE,0xA3BC0074,0xD4BB30E2,0x4ADFA541,0x3DD895D7,0xA4D1C46D,0xD3D6F4FB,0x4369E96A,0x346ED9FC,0xAD678846,0xDA60B8D0,0x44042D73,0x33031DE5,0xAA0A4C5F,0xDD0D7CC9,
+        0x5005713C,0x270241AA,0xBE0B1010,0xC90C2086,0x5768B525,0x206F85B3,0xB966D409,0xCE61E49F,0x5EDEF90E,0x29D9C998,0xB0D09822,0xC7D7A8B4,0x59B33D17,0x2EB40D81,0xB7BD5C3B,0xC0BA6CAD,
+        0xEDB88320,0x9ABFB3B6,0x03B6E20C,0x74B1D29A,0xEAD54739,0x9DD277AF,0x04DB2615,0x73DC1683,0xE3630B12,0x94643B84,0x0D6D6A3E,0x7A6A5AA8,0xE40ECF0B,0x9309FF9D,0x0A00AE27,0x7D079EB1,
+        0xF00F9344,0x8708A3D2,0x1E01F268,0x6906C2FE,0xF762575D,0x806567CB,0x196C3671,0x6E6B06E7,0xFED41B76,0x89D32BE0,0x10DA7A5A,0x67DD4ACC,0xF9B9DF6F,0x8EBEEFF9,0x17B7BE43,0x60B08ED5,
+        0xD6D6A3E8,0xA1D1937E,0x38D8C2C4,0x4FDFF252,0xD1BB67F1,0xA6BC5767,0x3FB506DD,0x48B2364B,0xD80D2BDA,0xAF0A1B4C,0x36034AF6,0x41047A60,0xDF60EFC3,0xA867DF55,0x316E8EEF,0x4669BE79,
+        0xCB61B38C,0xBC66831A,0x256FD2A0,0x5268E236,0xCC0C7795,0xBB0B4703,0x220216B9,0x5505262F,0xC5BA3BBE,0xB2BD0B28,0x2BB45A92,0x5CB36A04,0xC2D7FFA7,0xB5D0CF31,0x2CD99E8B,0x5BDEAE1D,
+        0x9B64C2B0,0xEC63F226,0x756AA39C,0x026D930A,0x9C0906A9,0xEB0E363F,0x72076785,0x05005713,0x95BF4A82,0xE2B87A14,0x7BB12BAE,0x0CB61B38,0x92D28E9B,0xE5D5BE0D,0x7CDCEFB7,0x0BDBDF21,
+        0x86D3D2D4,0xF1D4E242,0x68DDB3F8,0x1FDA836E,0x81BE16CD,0xF6B9265B,0x6FB077E1,0x18B74777,0x88085AE6,0xFF0F6A70,0x66063BCA,0x11010B5C,0x8F659EFF,0xF862AE69,0x616BFFD3,0x166CCF45,
+        0xA00AE278,0xD70DD2EE,0x4E048354,0x3903B3C2,0xA7672661,0xD06016F7,0x4969474D,0x3E6E77DB,0xAED16A4A,0xD9D65ADC,0x40DF0B66,0x37D83BF0,0xA9BCAE53,0xDEBB9EC5,0x47B2CF7F,0x30B5FFE9,
+        0xBDBDF21C,0xCABAC28A,0x53B39330,0x24B4A3A6,0xBAD03605,0xCDD70693,0x54DE5729,0x23D967BF,0xB3667A2E,0xC4614AB8,0x5D681B02,0x2A6F2B94,0xB40BBE37,0xC30C8EA1,0x5A05DF1B,0x2D02EF8D,
+    },
+    {
+        0x00000000,0x191B3141,0x32366282,0x2B2D53C3,0x646CC504,0x7D77F445,0x565AA786,0x4F4196C7,0xC8D98A08,0xD1C2BB49,0xFAEFE88A,0xE3F4D9CB,0xACB54F0C,0xB5AE7E4D,0x9E832D8E,0x87981CCF,
+        0x4AC21251,0x53D92310,0x78F470D3,0x61EF4192,0x2EAED755,0x37B5E614,0x1C98B5D7,0x05838496,0x821B9859,0x9B00A918,0xB02DFADB,0xA936CB9A,0xE6775D5D,0xFF6C6C1C,0xD4413FDF,0xCD5A0E9E,
+        0x958424A2,0x8C9F15E3,0xA7B24620,0xBEA97761,0xF1E8E1A6,0xE8F3D0E7,0xC3DE8324,0xDAC5B265,0x5D5DAEAA,0x44469FEB,0x6F6BCC28,0x7670FD69,0x39316BAE,0x202A5AEF,0x0B07092C,0x121C386D,
+        0xDF4636F3,0xC65D07B2,0xED705471,0xF46B6530,0xBB2AF3F7,0xA231C2B6,0x891C9175,0x9007A034,0x179FBCFB,0x0E848DBA,0x25A9DE79,0x3CB2EF38,0x73F379FF,0x6AE848BE,0x41C51B7D,0x58DE2A3C,
+        0xF0794F05,0xE9627E44,0xC24F2D87,0xDB541CC6,0x94158A01,0x8D0EBB40,0xA623E883,0xBF38D9C2,0x38A0C50D,0x21BBF44C,0x0A96A78F,0x138D96CE,0x5CCC0009,0x45D73148,0x6EFA628B,0x77E153CA,
+        0xBABB5D54,0xA3A06C15,0x888D3FD6,0x91960E97,0xDED79850,0xC7CCA911,0xECE1FAD2,0xF5FACB93,0x7262D75C,0x6B79E61D,0x4054B5DE,0x594F849F,0x160E1258,0x0F152319,0x243870DA,0x3D23419B,
+        0x65FD6BA7,0x7CE65AE6,0x57CB0925,0x4ED03864,0x0191AEA3,0x188A9FE2,0x33A7CC21,0x2ABCFD60,0xAD24E1AF,0xB43FD0EE,0x9F12832D,0x8609B26C,0xC94824AB,0xD05315EA,0xFB7E4629,0xE2657768,
+        0x2F3F79F6,0x362448B7,0x1D091B74,0x04122A35,0x4B53BCF2,0x52488DB3,0x7965DE70,0x607EEF31,0xE7E6F3FE,0xFEFDC2BF,0xD5D0917C,0xCCCBA03D,0x838A36FA,0x9A9107BB,0xB1BC5478,0xA8A76539,
+        0x3B83984B,0x2298A90A,0x09B5FAC9,0x10AECB88,0x5FEF5D4F,0x46F46C0E,0x6DD93FCD,0x74C20E8C,0xF35A1243,0xEA412302,0xC16C70C1,0xD8774180,0x9736D747,0x8E2DE606,0xA500B5C5,0xBC1B8484,
+        0x71418A1A,0x685ABB5B,0x4377E898,0x5A6CD9D9,0x152D4F1E,0x0C367E5F,0x271B2D9C,0x3E001CDD,0xB9980012,0xA0833153,0x8BAE6290,0x92B553D1,0xDDF4C516,0xC4EFF457,0xEFC2A794,0xF6D996D5,
+        0xAE07BCE9,0xB71C8DA8,0x9C31DE6B,0x852AEF2A,0xCA6B79ED,0xD37048AC,0xF85D1B6F,0xE1462A2E,0x66DE36E1,0x7FC507A0,0x54E85463,0x4DF36522,0x02B2F3E5,0x1BA9C2A4,0x30849167,0x299FA026,
+        0xE4C5AEB8,0xFDDE9FF9,0xD6F3CC3A,0xCFE8FD7B,0x80A96BBC,0x99B25AFD,0xB29F093E,0xAB84387F,0x2C1C24B0,0x350715F1,0x1E2A4632,0x07317773,0x4870E1B4,0x516BD0F5,0x7A468336,0x635DB277,
+        0xCBFAD74E,0xD2E1E60F,0xF9CCB5CC,0xE0D7848D,0xAF96124A,0xB68D230B,0x9DA070C8,0x84BB4189,0x03235D46,0x1A386C07,0x31153FC4,0x280E0E85,0x674F9842,0x7E54A903,0x5579FAC0,0x4C62CB81,
+        0x8138C51F,0x9823F45E,0xB30EA79D,0xAA1596DC,0xE554001B,0xFC4F315A,0xD7626299,0xCE7953D8,0x49E14F17,0x50FA7E56,0x7BD72D95,0x62CC1CD4,0x2D8D8A13,0x3496BB52,0x1FBBE891,0x06A0D9D0,
+        0x5E7EF3EC,0x4765C2AD,0x6C48916E,0x7553A02F,0x3A1236E8,0x230907A9,0x0824546A,0x113F652B,0x96A779E4,0x8FBC48A5,0xA4911B66,0xBD8A2A27,0xF2CBBCE0,0xEBD08DA1,0xC0FDDE62,0xD9E6EF23,
+        0x14BCE1BD,0x0DA7D0FC,0x268A833F,0x3F91B27E,0x70D024B9,0x69CB15F8,0x42E6463B,0x5BFD777A,0xDC656BB5,0xC57E5AF4,0xEE530937,0xF7483876,0xB809AEB1,0xA1129FF0,0x8A3FCC33,0x9324FD72,
+    },
+    {
+        0x00000000,0x01C26A37,0x0384D46E,0x0246BE59,0x0709A8DC,0x06CBC2EB,0x048D7CB2,0x054F1685,0x0E1351B8,0x0FD13B8F,0x0D9785D6,0x0C55EFE1,0x091AF964,0x08D89353,0x0A9E2D0A,0x0B5C473D,
+        0x1C26A370,0x1DE4C947,0x1FA2771E,0x1E601D29,0x1B2F0BAC,0x1AED619B,0x18ABDFC2,0x1969B5F5,0x1235F2C8,0x13F798FF,0x11B126A6,0x10734C91,0x153C5A14,0x14FE3023,0x16B88E7A,0x177AE44D,
+        0x384D46E0,0x398F2CD7,0x3BC9928E,0x3A0BF8B9,0x3F44EE3C,0x3E86840B,0x3CC03A52,0x3D025065,0x365E1758,0x379C7D6F,0x35DAC336,0x3418A901,0x3157BF84,0x3095D5B3,0x32D36BEA,0x331101DD,
+        0x246BE590,0x25A98FA7,0x27EF31FE,0x262D5BC9,0x23624D4C,0x22A0277B,0x20E69922,0x2124F315,0x2A78B428,0x2BBADE1F,0x29FC6046,0x283E0A71,0x2D711CF4,0x2CB376C3,0x2EF5C89A,0x2F37A2AD,
+        0x709A8DC0,0x7158E7F7,0x731E59AE,0x72DC3399,0x7793251C,0x76514F2B,0x7417F172,0x75D59B45,0x7E89DC78,0x7F4BB64F,0x7D0D0816,0x7CCF6221,0x798074A4,0x78421E93,0x7A04A0CA,0x7BC6CAFD,
+        0x6CBC2EB0,0x6D7E4487,0x6F38FADE,0x6EFA90E9,0x6BB5866C,0x6A77EC5B,0x68315202,0x69F33835,0x62AF7F08,0x636D153F,0x612BAB66,0x60E9C151,0x65A6D7D4,0x6464BDE3,0x662203BA,0x67E0698D,
+        0x48D7CB20,0x4915A117,0x4B531F4E,0x4A917579,0x4FDE63FC,0x4E1C09CB,0x4C5AB792,0x4D98DDA5,0x46C49A98,0x4706F0AF,0x45404EF6,0x448224C1,0x41CD3244,0x400F5873,0x4249E62A,0x438B8C1D,
+        0x54F16850,0x55330267,0x5775BC3E,0x56B7D609,0x53F8C08C,0x523AAABB,0x507C14E2,0x51BE7ED5,0x5AE239E8,0x5B2053DF,0x5966ED86,0x58A487B1,0x5DEB9134,0x5C29FB03,0x5E6F455A,0x5FAD2F6D,
+        0xE1351B80,0xE0F771B7,0xE2B1CFEE,0xE373A5D9,0xE63CB35C,0xE7FED96B,0xE5B86732,0xE47A0D05,0xEF264A38,0xEEE4200F,0xECA29E56,0xED60F461,0xE82FE2E4,0xE9ED88D3,0xEBAB368A,0xEA695CBD,
+        0xFD13B8F0,0xFCD1D2C7,0xFE976C9E,0xFF5506A9,0xFA1A102C,0xFBD87A1B,0xF99EC442,0xF85CAE75,0xF300E948,0xF2C2837F,0xF0843D26,0xF1465711,0xF4094194,0xF5CB2BA3,0xF78D95FA,0xF64FFFCD,
+        0xD9785D60,0xD8BA3757,0xDAFC890E,0xDB3EE339,0xDE71F5BC,0xDFB39F8B,0xDDF521D2,0xDC374BE5,0xD76B0CD8,0xD6A966EF,0xD4EFD8B6,0xD52DB281,0xD062A404,0xD1A0CE33,0xD3E6706A,0xD2241A5D,
+        0xC55EFE10,0xC49C9427,0xC6DA2A7E,0xC7184049,0xC25756CC,0xC3953CFB,0xC1D382A2,0xC011E895,0xCB4DAFA8,0xCA8FC59F,0xC8C97BC6,0xC90B11F1,0xCC440774,0xCD866D43,0xCFC0D31A,0xCE02B92D,
+        0x91AF9640,0x906DFC77,0x922B422E,0x93E92819,0x96A63E9C,0x976454AB,0x9522EAF2,0x94E080C5,0x9FBCC7F8,0x9E7EADCF,0x9C381396,0x9DFA79A1,0x98B56F24,0x99770513,0x9B31BB4A,0x9AF3D17D,
+        0x8D893530,0x8C4B5F07,0x8E0DE15E,0x8FCF8B69,0x8A809DEC,0x8B42F7DB,0x89044982,0x88C623B5,0x839A6488,0x82580EBF,0x801EB0E6,0x81DCDAD1,0x8493CC54,0x8551A663,0x8717183A,0x86D5720D,
+        0xA9E2D0A0,0xA820BA97,0xAA6604CE,0xABA46EF9,0xAEEB787C,0xAF29124B,0xAD6FAC12,0xACADC625,0xA7F18118,0xA633EB2F,0xA4755576,0xA5B73F41,0xA0F829C4,0xA13A43F3,0xA37CFDAA,0xA2BE979D,
+        0xB5C473D0,0xB40619E7,0xB640A7BE,0xB782CD89,0xB2CDDB0C,0xB30FB13B,0xB1490F62,0xB08B6555,0xBBD72268,0xBA15485F,0xB853F606,0xB9919C31,0xBCDE8AB4,0xBD1CE083,0xBF5A5EDA,0xBE9834ED,
+    },
+    {
+        0x00000000,0xB8BC6765,0xAA09C88B,0x12B5AFEE,0x8F629757,0x37DEF032,0x256B5FDC,0x9DD738B9,0xC5B428EF,0x7D084F8A,0x6FBDE064,0xD7018701,0x4AD6BFB8,0xF26AD8DD,0xE0DF7733,0x58631056,
+        0x5019579F,0xE8A530FA,0xFA109F14,0x42ACF871,0xDF7BC0C8,0x67C7A7AD,0x75720843,0xCDCE6F26,0x95AD7F70,0x2D111815,0x3FA4B7FB,0x8718D09E,0x1ACFE827,0xA2738F42,0xB0C620AC,0x087A47C9,
+        0xA032AF3E,0x188EC85B,0x0A3B67B5,0xB28700D0,0x2F503869,0x97EC5F0C,0x8559F0E2,0x3DE59787,0x658687D1,0xDD3AE0B4,0xCF8F4F5A,0x7733283F,0xEAE41086,0x525877E3,0x40EDD80D,0xF851BF68,
+        0xF02BF8A1,0x48979FC4,0x5A22302A,0xE29E574F,0x7F496FF6,0xC7F50893,0xD540A77D,0x6DFCC018,0x359FD04E,0x8D23B72B,0x9F9618C5,0x272A7FA0,0xBAFD4719,0x0241207C,0x10F48F92,0xA848E8F7,
+        0x9B14583D,0x23A83F58,0x311D90B6,0x89A1F7D3,0x1476CF6A,0xACCAA80F,0xBE7F07E1,0x06C36084,0x5EA070D2,0xE61C17B7,0xF4A9B859,0x4C15DF3C,0xD1C2E785,0x697E80E0,0x7BCB2F0E,0xC377486B,
+        0xCB0D0FA2,0x73B168C7,0x6104C729,0xD9B8A04C,0x446F98F5,0xFCD3FF90,0xEE66507E,0x56DA371B,0x0EB9274D,0xB6054028,0xA4B0EFC6,0x1C0C88A3,0x81DBB01A,0x3967D77F,0x2BD27891,0x936E1FF4,
+        0x3B26F703,0x839A9066,0x912F3F88,0x299358ED,0xB4446054,0x0CF80731,0x1E4DA8DF,0xA6F1CFBA,0xFE92DFEC,0x462EB889,0x549B1767,0xEC277002,0x71F048BB,0xC94C2FDE,0xDBF98030,0x6345E755,
+        0x6B3FA09C,0xD383C7F9,0xC1366817,0x798A0F72,0xE45D37CB,0x5CE150AE,0x4E54FF40,0xF6E89825,0xAE8B8873,0x1637EF16,0x048240F8,0xBC3E279D,0x21E91F24,0x99557841,0x8BE0D7AF,0x335CB0CA,
+        0xED59B63B,0x55E5D15E,0x47507EB0,0xFFEC19D5,0x623B216C,0xDA874609,0xC832E9E7,0x708E8E82,0x28ED9ED4,0x9051F9B1,0x82E4565F,0x3A58313A,0xA78F0983,0x1F336EE6,0x0D86C108,0xB53AA66D,
+        0xBD40E1A4,0x05FC86C1,0x1749292F,0xAFF54E4A,0x322276F3,0x8A9E1196,0x982BBE78,0x2097D91D,0x78F4C94B,0xC048AE2E,0xD2FD01C0,0x6A4166A5,0xF7965E1C,0x4F2A3979,0x5D9F9697,0xE523F1F2,
+        0x4D6B1905,0xF5D77E60,0xE762D18E,0x5FDEB6EB,0xC2098E52,0x7AB5E937,0x680046D9,0xD0BC21BC,0x88DF31EA,0x3063568F,0x22D6F961,0x9A6A9E04,0x07BDA6BD,0xBF01C1D8,0xADB46E36,0x15080953,
+        0x1D724E9A,0xA5CE29FF,0xB77B8611,0x0FC7E174,0x9210D9CD,0x2AACBEA8,0x38191146,0x80A57623,0xD8C66675,0x607A0110,0x72CFAEFE,0xCA73C99B,0x57A4F122,0xEF189647,0xFDAD39A9,0x45115ECC,
+        0x764DEE06,0xCEF18963,0xDC44268D,0x64F841E8,0xF92F7951,0x41931E34,0x5326B1DA,0xEB9AD6BF,0xB3F9C6E9,0x0B45A18C,0x19F00E62,0xA14C6907,0x3C9B51BE,0x842736DB,0x96929935,0x2E2EFE50,
+        0x2654B999,0x9EE8DEFC,0x8C5D7112,0x34E11677,0xA9362ECE,0x118A49AB,0x033FE645,0xBB838120,0xE3E09176,0x5B5CF613,0x49E959FD,0xF1553E98,0x6C820621,0xD43E6144,0xC68BCEAA,0x7E37A9CF,
+        0xD67F4138,0x6EC3265D,0x7C7689B3,0xC4CAEED6,0x591DD66F,0xE1A1B10A,0xF3141EE4,0x4BA87981,0x13CB69D7,0xAB770EB2,0xB9C2A15C,0x017EC639,0x9CA9FE80,0x241599E5,0x36A0360B,0x8E1C516E,
+        0x866616A7,0x3EDA71C2,0x2C6FDE2C,0x94D3B949,0x090481F0,0xB1B8E695,0xA30D497B,0x1BB12E1E,0x43D23E48,0xFB6E592D,0xE9DBF6C3,0x516791A6,0xCCB0A91F,0x740CCE7A,0x66B96194,0xDE0506F1,
+    },
+    {
+        0x00000000,0x3D6029B0,0x7AC05360,0x47A07AD0,0xF580A6C0,0xC8E08F70,0x8F40F5A0,0xB220DC10,0x30704BC1,0x0D106271,0x4AB018A1,0x77D03111,0xC5F0ED01,0xF890C4B1,0xBF30BE61,0x825097D1,
+        0x60E09782,0x5D80BE32,0x1A20C4E2,0x2740ED52,0x95603142,0xA80018F2,0xEFA06222,0xD2C04B92,0x5090DC43,0x6DF0F5F3,0x2A508F23,0x1730A693,0xA5107A83,0x98705333,0xDFD029E3,0xE2B00053,
+        0xC1C12F04,0xFCA106B4,0xBB017C64,0x866155D4,0x344189C4,0x0921A074,0x4E81DAA4,0x73E1F314,0xF1B164C5,0xCCD14D75,0x8B7137A5,0xB6111E15,0x0431C205,0x3951EBB5,0x7EF19165,0x4391B8D5,
+        0xA121B886,0x9C419136,0xDBE1EBE6,0xE681C256,0x54A11E46,0x69C137F6,0x2E614D26,0x13016496,0x9151F347,0xAC31DAF7,0xEB91A027,0xD6F18997,0x64D15587,0x59B17C37,0x1E1106E7,0x23712F57,
+        0x58F35849,0x659371F9,0x22330B29,0x1F532299,0xAD73FE89,0x9013D739,0xD7B3ADE9,0xEAD38459,0x68831388,0x55E33A38,0x124340E8,0x2F236958,0x9D03B548,0xA0639CF8,0xE7C3E628,0xDAA3CF98,
+        0x3813CFCB,0x0573E67B,0x42D39CAB,0x7FB3B51B,0xCD93690B,0xF0F340BB,0xB7533A6B,0x8A3313DB,0x0863840A,0x3503ADBA,0x72A3D76A,0x4FC3FEDA,0xFDE322CA,0xC0830B7A,0x872371AA,0xBA43581A,
+        0x9932774D,0xA4525EFD,0xE3F2242D,0xDE920D9D,0x6CB2D18D,0x51D2F83D,0x167282ED,0x2B12AB5D,0xA9423C8C,0x9422153C,0xD3826FEC,0xEEE2465C,0x5CC29A4C,0x61A2B3FC,0x2602C92C,0x1B62E09C,
+        0xF9D2E0CF,0xC4B2C97F,0x8312B3AF,0xBE729A1F,0x0C52460F,0x31326FBF,0x7692156F,0x4BF23CDF,0xC9A2AB0E,0xF4C282BE,0xB362F86E,0x8E02D1DE,0x3C220DCE,0x0142247E,0x46E25EAE,0x7B82771E,
+        0xB1E6B092,0x8C869922,0xCB26E3F2,0xF646CA42,0x44661652,0x79063FE2,0x3EA64532,0x03C66C82,0x8196FB53,0xBCF6D2E3,0xFB56A833,0xC6368183,0x74165D93,0x49767423,0x0ED60EF3,0x33B62743,
+        0xD1062710,0xEC660EA0,0xABC67470,0x96A65DC0,0x248681D0,0x19E6A860,0x5E46D2B0,0x6326FB00,0xE1766CD1,0xDC164561,0x9BB63FB1,0xA6D61601,0x14F6CA11,0x2996E3A1,0x6E369971,0x5356B0C1,
+        0x70279F96,0x4D47B626,0x0AE7CCF6,0x3787E546,0x85A73956,0xB8C710E6,0xFF676A36,0xC2074386,0x4057D457,0x7D37FDE7,0x3A978737,0x07F7AE87,0xB5D77297,0x88B75B27,0xCF1721F7,0xF2770847,
+        0x10C70814,0x2DA721A4,0x6A075B74,0x576772C4,0xE547AED4,0xD8278764,0x9F87FDB4,0xA2E7D404,0x20B743D5,0x1DD76A65,0x5A7710B5,0x67173905,0xD537E515,0xE857CCA5,0xAFF7B675,0x92979FC5,
+        0xE915E8DB,0xD475C16B,0x93D5BBBB,0xAEB5920B,0x1C954E1B,0x21F567AB,0x66551D7B,0x5B3534CB,0xD965A31A,0xE4058AAA,0xA3A5F07A,0x9EC5D9CA,0x2CE505DA,0x11852C6A,0x562556BA,0x6B457F0A,
+        0x89F57F59,0xB49556E9,0xF3352C39,0xCE550589,0x7C75D999,0x4115F029,0x06B58AF9,0x3BD5A349,0xB9853498,0x84E51D28,0xC34567F8,0xFE254E48,0x4C059258,0x7165BBE8,0x36C5C138,0x0BA5E888,
+        0x28D4C7DF,0x15B4EE6F,0x521494BF,0x6F74BD0F,0xDD54611F,0xE03448AF,0xA794327F,0x9AF41BCF,0x18A48C1E,0x25C4A5AE,0x6264DF7E,0x5F04F6CE,0xED242ADE,0xD044036E,0x97E479BE,0xAA84500E,
+        0x4834505D,0x755479ED,0x32F4033D,0x0F942A8D,0xBDB4F69D,0x80D4DF2D,0xC774A5FD,0xFA148C4D,0x78441B9C,0x4524322C,0x028448FC,0x3FE4614C,0x8DC4BD5C,0xB0A494EC,0xF704EE3C,0xCA64C78C,
+    },
+    {
+        0x00000000,0xCB5CD3A5,0x4DC8A10B,0x869472AE,0x9B914216,0x50CD91B3,0xD659E31D,0x1D0530B8,0xEC53826D,0x270F51C8,0xA19B2366,0x6AC7F0C3,0x77C2C07B,0xBC9E13DE,0x3A0A6170,0xF156B2D5,
+        0x03D6029B,0xC88AD13E,0x4E1EA390,0x85427035,0x9847408D,0x531B9328,0xD58FE186,0x1ED33223,0xEF8580F6,0x24D95353,0xA24D21FD,0x6911F258,0x7414C2E0,0xBF481145,0x39DC63EB,0xF280B04E,
+        0x07AC0536,0xCCF0D693,0x4A64A43D,0x81387798,0x9C3D4720,0x57619485,0xD1F5E62B,0x1AA9358E,0xEBFF875B,0x20A354FE,0xA6372650,0x6D6BF5F5,0x706EC54D,0xBB3216E8,0x3DA66446,0xF6FAB7E3,
+        0x047A07AD,0xCF26D408,0x49B2A6A6,0x82EE7503,0x9FEB45BB,0x54B7961E,0xD223E4B0,0x197F3715,0xE82985C0,0x23755665,0xA5E124CB,0x6EBDF76E,0x73B8C7D6,0xB8E41473,0x3E7066DD,0xF52CB578,
+        0x0F580A6C,0xC404D9C9,0x4290AB67,0x89CC78C2,0x94C9487A,0x5F959BDF,0xD901E971,0x125D3AD4,0xE30B8801,0x28575BA4,0xAEC3290A,0x659FFAAF,0x789ACA17,0xB3C619B2,0x35526B1C,0xFE0EB8B9,
+        0x0C8E08F7,0xC7D2DB52,0x4146A9FC,0x8A1A7A59,0x971F4AE1,0x5C439944,0xDAD7EBEA,0x118B384F,0xE0DD8A9A,0x2B81593F,0xAD152B91,0x6649F834,0x7B4CC88C,0xB0101B29,0x36846987,0xFDD8BA22,
+        0x08F40F5A,0xC3A8DCFF,0x453CAE51,0x8E607DF4,0x93654D4C,0x58399EE9,0xDEADEC47,0x15F13FE2,0xE4A78D37,0x2FFB5E92,0xA96F2C3C,0x6233FF99,0x7F36CF21,0xB46A1C84,0x32FE6E2A,0xF9A2BD8F,
+        0x0B220DC1,0xC07EDE64,0x46EAACCA,0x8DB67F6F,0x90B34FD7,0x5BEF9C72,0xDD7BEEDC,0x16273D79,0xE7718FAC,0x2C2D5C09,0xAAB92EA7,0x61E5FD02,0x7CE0CDBA,0xB7BC1E1F,0x31286CB1,0xFA74BF14,
+        0x1EB014D8,0xD5ECC77D,0x5378B5D3,0x98246676,0x852156CE,0x4E7D856B,0xC8E9F7C5,0x03B52460,0xF2E396B5,0x39BF4510,0xBF2B37BE,0x7477E41B,0x6972D4A3,0xA22E0706,0x24BA75A8,0xEFE6A60D,
+        0x1D661643,0xD63AC5E6,0x50AEB748,0x9BF264ED,0x86F75455,0x4DAB87F0,0xCB3FF55E,0x006326FB,0xF135942E,0x3A69478B,0xBCFD3525,0x77A1E680,0x6AA4D638,0xA1F8059D,0x276C7733,0xEC30A496,
+        0x191C11EE,0xD240C24B,0x54D4B0E5,0x9F886340,0x828D53F8,0x49D1805D,0xCF45F2F3,0x04192156,0xF54F9383,0x3E134026,0xB8873288,0x73DBE12D,0x6EDED195,0xA5820230,0x2316709E,0xE84AA33B,
+        0x1ACA1375,0xD196C0D0,0x5702B27E,0x9C5E61DB,0x815B5163,0x4A0782C6,0xCC93F068,0x07CF23CD,0xF6999118,0x3DC542BD,0xBB513013,0x700DE3B6,0x6D08D30E,0xA65400AB,0x20C07205,0xEB9CA1A0,
+        0x11E81EB4,0xDAB4CD11,0x5C20BFBF,0x977C6C1A,0x8A795CA2,0x41258F07,0xC7B1FDA9,0x0CED2E0C,0xFDBB9CD9,0x36E74F7C,0xB0733DD2,0x7B2FEE77,0x662ADECF,0xAD760D6A,0x2BE27FC4,0xE0BEAC61,
+        0x123E1C2F,0xD962CF8A,0x5FF6BD24,0x94AA6E81,0x89AF5E39,0x42F38D9C,0xC467FF32,0x0F3B2C97,0xFE6D9E42,0x35314DE7,0xB3A53F49,0x78F9ECEC,0x65FCDC54,0xAEA00FF1,0x28347D5F,0xE368AEFA,
+        0x16441B82,0xDD18C827,0x5B8CBA89,0x90D0692C,0x8DD55994,0x46898A31,0xC01DF89F,0x0B412B3A,0xFA1799EF,0x314B4A4A,0xB7DF38E4,0x7C83EB41,0x6186DBF9,0xAADA085C,0x2C4E7AF2,0xE712A957,
+        0x15921919,0xDECECABC,0x585AB812,0x93066BB7,0x8E035B0F,0x455F88AA,0xC3CBFA04,0x089729A1,0xF9C19B74,0x329D48D1,0xB4093A7F,0x7F55E9DA,0x6250D962,0xA90C0AC7,0x2F987869,0xE4C4ABCC,
+    },
+    {
+        0x00000000,0xA6770BB4,0x979F1129,0x31E81A9D,0xF44F2413,0x52382FA7,0x63D0353A,0xC5A73E8E,0x33EF4E67,0x959845D3,0xA4705F4E,0x020754FA,0xC7A06A74,0x61D761C0,0x503F7B5D,0xF64870E9,
+        0x67DE9CCE,0xC1A9977A,0xF0418DE7,0x56368653,0x9391B8DD,0x35E6B369,0x040EA9F4,0xA279A240,0x5431D2A9,0xF246D91D,0xC3AEC380,0x65D9C834,0xA07EF6BA,0x0609FD0E,0x37E1E793,0x9196EC27,
+        0xCFBD399C,0x69CA3228,0x582228B5,0xFE552301,0x3BF21D8F,0x9D85163B,0xAC6D0CA6,0x0A1A0712,0xFC5277FB,0x5A257C4F,0x6BCD66D2,0xCDBA6D66,0x081D53E8,0xAE6A585C,0x9F8242C1,0x39F54975,
+        0xA863A552,0x0E14AEE6,0x3FFCB47B,0x998BBFCF,0x5C2C8141,0xFA5B8AF5,0xCBB39068,0x6DC49BDC,0x9B8CEB35,0x3DFBE081,0x0C13FA1C,0xAA64F1A8,0x6FC3CF26,0xC9B4C492,0xF85CDE0F,0x5E2BD5BB,
+        0x440B7579,0xE27C7ECD,0xD3946450,0x75E36FE4,0xB044516A,0x16335ADE,0x27DB4043,0x81AC4BF7,0x77E43B1E,0xD19330AA,0xE07B2A37,0x460C2183,0x83AB1F0D,0x25DC14B9,0x14340E24,0xB2430590,
+        0x23D5E9B7,0x85A2E203,0xB44AF89E,0x123DF32A,0xD79ACDA4,0x71EDC610,0x4005DC8D,0xE672D739,0x103AA7D0,0xB64DAC64,0x87A5B6F9,0x21D2BD4D,0xE47583C3,0x42028877,0x73EA92EA,0xD59D995E,
+        0x8BB64CE5,0x2DC14751,0x1C295DCC,0xBA5E5678,0x7FF968F6,0xD98E6342,0xE86679DF,0x4E11726B,0xB8590282,0x1E2E0936,0x2FC613AB,0x89B1181F,0x4C162691,0xEA612D25,0xDB8937B8,0x7DFE3C0C,
+        0xEC68D02B,0x4A1FDB9F,0x7BF7C102,0xDD80CAB6,0x1827F438,0xBE50FF8C,0x8FB8E511,0x29CFEEA5,0xDF879E4C,0x79F095F8,0x48188F65,0xEE6F84D1,0x2BC8BA5F,0x8DBFB1EB,0xBC57AB76,0x1A20A0C2,
+        0x8816EAF2,0x2E61E146,0x1F89FBDB,0xB9FEF06F,0x7C59CEE1,0xDA2EC555,0xEBC6DFC8,0x4DB1D47C,0xBBF9A495,0x1D8EAF21,0x2C66B5BC,0x8A11BE08,0x4FB68086,0xE9C18B32,0xD82991AF,0x7E5E9A1B,
+        0xEFC8763C,0x49BF7D88,0x78576715,0xDE206CA1,0x1B87522F,0xBDF0599B,0x8C184306,0x2A6F48B2,0xDC27385B,0x7A5033EF,0x4BB82972,0xEDCF22C6,0x28681C48,0x8E1F17FC,0xBFF70D61,0x198006D5,
+        0x47ABD36E,0xE1DCD8DA,0xD034C247,0x7643C9F3,0xB3E4F77D,0x1593FCC9,0x247BE654,0x820CEDE0,0x74449D09,0xD23396BD,0xE3DB8C20,0x45AC8794,0x800BB91A,0x267CB2AE,0x1794A833,0xB1E3A387,
+        0x20754FA0,0x86024414,0xB7EA5E89,0x119D553D,0xD43A6BB3,0x724D6007,0x43A57A9A,0xE5D2712E,0x139A01C7,0xB5ED0A73,0x840510EE,0x22721B5A,0xE7D525D4,0x41A22E60,0x704A34FD,0xD63D3F49,
+        0xCC1D9F8B,0x6A6A943F,0x5B828EA2,0xFDF58516,0x3852BB98,0x9E25B02C,0xAFCDAAB1,0x09BAA105,0xFFF2D1EC,0x5985DA58,0x686DC0C5,0xCE1ACB71,0x0BBDF5FF,0xADCAFE4B,0x9C22E4D6,0x3A55EF62,
+        0xABC30345,0x0DB408F1,0x3C5C126C,0x9A2B19D8,0x5F8C2756,0xF9FB2CE2,0xC813367F,0x6E643DCB,0x982C4D22,0x3E5B4696,0x0FB35C0B,0xA9C457BF,0x6C636931,0xCA146285,0xFBFC7818,0x5D8B73AC,
+        0x03A0A617,0xA5D7ADA3,0x943FB73E,0x3248BC8A,0xF7EF8204,0x519889B0,0x6070932D,0xC6079899,0x304FE870,0x9638E3C4,0xA7D0F959,0x01A7F2ED,0xC400CC63,0x6277C7D7,0x539FDD4A,0xF5E8D6FE,
+        0x647E3AD9,0xC209316D,0xF3E12BF0,0x55962044,0x90311ECA,0x3646157E,0x07AE0FE3,0xA1D90457,0x579174BE,0xF1E67F0A,0xC00E6597,0x66796E23,0xA3DE50AD,0x05A95B19,0x34414184,0x92364A30,
+    },
+    {
+        0x00000000,0xCCAA009E,0x4225077D,0x8E8F07E3,0x844A0EFA,0x48E00E64,0xC66F0987,0x0AC50919,0xD3E51BB5,0x1F4F1B2B,0x91C01CC8,0x5D6A1C56,0x57AF154F,0x9B0515D1,0x158A1232,0xD92012AC,
+        0x7CBB312B,0xB01131B5,0x3E9E3656,0xF23436C8,0xF8F13FD1,0x345B3F4F,0xBAD438AC,0x767E3832,0xAF5E2A9E,0x63F42A00,0xED7B2DE3,0x21D12D7D,0x2B142464,0xE7BE24FA,0x69312319,0xA59B2387,
+        0xF9766256,0x35DC62C8,0xBB53652B,0x77F965B5,0x7D3C6CAC,0xB1966C32,0x3F196BD1,0xF3B36B4F,0x2A9379E3,0xE639797D,0x68B67E9E,0xA41C7E00,0xAED97719,0x62737787,0xECFC7064,0x205670FA,
+        0x85CD537D,0x496753E3,0xC7E85400,0x0B42549E,0x01875D87,0xCD2D5D19,0x43A25AFA,0x8F085A64,0x562848C8,0x9A824856,0x140D4FB5,0xD8A74F2B,0xD2624632,0x1EC846AC,0x9047414F,0x5CED41D1,
+        0x299DC2ED,0xE537C273,0x6BB8C590,0xA712C50E,0xADD7CC17,0x617DCC89,0xEFF2CB6A,0x2358CBF4,0xFA78D958,0x36D2D9C6,0xB85DDE25,0x74F7DEBB,0x7E32D7A2,0xB298D73C,0x3C17D0DF,0xF0BDD041,
+        0x5526F3C6,0x998CF358,0x1703F4BB,0xDBA9F425,0xD16CFD3C,0x1DC6FDA2,0x9349FA41,0x5FE3FADF,0x86C3E873,0x4A69E8ED,0xC4E6EF0E,0x084CEF90,0x0289E689,0xCE23E617,0x40ACE1F4,0x8C06E16A,
+        0xD0EBA0BB,0x1C41A025,0x92CEA7C6,0x5E64A758,0x54A1AE41,0x980BAEDF,0x1684A93C,0xDA2EA9A2,0x030EBB0E,0xCFA4BB90,0x412BBC73,0x8D81BCED,0x8744B5F4,0x4BEEB56A,0xC561B289,0x09CBB217,
+        0xAC509190,0x60FA910E,0xEE7596ED,0x22DF9673,0x281A9F6A,0xE4B09FF4,0x6A3F9817,0xA6959889,0x7FB58A25,0xB31F8ABB,0x3D908D58,0xF13A8DC6,0xFBFF84DF,0x37558441,0xB9DA83A2,0x7570833C,
+        0x533B85DA,0x9F918544,0x111E82A7,0xDDB48239,0xD7718B20,0x1BDB8BBE,0x95548C5D,0x59FE8CC3,0x80DE9E6F,0x4C749EF1,0xC2FB9912,0x0E51998C,0x04949095,0xC83E900B,0x46B197E8,0x8A1B9776,
+        0x2F80B4F1,0xE32AB46F,0x6DA5B38C,0xA10FB312,0xABCABA0B,0x6760BA95,0xE9EFBD76,0x2545BDE8,0xFC65AF44,0x30CFAFDA,0xBE40A839,0x72EAA8A7,0x782FA1BE,0xB485A120,0x3A0AA6C3,0xF6A0A65D,
+        0xAA4DE78C,0x66E7E712,0xE868E0F1,0x24C2E06F,0x2E07E976,0xE2ADE9E8,0x6C22EE0B,0xA088EE95,0x79A8FC39,0xB502FCA7,0x3B8DFB44,0xF727FBDA,0xFDE2F2C3,0x3148F25D,0xBFC7F5BE,0x736DF520,
+        0xD6F6D6A7,0x1A5CD639,0x94D3D1DA,0x5879D144,0x52BCD85D,0x9E16D8C3,0x1099DF20,0xDC33DFBE,0x0513CD12,0xC9B9CD8C,0x4736CA6F,0x8B9CCAF1,0x8159C3E8,0x4DF3C376,0xC37CC495,0x0FD6C40B,
+        0x7AA64737,0xB60C47A9,0x3883404A,0xF42940D4,0xFEEC49CD,0x32464953,0xBCC94EB0,0x70634E2E,0xA9435C82,0x65E95C1C,0xEB665BFF,0x27CC5B61,0x2D095278,0xE1A352E6,0x6F2C5505,0xA386559B,
+        0x061D761C,0xCAB77682,0x44387161,0x889271FF,0x825778E6,0x4EFD7878,0xC0727F9B,0x0CD87F05,0xD5F86DA9,0x19526D37,0x97DD6AD4,0x5B776A4A,0x51B26353,0x9D1863CD,0x1397642E,0xDF3D64B0,
+        0x83D02561,0x4F7A25FF,0xC1F5221C,0x0D5F2282,0x079A2B9B,0xCB302B05,0x45BF2CE6,0x89152C78,0x50353ED4,0x9C9F3E4A,0x121039A9,0xDEBA3937,0xD47F302E,0x18D530B0,0x965A3753,0x5AF037CD,
+        0xFF6B144A,0x33C114D4,0xBD4E1337,0x71E413A9,0x7B211AB0,0xB78B1A2E,0x39041DCD,0xF5AE1D53,0x2C8E0FFF,0xE0240F61,0x6EAB0882,0xA201081C,0xA8C40105,0x646E019B,0xEAE10678,0x264B06E6,
+    },
 };
 
+// ARMv8 CRC32 instructions compute the same CRC32 (polynomial 0xEDB88320) as our tables.
+// x86 SSE4.2 _mm_crc32_u64() is not used: it computes CRC32-C (polynomial 0x82F63B78), which would change every ID and break .ini files.
+#if (defined(__ARM_FEATURE_CRC32) || (defined(_MSC_VER) && defined(_M_ARM64))) && !defined(IMGUI_DISABLE_CRC32_INTRINSICS)
+#define IMGUI_ENABLE_ARM_CRC32
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <arm_acle.h>
+#endif
+#endif
+
+// Slicing-by-8 loads 32-bit words in memory order, which needs a little-endian CPU
+#if defined(_WIN32) || defined(__x86_64__) || defined(__i386__) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define IMGUI_CRC32_LITTLE_ENDIAN
+#endif
+
+// Feed 'data_size' bytes to a running 'crc' (inverted state, i.e. starting from ~seed)
+static inline ImU32 ImCrc32Update(ImU32 crc, const unsigned char* data, size_t data_size)
+{
+#if defined(IMGUI_ENABLE_ARM_CRC32)
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        ImU64 v;
+        memcpy(&v, data, 8);
+        crc = __crc32d(crc, v);
+    }
+    while (data_size-- != 0)
+        crc = __crc32b(crc, *data++);
+#else
+    const ImU32 (*crc32_lut)[256] = GCrc32LookupTable;
+#ifdef IMGUI_CRC32_LITTLE_ENDIAN
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        ImU32 lo, hi;
+        memcpy(&lo, data, 4);
+        memcpy(&hi, data + 4, 4);
+        lo ^= crc;
+        crc = crc32_lut[7][lo & 0xFF] ^ crc32_lut[6][(lo >> 8) & 0xFF] ^ crc32_lut[5][(lo >> 16) & 0xFF] ^ crc32_lut[4][lo >> 24] ^
+              crc32_lut[3][hi & 0xFF] ^ crc32_lut[2][(hi >> 8) & 0xFF] ^ crc32_lut[1][(hi >> 16) & 0xFF] ^ crc32_lut[0][hi >> 24];
+    }
+#endif
+    while (data_size-- != 0)
+        crc = (crc >> 8) ^ crc32_lut[0][(crc & 0xFF) ^ *data++];
+#endif
+    return crc;
+}
+
 // Known size hash
 // It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
 ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
 {
-    ImU32 crc = ~seed;
-    const unsigned char* data = (const unsigned char*)data_p;
-    const ImU32* crc32_lut = GCrc32LookupTable;
-    while (data_size-- != 0)
-        crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
-    return ~crc;
+    return ~ImCrc32Update(~seed, (const unsigned char*)data_p, data_size);
 }
 
 // Zero-terminated string hash, with support for ### to reset back to seed value
 // We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
 // Because this syntax is rarely used we are optimizing for the common case.
 // - If we reach ### in the string we discard the hash so far and reset to the seed.
-// - We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// - The first 16 bytes are hashed one at a time, most labels end there.
+// - For longer strings only the last ### of the rest matters, it is located first and the hash then runs 8 bytes at a time from there.
+// Kept out of line so that the common short string path stays small. 'data_size' == 0: zero-terminated.
+#if defined(_MSC_VER)
+__declspec(noinline)
+#elif defined(__GNUC__)
+__attribute__((noinline))
+#endif
+static ImGuiID ImHashStrTail(ImU32 crc, ImU32 seed, const unsigned char* data, size_t data_size)
+{
+    if (data_size == 0)
+        data_size = strlen((const char*)data);
+    if (data_size >= 3)
+        if (const void* first = memchr(data, '#', data_size))
+            for (size_t n = data_size - 3; n + 1 > (size_t)((const unsigned char*)first - data); n--)
+                if (data[n] == '#' && data[n + 1] == '#' && data[n + 2] == '#')
+                {
+                    crc = seed;
+                    data += n;
+                    data_size -= n;
+                    break;
+                }
+    return ~ImCrc32Update(crc, data, data_size);
+}
+
 ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
 {
     seed = ~seed;
     ImU32 crc = seed;
     const unsigned char* data = (const unsigned char*)data_p;
-    const ImU32* crc32_lut = GCrc32LookupTable;
+    const ImU32* crc32_lut = GCrc32LookupTable[0];
     if (data_size != 0)
     {
-        while (data_size-- != 0)
+        for (int head = 16; data_size != 0; data_size--)
         {
+            if (head-- == 0)
+                return ImHashStrTail(crc, seed, data, data_size);
             unsigned char c = *data++;
-            if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
+            if (c == '#' && data_size >= 3 && data[0] == '#' && data[1] == '#')
                 crc = seed;
             crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
         }
     }
     else
     {
-        while (unsigned char c = *data++)
+        for (int head = 16; ; head--)
         {
+            if (head == 0)
+                return ImHashStrTail(crc, seed, data, 0);
+            unsigned char c = *data++;
+            if (c == 0)
+                break;
             if (c == '#' && data[0] == '#' && data[1] == '#')
                 crc = seed;
             crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
@@ -2377,6 +2588,141 @@ static ImGuiStorage::ImGuiStoragePair* LowerBound(ImVector<ImGuiStorage::ImGuiSt
     return first;
 }
 
+// Hashed mode: slots are probed 16 at a time, comparing 7 bits of the hash of all slots of a group at once.
+// Pairs are never removed individually so there are no tombstones, the first empty slot ends a probe sequence.
+#if defined(IMGUI_ENABLE_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define IMGUI_STORAGE_SSE2
+#endif
+static const ImU8 ImGuiStorageHashEmpty = 0x80;
+
+static inline ImU32 StorageHash(ImGuiID key)
+{
+    // Keys are already hashes but not always well distributed ones (e.g. sequential integers), mix them once more.
+    ImU32 h = key * 0x9E3779B1u;
+    return h ^ (h >> 15);
+}
+
+// Bitmasks of the slots of a 16-slot group whose control byte equals 'value'
+static inline ImU32 StorageMatchGroup(const ImU8* ctrl, ImU8 value)
+{
+#ifdef IMGUI_STORAGE_SSE2
+    __m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+    return (ImU32)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)value)));
+#else
+    ImU32 mask = 0;
+    for (int n = 0; n < 16; n++)
+        mask |= (ctrl[n] == value) ? (1u << n) : 0u;
+    return mask;
+#endif
+}
+
+static inline int StorageLowestBit(ImU32 mask)
+{
+    int n = 0;
+    while ((mask & 1) == 0)
+        mask >>= 1, n++;
+    return n;
+}
+
+// Return index into Data of 'key', or -1 with 'out_slot' set to the slot where it would be inserted
+static int StorageHashFind(const ImGuiStorage* storage, ImGuiID key, int* out_slot)
+{
+    const ImU32 hash = StorageHash(key);
+    const ImU8 h2 = (ImU8)(hash & 0x7F);
+    const ImU32 group_mask = (ImU32)(storage->HashCtrl.Size / 16) - 1;
+    ImU32 group = (hash >> 7) & group_mask;
+    for (ImU32 step = 1; ; step++)
+    {
+        const ImU8* ctrl = storage->HashCtrl.Data + group * 16;
+        for (ImU32 match = StorageMatchGroup(ctrl, h2); match != 0; match &= match - 1)
+        {
+            const int slot = (int)(group * 16) + StorageLowestBit(match);
+            const int index = storage->HashSlots.Data[slot];
+            if (storage->Data.Data[index].key == key)
+                return index;
+        }
+        if (ImU32 empty = StorageMatchGroup(ctrl, ImGuiStorageHashEmpty))
+        {
+            *out_slot = (int)(group * 16) + StorageLowestBit(empty);
+            return -1;
+        }
+        group = (group + step) & group_mask; // Triangular probing visits every group when their count is a power of two
+    }
+}
+
+// Index all of Data into a table of 'capacity' slots (power of two, >= 16)
+static void StorageHashRebuild(ImGuiStorage* storage, int capacity)
+{
+    storage->HashCtrl.resize(capacity);
+    storage->HashSlots.resize(capacity);
+    memset(storage->HashCtrl.Data, ImGuiStorageHashEmpty, (size_t)capacity);
+    for (int index = 0; index < storage->Data.Size; index++)
+    {
+        int slot;
+        if (StorageHashFind(storage, storage->Data.Data[index].key, &slot) >= 0)
+            continue; // Duplicate key, only possible with pairs pushed directly into Data. First one wins like a lookup would in sorted mode.
+        storage->HashCtrl.Data[slot] = (ImU8)(StorageHash(storage->Data.Data[index].key) & 0x7F);
+        storage->HashSlots.Data[slot] = index;
+    }
+}
+
+static ImGuiStorage::ImGuiStoragePair* StorageFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    if (storage->HashCtrl.Size > 0)
+    {
+        int slot;
+        const int index = StorageHashFind(storage, key, &slot);
+        return (index >= 0) ? &storage->Data.Data[index] : NULL;
+    }
+    ImGuiStorage::ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStorage::ImGuiStoragePair>&>(storage->Data), key);
+    return (it != storage->Data.end() && it->key == key) ? it : NULL;
+}
+
+// Return existing pair of 'pair.key', or add 'pair'
+static ImGuiStorage::ImGuiStoragePair* StorageFindOrAdd(ImGuiStorage* storage, const ImGuiStorage::ImGuiStoragePair& pair)
+{
+    if (storage->HashCtrl.Size > 0)
+    {
+        int slot;
+        const int index = StorageHashFind(storage, pair.key, &slot);
+        if (index >= 0)
+            return &storage->Data.Data[index];
+
+        // Keep load under 7/8 so that probe sequences stay short
+        if ((storage->Data.Size + 1) * 8 > storage->HashCtrl.Size * 7)
+        {
+            StorageHashRebuild(storage, storage->HashCtrl.Size * 2);
+            StorageHashFind(storage, pair.key, &slot);
+        }
+        storage->HashCtrl.Data[slot] = (ImU8)(StorageHash(pair.key) & 0x7F);
+        storage->HashSlots.Data[slot] = storage->Data.Size;
+        storage->Data.push_back(pair);
+        return &storage->Data.back();
+    }
+    ImGuiStorage::ImGuiStoragePair* it = LowerBound(storage->Data, pair.key);
+    if (it == storage->Data.end() || it->key != pair.key)
+        it = storage->Data.insert(it, pair);
+    return it;
+}
+
+// Switching back to sorted mode sorts Data
+void ImGuiStorage::SetHashed(bool hashed)
+{
+    if (hashed == IsHashed())
+        return;
+    if (!hashed)
+    {
+        HashCtrl.clear();
+        HashSlots.clear();
+        BuildSortByKey();
+        return;
+    }
+    int capacity = 16;
+    while (Data.Size * 8 > capacity * 7)
+        capacity *= 2;
+    StorageHashRebuild(this, capacity);
+}
+
 // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
 void ImGuiStorage::BuildSortByKey()
 {
@@ -2391,14 +2737,19 @@ void ImGuiStorage::BuildSortByKey()
         }
     };
     ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), StaticFunc::PairComparerByID);
+    if (IsHashed())
+    {
+        int capacity = HashCtrl.Size;
+        while (Data.Size * 8 > capacity * 7)
+            capacity *= 2;
+        StorageHashRebuild(this, capacity);
+    }
 }
 
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_i;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_i : default_val;
 }
 
 bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
@@ -2408,27 +2759,20 @@ bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
 
 float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_f;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_f : default_val;
 }
 
 void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return NULL;
-    return it->val_p;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_p : NULL;
 }
 
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_i;
+    return &StorageFindOrAdd(this, ImGuiStoragePair(key, default_val))->val_i;
 }
 
 bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
@@ -2438,30 +2782,18 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_f;
+    return &StorageFindOrAdd(this, ImGuiStoragePair(key, default_val))->val_f;
 }
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_p;
+    return &StorageFindOrAdd(this, ImGuiStoragePair(key, default_val))->val_p;
 }
 
 // FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_i = val;
+    StorageFindOrAdd(this, ImGuiStoragePair(key, val))->val_i = val;
 }
 
 void ImGuiStorage::SetBool(ImGuiID key, bool val)
@@ -2471,24 +2803,12 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_f = val;
+    StorageFindOrAdd(this, ImGuiStoragePair(key, val))->val_f = val;
 }
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_p = val;
+    StorageFindOrAdd(this, ImGuiStoragePair(key, val))->val_p = val;
 }
 
 void ImGuiStorage::SetAllInt(int v)
@@ -3621,6 +3941,8 @@ void ImGui::Initialize()
     DockContextInitialize(&g);
 #endif
 
+    g.WindowHandleSerial = ++GWindowHandleSerial;
+    g.WindowsHitGrid.CellMap.SetHashed(true);
     g.Initialized = true;
 }
 
@@ -3655,8 +3977,15 @@ void ImGui::Shutdown()
 
     // Clear everything else
     g.Windows.clear_delete();
+    g.WindowHandleSerial = 0;
+    g.WindowsHitGrid.CellMap.Clear();
+    g.WindowsHitGrid.Cells.clear_destruct();
+    g.WindowsHitGrid.CellsUsedCount = 0;
+    g.WindowsHitGrid.Oversized.clear();
+    g.WindowsHitGrid.Candidates.clear();
     g.WindowsFocusOrder.clear();
     g.WindowsTempSortBuffer.clear();
+    g.WindowsTempOccluders.clear();
     g.CurrentWindow = NULL;
     g.CurrentWindowStack.clear();
     g.WindowsById.Clear();
@@ -3856,6 +4185,7 @@ void ImGui::GcCompactTransientWindowBuffers(ImGuiWindow* window)
     window->DC.ChildWindows.clear();
     window->DC.ItemWidthStack.clear();
     window->DC.TextWrapPosStack.clear();
+    WindowHitGridRemove(window); // Stored again by Begin()
 }
 
 void ImGui::GcAwakeTransientWindowBuffers(ImGuiWindow* window)
@@ -4478,6 +4808,8 @@ static void TranslateWindow(ImGuiWindow* window, const ImVec2& delta)
     window->Pos += delta;
     window->ClipRect.Translate(delta);
     window->OuterRectClipped.Translate(delta);
+    if (window->HitGridState != 0) // Compacted windows are stored again by Begin()
+        WindowHitGridUpdate(window);
     window->InnerRect.Translate(delta);
     window->DC.CursorPos += delta;
     window->DC.CursorStartPos += delta;
@@ -4603,6 +4935,8 @@ void ImGui::NewFrame()
     g.FrameCount += 1;
     g.TooltipOverrideCount = 0;
     g.WindowsActiveCount = 0;
+    g.WindowsCulledCount = 0;
+    g.WindowsSortActivatedCount = g.WindowsSortChildCount = 0;
     g.MenusIdSubmittedThisFrame.resize(0);
 
     // Calculate frame-rate for the user, as a purely luxurious feature
@@ -4639,6 +4973,10 @@ void ImGui::NewFrame()
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
     if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowVtxOffset;
+    if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasInstancing)
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowInstancing;
+    if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasExternalGeometry)
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowExternalGeometry;
 
     // Mark rendering data as invalid to prevent user who may have a handle on it to use it.
     for (int n = 0; n < g.Viewports.Size; n++)
@@ -4805,6 +5143,10 @@ void ImGui::NewFrame()
     for (int i = 0; i < g.TablesTempData.Size; i++)
         if (g.TablesTempData[i].LastTimeActive >= 0.0f && g.TablesTempData[i].LastTimeActive < memory_compact_start_time)
             TableGcCompactTransientBuffers(&g.TablesTempData[i]);
+
+    // Garbage collect hit grid cells left empty by moved or compacted windows
+    if (g.GcCompactAll || (g.WindowsHitGrid.Cells.Size > WINDOWS_HIT_GRID_COMPACT_MIN_CELLS && g.WindowsHitGrid.CellsUsedCount * 4 < g.WindowsHitGrid.Cells.Size))
+        WindowHitGridCompact();
     if (g.GcCompactAll)
         GcCompactTransientMiscBuffers();
     g.GcCompactAll = false;
@@ -4813,6 +5155,9 @@ void ImGui::NewFrame()
     if (g.NavWindow && !g.NavWindow->WasActive)
         FocusTopMostWindowUnderOne(NULL, NULL, NULL, ImGuiFocusRequestFlags_RestoreFocusedChild);
 
+    // Find windows covered by opaque windows in front of them (using last frame's rectangles and display order)
+    UpdateWindowsOcclusionCulling();
+
     // No window should be open at the beginning of the frame.
     // But in order to allow the user to call NewFrame() multiple times without calling Render(), we are doing an explicit clear.
     g.CurrentWindowStack.resize(0);
@@ -4865,13 +5210,24 @@ static int IMGUI_CDECL ChildWindowComparer(const void* lhs, const void* rhs)
     return (a->BeginOrderWithinParent - b->BeginOrderWithinParent);
 }
 
+static bool IsChildWindowListSorted(const ImVector<ImGuiWindow*>& child_windows)
+{
+    // Children are submitted in BeginOrderWithinParent order, so only popups/tooltips submitted before a regular child require sorting
+    for (int i = 1; i < child_windows.Size; i++)
+        if (ChildWindowComparer(&child_windows.Data[i - 1], &child_windows.Data[i]) > 0)
+            return false;
+    return true;
+}
+
 static void AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, ImGuiWindow* window)
 {
+    const int subtree_start = out_sorted_windows->Size;
     out_sorted_windows->push_back(window);
     if (window->Active)
     {
         int count = window->DC.ChildWindows.Size;
-        ImQsort(window->DC.ChildWindows.Data, (size_t)count, sizeof(ImGuiWindow*), ChildWindowComparer);
+        if (!IsChildWindowListSorted(window->DC.ChildWindows))
+            ImQsort(window->DC.ChildWindows.Data, (size_t)count, sizeof(ImGuiWindow*), ChildWindowComparer);
         for (int i = 0; i < count; i++)
         {
             ImGuiWindow* child = window->DC.ChildWindows[i];
@@ -4879,19 +5235,21 @@ static void AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, Im
                 AddWindowToSortBuffer(out_sorted_windows, child);
         }
     }
+    window->DisplaySubtreeSize = out_sorted_windows->Size - subtree_start;
 }
 
 static void AddDrawListToDrawData(ImVector<ImDrawList*>* out_list, ImDrawList* draw_list)
 {
     if (draw_list->CmdBuffer.Size == 0)
         return;
-    if (draw_list->CmdBuffer.Size == 1 && draw_list->CmdBuffer[0].ElemCount == 0 && draw_list->CmdBuffer[0].UserCallback == NULL)
+    if (draw_list->CmdBuffer.Size == 1 && draw_list->CmdBuffer[0].ElemCount == 0 && draw_list->CmdBuffer[0].InstCount == 0 && draw_list->CmdBuffer[0].UserCallback == NULL)
         return;
 
     // Draw list sanity check. Detect mismatch between PrimReserve() calls and incrementing _VtxCurrentIdx, _VtxWritePtr etc.
     // May trigger for you if you are using PrimXXX functions incorrectly.
     IM_ASSERT(draw_list->VtxBuffer.Size == 0 || draw_list->_VtxWritePtr == draw_list->VtxBuffer.Data + draw_list->VtxBuffer.Size);
     IM_ASSERT(draw_list->IdxBuffer.Size == 0 || draw_list->_IdxWritePtr == draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size);
+    IM_ASSERT(draw_list->InstBuffer.Size == 0 || draw_list->_InstWritePtr == draw_list->InstBuffer.Data + draw_list->InstBuffer.Size);
     if (!(draw_list->Flags & ImDrawListFlags_AllowVtxOffset))
         IM_ASSERT((int)draw_list->_VtxCurrentIdx == draw_list->VtxBuffer.Size);
 
@@ -4976,7 +5334,7 @@ static void SetupViewportDrawData(ImGuiViewportP* viewport, ImVector<ImDrawList*
     draw_data->Valid = true;
     draw_data->CmdLists = (draw_lists->Size > 0) ? draw_lists->Data : NULL;
     draw_data->CmdListsCount = draw_lists->Size;
-    draw_data->TotalVtxCount = draw_data->TotalIdxCount = 0;
+    draw_data->TotalVtxCount = draw_data->TotalIdxCount = draw_data->TotalInstCount = 0;
     draw_data->DisplayPos = viewport->Pos;
     draw_data->DisplaySize = is_minimized ? ImVec2(0.0f, 0.0f) : viewport->Size;
     draw_data->FramebufferScale = io.DisplayFramebufferScale; // FIXME-VIEWPORT: This may vary on a per-monitor/viewport basis?
@@ -4987,6 +5345,7 @@ static void SetupViewportDrawData(ImGuiViewportP* viewport, ImVector<ImDrawList*
         draw_list->_PopUnusedDrawCmd();
         draw_data->TotalVtxCount += draw_list->VtxBuffer.Size;
         draw_data->TotalIdxCount += draw_list->IdxBuffer.Size;
+        draw_data->TotalInstCount += draw_list->InstBuffer.Size;
     }
 }
 
@@ -5169,8 +5528,14 @@ void ImGui::EndFrame()
 
     // Hide implicit/fallback "Debug" window if it hasn't been used
     g.WithinFrameScopeWithImplicitWindow = false;
+    int windows_deactivated_count = 0;
     if (g.CurrentWindow && !g.CurrentWindow->WriteAccessed)
+    {
         g.CurrentWindow->Active = false;
+        if (!g.CurrentWindow->WasActive)
+            g.WindowsSortActivatedCount--;
+        windows_deactivated_count++;
+    }
     End();
 
     // Update navigation: CTRL+Tab, wrap-around requests
@@ -5210,20 +5575,34 @@ void ImGui::EndFrame()
 
     // Sort the window list so that all child windows are after their parent
     // We cannot do that on FocusWindow() because children may not exist yet
-    g.WindowsTempSortBuffer.resize(0);
-    g.WindowsTempSortBuffer.reserve(g.Windows.Size);
-    for (int i = 0; i != g.Windows.Size; i++)
-    {
-        ImGuiWindow* window = g.Windows[i];
-        if (window->Active && (window->Flags & ImGuiWindowFlags_ChildWindow))       // if a child is active its parent will add it
-            continue;
-        AddWindowToSortBuffer(&g.WindowsTempSortBuffer, window);
-    }
+    // Skipped when g.Windows, the set of active windows and every list of child windows are the same as on the previous frame:
+    // a window not active on the previous frame increments WindowsSortActivatedCount, one that stopped being active or being a child changes the counts.
+    const int windows_active_count = g.WindowsActiveCount - windows_deactivated_count;
+    if (g.WindowsSortActivatedCount != 0 || windows_active_count != g.WindowsSortActiveCountPrev || g.WindowsSortChildCount != g.WindowsSortChildCountPrev)
+        g.WindowsSortDirty = true;
+    g.WindowsSortActiveCountPrev = windows_active_count;
+    g.WindowsSortChildCountPrev = g.WindowsSortChildCount;
+    if (g.WindowsSortDirty)
+    {
+        g.WindowsTempSortBuffer.resize(0);
+        g.WindowsTempSortBuffer.reserve(g.Windows.Size);
+        for (int i = 0; i != g.Windows.Size; i++)
+        {
+            ImGuiWindow* window = g.Windows[i];
+            if (window->Active && (window->Flags & ImGuiWindowFlags_ChildWindow))       // if a child is active its parent will add it
+                continue;
+            AddWindowToSortBuffer(&g.WindowsTempSortBuffer, window);
+        }
 
-    // This usually assert if there is a mismatch between the ImGuiWindowFlags_ChildWindow / ParentWindow values and DC.ChildWindows[] in parents, aka we've done something wrong.
-    IM_ASSERT(g.Windows.Size == g.WindowsTempSortBuffer.Size);
-    g.Windows.swap(g.WindowsTempSortBuffer);
+        // This usually assert if there is a mismatch between the ImGuiWindowFlags_ChildWindow / ParentWindow values and DC.ChildWindows[] in parents, aka we've done something wrong.
+        IM_ASSERT(g.Windows.Size == g.WindowsTempSortBuffer.Size);
+        if (memcmp(g.Windows.Data, g.WindowsTempSortBuffer.Data, (size_t)g.Windows.Size * sizeof(ImGuiWindow*)) != 0)
+            g.WindowsHitGrid.DisplayIndexDirty = true;
+        g.Windows.swap(g.WindowsTempSortBuffer);
+        g.WindowsSortDirty = false;
+    }
     g.IO.MetricsActiveWindows = g.WindowsActiveCount;
+    g.IO.MetricsCulledWindows = g.WindowsCulledCount;
 
     // Unlock font atlas
     g.IO.Fonts->Locked = false;
@@ -5285,7 +5664,7 @@ void ImGui::Render()
         RenderMouseCursor(g.IO.MousePos, g.Style.MouseCursorScale, g.MouseCursor, IM_COL32_WHITE, IM_COL32_BLACK, IM_COL32(0, 0, 0, 48));
 
     // Setup ImDrawData structures for end-user
-    g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = 0;
+    g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = g.IO.MetricsRenderInstances = 0;
     for (int n = 0; n < g.Viewports.Size; n++)
     {
         ImGuiViewportP* viewport = g.Viewports[n];
@@ -5299,6 +5678,7 @@ void ImGui::Render()
         ImDrawData* draw_data = viewport->DrawData;
         g.IO.MetricsRenderVertices += draw_data->TotalVtxCount;
         g.IO.MetricsRenderIndices += draw_data->TotalIdxCount;
+        g.IO.MetricsRenderInstances += draw_data->TotalInstCount;
     }
 
     CallContextHooks(&g, ImGuiContextHookType_RenderPost);
@@ -5336,6 +5716,100 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
 // FIXME: Note that we have an inconsequential lag here: OuterRectClipped is updated in Begin(), so windows moved programmatically
 // with SetWindowPos() and not SetNextWindowPos() will have that rectangle lagging by a frame at the time FindHoveredWindow() is
 // called, aka before the next Begin(). Moving window isn't affected.
+static int WindowHitGridCellCoord(float v)
+{
+    // Clamping keeps the mapping monotonic, so any rectangle containing a point still covers the point's cell
+    return (int)ImFloorSigned(ImClamp(v / WINDOWS_HIT_GRID_CELL_SIZE, -32768.0f, 32767.0f));
+}
+
+static ImGuiID WindowHitGridCellKey(int x, int y)
+{
+    return ((ImU32)(ImU16)y << 16) | (ImU32)(ImU16)x;
+}
+
+static void WindowHitGridRemove(ImGuiWindow* window)
+{
+    ImGuiWindowHitGrid& grid = GImGui->WindowsHitGrid;
+    if (window->HitGridState == 2)
+        grid.Oversized.find_erase_unsorted(window);
+    else if (window->HitGridState == 1)
+        for (int y = window->HitGridCellMin.y; y <= window->HitGridCellMax.y; y++)
+            for (int x = window->HitGridCellMin.x; x <= window->HitGridCellMax.x; x++)
+            {
+                ImVector<ImGuiWindow*>& cell = grid.Cells[grid.CellMap.GetInt(WindowHitGridCellKey(x, y)) - 1];
+                cell.find_erase_unsorted(window);
+                if (cell.Size == 0)
+                    grid.CellsUsedCount--;
+            }
+    window->HitGridState = 0;
+}
+
+// Store window in the cells covered by its hit-test rectangle. Called whenever OuterRectClipped changes.
+static void WindowHitGridUpdate(ImGuiWindow* window)
+{
+    ImGuiWindowHitGrid& grid = GImGui->WindowsHitGrid;
+    ImRect bb(window->OuterRectClipped);
+    bb.Expand(grid.Padding);
+    const ImVec2ih cell_min((short)WindowHitGridCellCoord(bb.Min.x), (short)WindowHitGridCellCoord(bb.Min.y));
+    const ImVec2ih cell_max((short)WindowHitGridCellCoord(bb.Max.x), (short)WindowHitGridCellCoord(bb.Max.y));
+    const bool oversized = ImMax(cell_max.x - cell_min.x + 1, 0) * ImMax(cell_max.y - cell_min.y + 1, 0) > WINDOWS_HIT_GRID_MAX_CELLS;
+    if (oversized && window->HitGridState == 2)
+        return;
+    if (!oversized && window->HitGridState == 1 && window->HitGridCellMin.x == cell_min.x && window->HitGridCellMin.y == cell_min.y && window->HitGridCellMax.x == cell_max.x && window->HitGridCellMax.y == cell_max.y)
+        return;
+
+    WindowHitGridRemove(window);
+    if (oversized)
+    {
+        grid.Oversized.push_back(window);
+        window->HitGridState = 2;
+        return;
+    }
+    for (int y = cell_min.y; y <= cell_max.y; y++)
+        for (int x = cell_min.x; x <= cell_max.x; x++)
+        {
+            int* cell_idx = grid.CellMap.GetIntRef(WindowHitGridCellKey(x, y), 0);
+            if (*cell_idx == 0)
+            {
+                grid.Cells.push_back(ImVector<ImGuiWindow*>());
+                *cell_idx = grid.Cells.Size;
+            }
+            ImVector<ImGuiWindow*>& cell = grid.Cells[*cell_idx - 1];
+            if (cell.Size == 0)
+                grid.CellsUsedCount++;
+            cell.push_back(window);
+        }
+    window->HitGridCellMin = cell_min;
+    window->HitGridCellMax = cell_max;
+    window->HitGridState = 1;
+}
+
+// Cells are kept when their windows leave, for the windows to come back cheaply. When few are still used, free them all and store the windows again.
+static void WindowHitGridCompact()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindowHitGrid& grid = g.WindowsHitGrid;
+    grid.CellMap.Clear();
+    grid.CellMap.SetHashed(false); // Also free the hash table, back to its smallest size
+    grid.CellMap.SetHashed(true);
+    grid.Cells.clear_destruct();
+    grid.CellsUsedCount = 0;
+    grid.Candidates.clear();
+    for (int i = 0; i < g.Windows.Size; i++)
+        if (g.Windows[i]->HitGridState == 1)
+        {
+            g.Windows[i]->HitGridState = 0;
+            WindowHitGridUpdate(g.Windows[i]);
+        }
+}
+
+static int IMGUI_CDECL WindowHitGridCandidateComparer(const void* lhs, const void* rhs)
+{
+    // Front to back
+    return (*(const ImGuiWindow* const*)rhs)->DisplayIndex - (*(const ImGuiWindow* const*)lhs)->DisplayIndex;
+}
+
+// Only the windows whose rectangle covers the mouse cell are tested, in the same front to back order as g.Windows.
 static void FindHoveredWindow()
 {
     ImGuiContext& g = *GImGui;
@@ -5352,9 +5826,42 @@ static void FindHoveredWindow()
 
     ImVec2 padding_regular = g.Style.TouchExtraPadding;
     ImVec2 padding_for_resize = g.IO.ConfigWindowsResizeFromEdges ? g.WindowsHoverPadding : padding_regular;
-    for (int i = g.Windows.Size - 1; i >= 0; i--)
+
+    // Grid rectangles use the largest padding, store them all again when it changes
+    ImGuiWindowHitGrid& grid = g.WindowsHitGrid;
+    const ImVec2 grid_padding = ImMax(padding_regular, g.WindowsHoverPadding);
+    if (grid.Padding.x != grid_padding.x || grid.Padding.y != grid_padding.y)
     {
-        ImGuiWindow* window = g.Windows[i];
+        grid.Padding = grid_padding;
+        for (int i = 0; i < g.Windows.Size; i++)
+            if (g.Windows[i]->HitGridState != 0)
+                WindowHitGridUpdate(g.Windows[i]);
+    }
+    if (grid.DisplayIndexDirty)
+    {
+        for (int i = 0; i < g.Windows.Size; i++)
+            g.Windows[i]->DisplayIndex = i;
+        grid.DisplayIndexDirty = false;
+    }
+
+    grid.Candidates.resize(0);
+    const ImVec2 mouse_pos = g.IO.MousePos;
+    if (mouse_pos.x == mouse_pos.x && mouse_pos.y == mouse_pos.y) // Not NaN
+        if (int cell_idx = grid.CellMap.GetInt(WindowHitGridCellKey(WindowHitGridCellCoord(mouse_pos.x), WindowHitGridCellCoord(mouse_pos.y))))
+        {
+            const ImVector<ImGuiWindow*>& cell = grid.Cells[cell_idx - 1];
+            grid.Candidates.reserve(cell.Size + grid.Oversized.Size);
+            grid.Candidates.resize(cell.Size);
+            memcpy(grid.Candidates.Data, cell.Data, (size_t)cell.Size * sizeof(ImGuiWindow*));
+        }
+    for (int i = 0; i < grid.Oversized.Size; i++)
+        grid.Candidates.push_back(grid.Oversized[i]);
+    if (grid.Candidates.Size > 1)
+        ImQsort(grid.Candidates.Data, (size_t)grid.Candidates.Size, sizeof(ImGuiWindow*), WindowHitGridCandidateComparer);
+
+    for (int i = 0; i < grid.Candidates.Size; i++)
+    {
+        ImGuiWindow* window = grid.Candidates[i];
         IM_MSVC_WARNING_SUPPRESS(28182); // [Static Analyzer] Dereferencing NULL pointer.
         if (!window->Active || window->Hidden)
             continue;
@@ -5370,7 +5877,7 @@ static void FindHoveredWindow()
             bb.Expand(padding_regular);
         else
             bb.Expand(padding_for_resize);
-        if (!bb.Contains(g.IO.MousePos))
+        if (!bb.Contains(mouse_pos))
             continue;
 
         // Support for one rectangular hole in any given window
@@ -5379,7 +5886,7 @@ static void FindHoveredWindow()
         {
             ImVec2 hole_pos(window->Pos.x + (float)window->HitTestHoleOffset.x, window->Pos.y + (float)window->HitTestHoleOffset.y);
             ImVec2 hole_size((float)window->HitTestHoleSize.x, (float)window->HitTestHoleSize.y);
-            if (ImRect(hole_pos, hole_pos + hole_size).Contains(g.IO.MousePos))
+            if (ImRect(hole_pos, hole_pos + hole_size).Contains(mouse_pos))
                 continue;
         }
 
@@ -5560,8 +6067,11 @@ bool ImGui::BeginChildEx(const char* name, ImGuiID id, const ImVec2& size_arg, b
     SetNextWindowSize(size);
 
     // Build up name. If you need to append to a same child from multiple location in the ID stack, use BeginChild(ImGuiID id) with a stable value.
+    // (no need when the window is already known from an ImGuiWindowHandle)
     const char* temp_window_name;
-    if (name)
+    if (g.NextWindowData.Flags & ImGuiNextWindowDataFlags_HasWindow)
+        temp_window_name = g.NextWindowData.Window->Name;
+    else if (name)
         ImFormatStringToTempBuffer(&temp_window_name, NULL, "%s/%s_%08X", parent_window->Name, name, id);
     else
         ImFormatStringToTempBuffer(&temp_window_name, NULL, "%s/%08X", parent_window->Name, id);
@@ -5605,6 +6115,26 @@ bool ImGui::BeginChild(ImGuiID id, const ImVec2& size_arg, bool border, ImGuiWin
     return BeginChildEx(NULL, id, size_arg, border, extra_flags);
 }
 
+// The child window depends on the parent ID stack: reuse the handle only when the stack top is the one it was resolved under.
+bool ImGui::BeginChild(ImGuiWindowHandle* handle, const char* str_id, const ImVec2& size_arg, bool border, ImGuiWindowFlags extra_flags)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* parent_window = g.CurrentWindow;
+    const ImGuiID seed = parent_window->IDStack.back();
+    if (handle->Serial == g.WindowHandleSerial && handle->Seed == seed && handle->Window->ParentWindow == parent_window)
+    {
+        g.NextWindowData.Flags |= ImGuiNextWindowDataFlags_HasWindow;
+        g.NextWindowData.Window = handle->Window;
+        return BeginChildEx(str_id, handle->Window->ChildId, size_arg, border, extra_flags);
+    }
+
+    bool ret = BeginChildEx(str_id, parent_window->GetID(str_id), size_arg, border, extra_flags);
+    handle->Window = g.CurrentWindow;
+    handle->Serial = g.WindowHandleSerial;
+    handle->Seed = seed;
+    return ret;
+}
+
 void ImGui::EndChild()
 {
     ImGuiContext& g = *GImGui;
@@ -5786,6 +6316,8 @@ static ImGuiWindow* CreateNewWindow(const char* name, ImGuiWindowFlags flags)
         g.Windows.push_front(window); // Quite slow but rare and only once
     else
         g.Windows.push_back(window);
+    g.WindowsHitGrid.DisplayIndexDirty = true;
+    g.WindowsSortDirty = true;
 
     return window;
 }
@@ -5835,6 +6367,78 @@ static ImVec2 CalcWindowSizeAfterConstraint(ImGuiWindow* window, const ImVec2& s
     return new_size;
 }
 
+// Flag windows that were entirely covered by opaque windows in front of them on the previous frame.
+// Begin() will set SkipItems on them, so their contents are not submitted while all their state is preserved.
+// - Occluders are not trusted while being moved or resized, as their rectangle of last frame is going to change.
+// - Occluders are only trusted once they covered the same area for 2 frames, and never when they are popups or modals.
+//   Windows behind an occluder vanishing this frame (closed, or not calling Begin() anymore) show without contents for one frame:
+//   this limits it to windows which were stable, rather than e.g. a modal being closed or a window shown for a single frame.
+// - Windows whose contents size is needed (auto-resizing, popups) or which are interacted with are never culled.
+// FIXME-OPT: O(N*M) with M the number of opaque windows in front. Good enough for typical window counts.
+void ImGui::UpdateWindowsOcclusionCulling()
+{
+    ImGuiContext& g = *GImGui;
+    const bool enabled = g.IO.ConfigWindowsOcclusionCulling && !g.LogEnabled;
+    for (int i = 0; i < g.Windows.Size; i++)
+    {
+        g.Windows[i]->OcclusionCulled = false;
+        if (!enabled)
+            g.Windows[i]->OccluderFrames = 0;
+    }
+    if (!enabled)
+        return;
+
+    ImGuiWindow* moving_root = g.MovingWindow ? g.MovingWindow->RootWindowDockTree : NULL;
+    ImGuiWindow* active_root = g.ActiveIdWindow ? g.ActiveIdWindow->RootWindowDockTree : NULL;
+    ImGuiWindow* nav_root = g.NavWindow ? g.NavWindow->RootWindowDockTree : NULL;
+    ImGuiWindow* windowing_root = g.NavWindowingTarget ? g.NavWindowingTarget->RootWindowDockTree : NULL;
+
+    ImVector<ImGuiWindow*>& occluders = g.WindowsTempOccluders;
+    occluders.resize(0);
+    for (int i = g.Windows.Size - 1; i >= 0; i--)
+    {
+        ImGuiWindow* window = g.Windows[i];
+        if (!window->WasActive || window->Hidden)
+        {
+            window->OccluderFrames = 0;
+            continue;
+        }
+        ImGuiWindow* root = window->RootWindowDockTree;
+
+        const bool cullable = !(window->Flags & (ImGuiWindowFlags_Popup | ImGuiWindowFlags_Tooltip | ImGuiWindowFlags_AlwaysAutoResize))
+            && window->AutoFitFramesX <= 0 && window->AutoFitFramesY <= 0
+            && root != moving_root && root != active_root && root != nav_root && root != windowing_root;
+        if (cullable)
+        {
+            const ImRect& bb = window->OuterRectClipped;
+            for (int n = 0; n < occluders.Size && !window->OcclusionCulled; n++)
+            {
+                ImGuiWindow* occluder = occluders[n];
+                if (occluder->RootWindowDockTree == root || occluder->Viewport != window->Viewport)
+                    continue;
+                window->OcclusionCulled = occluder->OccluderRect.Contains(bb);
+            }
+        }
+
+        if (!window->IsBgOpaque || window->Collapsed || (window->Flags & (ImGuiWindowFlags_Popup | ImGuiWindowFlags_Modal | ImGuiWindowFlags_Tooltip)))
+        {
+            window->OccluderFrames = 0;
+            continue;
+        }
+
+        // Same area as the background drawn by RenderWindowDecorations(), minus rounded corners
+        ImRect occluder_bb(window->Pos + ImVec2(0.0f, window->TitleBarHeight()), window->Pos + window->Size);
+        occluder_bb.ClipWithFull(window->OuterRectClipped);
+        occluder_bb.Expand(-window->WindowRounding);
+        const bool same_area = window->OccluderFrames > 0 && memcmp(&occluder_bb, &window->OccluderRect, sizeof(ImRect)) == 0;
+        window->OccluderFrames = same_area ? (signed char)ImMin(window->OccluderFrames + 1, 2) : 1;
+        window->OccluderRect = occluder_bb;
+        if (window->OccluderFrames >= 2 && root != moving_root && root != active_root)
+            occluders.push_back(window);
+    }
+    occluders.resize(0);
+}
+
 static void CalcWindowContentSizes(ImGuiWindow* window, ImVec2* content_size_current, ImVec2* content_size_ideal)
 {
     bool preserve_old_content_sizes = false;
@@ -5842,6 +6446,8 @@ static void CalcWindowContentSizes(ImGuiWindow* window, ImVec2* content_size_cur
         preserve_old_content_sizes = true;
     else if (window->Hidden && window->HiddenFramesCannotSkipItems == 0 && window->HiddenFramesCanSkipItems > 0)
         preserve_old_content_sizes = true;
+    else if (window->SkipItemsOccluded)
+        preserve_old_content_sizes = true;
     if (preserve_old_content_sizes)
     {
         *content_size_current = window->ContentSize;
@@ -6191,6 +6797,7 @@ void ImGui::RenderWindowDecorations(ImGuiWindow* window, const ImRect& title_bar
     // Ensure that ScrollBar doesn't read last frame's SkipItems
     IM_ASSERT(window->BeginCount == 0);
     window->SkipItems = false;
+    window->IsBgOpaque = false;
 
     // Draw window + handle manual resize
     // As we highlight the title bar when want_focus is set, multiple reappearing windows will have their title bar highlighted on their reappearing frame.
@@ -6244,6 +6851,7 @@ void ImGui::RenderWindowDecorations(ImGuiWindow* window, const ImRect& title_bar
             }
 
             // Render, for docked windows and host windows we ensure bg goes before decorations
+            window->IsBgOpaque = (bg_col & IM_COL32_A_MASK) == IM_COL32_A_MASK;
             if (window->DockIsActive)
                 window->DockNode->LastBgColor = bg_col;
             ImDrawList* bg_draw_list = window->DockIsActive ? window->DockNode->HostWindow->DrawList : window->DrawList;
@@ -6489,7 +7097,16 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
     IM_ASSERT(g.FrameCountEnded != g.FrameCount);   // Called ImGui::Render() or ImGui::EndFrame() and haven't called ImGui::NewFrame() again yet
 
     // Find or create
-    ImGuiWindow* window = FindWindowByName(name);
+    ImGuiWindow* window;
+    if (g.NextWindowData.Flags & ImGuiNextWindowDataFlags_HasWindow)
+    {
+        window = g.NextWindowData.Window;
+        g.NextWindowData.Flags &= ~ImGuiNextWindowDataFlags_HasWindow;
+    }
+    else
+    {
+        window = FindWindowByName(name);
+    }
     const bool window_just_created = (window == NULL);
     if (window_just_created)
         window = CreateNewWindow(name, flags);
@@ -6522,6 +7139,10 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         window->Appearing = window_just_activated_by_user;
         if (window->Appearing)
             SetWindowConditionAllowFlags(window, ImGuiCond_Appearing, true);
+        if (!window->WasActive)
+            g.WindowsSortActivatedCount++;
+        if ((window->Flags ^ flags) & (ImGuiWindowFlags_Popup | ImGuiWindowFlags_Tooltip)) // Used by ChildWindowComparer()
+            g.WindowsSortDirty = true;
         window->FlagsPreviousFrame = window->Flags;
         window->Flags = (ImGuiWindowFlags)flags;
         window->LastFrameActive = current_frame;
@@ -6846,7 +7467,10 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         {
             IM_ASSERT(parent_window && parent_window->Active);
             window->BeginOrderWithinParent = (short)parent_window->DC.ChildWindows.Size;
+            if (window->BeginOrderWithinParent >= parent_window->DC.ChildWindowsCountPrev || parent_window->DC.ChildWindows.Data[window->BeginOrderWithinParent] != window)
+                g.WindowsSortDirty = true; // Not at the same place as on the previous frame (the previous list is still stored past ChildWindows.Size)
             parent_window->DC.ChildWindows.push_back(window);
+            g.WindowsSortChildCount++;
             if (!(flags & ImGuiWindowFlags_Popup) && !window_pos_set_by_api && !window_is_child_tooltip)
                 window->Pos = parent_window->DC.CursorPos;
         }
@@ -7007,6 +7631,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         if (window->DockIsActive)
             window->OuterRectClipped.Min.y += window->TitleBarHeight();
         window->OuterRectClipped.ClipWith(host_rect);
+        WindowHitGridUpdate(window);
 
         // Inner rectangle
         // Not affected by window border size. Used by:
@@ -7072,8 +7697,8 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
                 // - We disable this when the parent window has zero vertices, which is a common pattern leading to laying out multiple overlapping childs
                 ImGuiWindow* previous_child = parent_window->DC.ChildWindows.Size >= 2 ? parent_window->DC.ChildWindows[parent_window->DC.ChildWindows.Size - 2] : NULL;
                 bool previous_child_overlapping = previous_child ? previous_child->Rect().Overlaps(window->Rect()) : false;
-                bool parent_is_empty = (parent_window->DrawList->VtxBuffer.Size == 0);
-                if (window->DrawList->CmdBuffer.back().ElemCount == 0 && !parent_is_empty && !previous_child_overlapping)
+                bool parent_is_empty = (parent_window->DrawList->VtxBuffer.Size == 0 && parent_window->DrawList->InstBuffer.Size == 0);
+                if (window->DrawList->CmdBuffer.back().ElemCount == 0 && window->DrawList->CmdBuffer.back().InstCount == 0 && !parent_is_empty && !previous_child_overlapping)
                     render_decorations_in_parent = true;
             }
             if (render_decorations_in_parent)
@@ -7145,6 +7770,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         window->DC.MenuColumns.Update(style.ItemSpacing.x, window_just_activated_by_user);
         window->DC.TreeDepth = 0;
         window->DC.TreeJumpToParentOnPopMask = 0x00;
+        window->DC.ChildWindowsCountPrev = window->DC.ChildWindows.Size;
         window->DC.ChildWindows.resize(0);
         window->DC.StateStorage = &window->StateStorage;
         window->DC.CurrentColumns = NULL;
@@ -7303,6 +7929,12 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         if (window->Collapsed || !window->Active || hidden_regular)
             if (window->AutoFitFramesX <= 0 && window->AutoFitFramesY <= 0 && window->HiddenFramesCannotSkipItems <= 0)
                 skip_items = true;
+        window->SkipItemsOccluded = false;
+        if (!skip_items && window->OcclusionCulled && !window->Appearing && window->HiddenFramesCannotSkipItems <= 0)
+        {
+            window->SkipItemsOccluded = skip_items = true;
+            g.WindowsCulledCount++;
+        }
         window->SkipItems = skip_items;
 
         // Restore NavLayersActiveMaskNext to previous value when not visible, so a CTRL+Tab back can use a safe value.
@@ -7328,6 +7960,22 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
     return !window->SkipItems;
 }
 
+bool ImGui::Begin(ImGuiWindowHandle* handle, const char* name, bool* p_open, ImGuiWindowFlags flags)
+{
+    ImGuiContext& g = *GImGui;
+    if (handle->Serial == g.WindowHandleSerial)
+    {
+        g.NextWindowData.Flags |= ImGuiNextWindowDataFlags_HasWindow;
+        g.NextWindowData.Window = handle->Window;
+        return Begin(name, p_open, flags);
+    }
+
+    bool ret = Begin(name, p_open, flags);
+    handle->Window = g.CurrentWindow;
+    handle->Serial = g.WindowHandleSerial;
+    return ret;
+}
+
 void ImGui::End()
 {
     ImGuiContext& g = *GImGui;
@@ -7398,6 +8046,38 @@ void ImGui::BringWindowToFocusFront(ImGuiWindow* window)
     window->FocusOrder = (short)new_order;
 }
 
+// When g.Windows is still sorted, move the window along with the child windows sorted after it, so EndFrame() doesn't need to sort again.
+// Otherwise only the window is moved and EndFrame() sorts its children back after it.
+static void MoveWindowSubtreeInDisplayOrder(int src_idx, int dst_idx)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.Windows[src_idx];
+    const int count = g.WindowsSortDirty ? 1 : window->DisplaySubtreeSize;
+    IM_ASSERT(count >= 1 && src_idx + count <= g.Windows.Size && dst_idx + count <= g.Windows.Size);
+    if (src_idx == dst_idx)
+        return;
+    if (count == 1)
+    {
+        if (src_idx < dst_idx)
+            memmove(&g.Windows.Data[src_idx], &g.Windows.Data[src_idx + 1], (size_t)(dst_idx - src_idx) * sizeof(ImGuiWindow*));
+        else
+            memmove(&g.Windows.Data[dst_idx + 1], &g.Windows.Data[dst_idx], (size_t)(src_idx - dst_idx) * sizeof(ImGuiWindow*));
+        g.Windows[dst_idx] = window;
+    }
+    else
+    {
+        ImVector<ImGuiWindow*>& subtree = g.WindowsTempSortBuffer;
+        subtree.resize(count);
+        memcpy(subtree.Data, &g.Windows.Data[src_idx], (size_t)count * sizeof(ImGuiWindow*));
+        if (src_idx < dst_idx)
+            memmove(&g.Windows.Data[src_idx], &g.Windows.Data[src_idx + count], (size_t)(dst_idx - src_idx) * sizeof(ImGuiWindow*));
+        else
+            memmove(&g.Windows.Data[dst_idx + count], &g.Windows.Data[dst_idx], (size_t)(src_idx - dst_idx) * sizeof(ImGuiWindow*));
+        memcpy(&g.Windows.Data[dst_idx], subtree.Data, (size_t)count * sizeof(ImGuiWindow*));
+    }
+    g.WindowsHitGrid.DisplayIndexDirty = true;
+}
+
 void ImGui::BringWindowToDisplayFront(ImGuiWindow* window)
 {
     ImGuiContext& g = *GImGui;
@@ -7407,8 +8087,7 @@ void ImGui::BringWindowToDisplayFront(ImGuiWindow* window)
     for (int i = g.Windows.Size - 2; i >= 0; i--) // We can ignore the top-most window
         if (g.Windows[i] == window)
         {
-            memmove(&g.Windows[i], &g.Windows[i + 1], (size_t)(g.Windows.Size - i - 1) * sizeof(ImGuiWindow*));
-            g.Windows[g.Windows.Size - 1] = window;
+            MoveWindowSubtreeInDisplayOrder(i, g.Windows.Size - (g.WindowsSortDirty ? 1 : window->DisplaySubtreeSize));
             break;
         }
 }
@@ -7421,8 +8100,7 @@ void ImGui::BringWindowToDisplayBack(ImGuiWindow* window)
     for (int i = 0; i < g.Windows.Size; i++)
         if (g.Windows[i] == window)
         {
-            memmove(&g.Windows[1], &g.Windows[0], (size_t)i * sizeof(ImGuiWindow*));
-            g.Windows[0] = window;
+            MoveWindowSubtreeInDisplayOrder(i, 0);
             break;
         }
 }
@@ -7447,6 +8125,8 @@ void ImGui::BringWindowToDisplayBehind(ImGuiWindow* window, ImGuiWindow* behind_
         memmove(&g.Windows.Data[pos_beh + 1], &g.Windows.Data[pos_beh], copy_bytes);
         g.Windows[pos_beh] = window;
     }
+    g.WindowsHitGrid.DisplayIndexDirty = true;
+    g.WindowsSortDirty = true;
 }
 
 int ImGui::FindWindowDisplayIndex(ImGuiWindow* window)
@@ -11375,9 +12055,21 @@ static bool ImGui::NavScoreItem(ImGuiNavItemData* result)
     // FIXME-NAV: Introducing biases for vertical navigation, needs to be removed.
     float dbx = NavScoreItemDistInterval(cand.Min.x, cand.Max.x, curr.Min.x, curr.Max.x);
     float dby = NavScoreItemDistInterval(ImLerp(cand.Min.y, cand.Max.y, 0.2f), ImLerp(cand.Min.y, cand.Max.y, 0.8f), ImLerp(curr.Min.y, curr.Max.y, 0.2f), ImLerp(curr.Min.y, curr.Max.y, 0.8f)); // Scale down on Y to keep using box-distance for vertically touching items
+    const ImGuiDir move_dir = g.NavMoveDir;
+#if !IMGUI_DEBUG_NAV_SCORING
+    // Early out when 'cand' lies entirely behind 'curr' along the move direction: neither the quadrant check nor the axial check below can select it.
+    // In a long list of items this rejects about half of them before the more expensive center/quadrant evaluation.
+    if ((move_dir == ImGuiDir_Left && dbx > 0.0f) || (move_dir == ImGuiDir_Right && dbx < 0.0f) || (move_dir == ImGuiDir_Up && dby > 0.0f) || (move_dir == ImGuiDir_Down && dby < 0.0f))
+        return false;
+#endif
     if (dby != 0.0f && dbx != 0.0f)
         dbx = (dbx / 1000.0f) + ((dbx > 0.0f) ? +1.0f : -1.0f);
     float dist_box = ImFabs(dbx) + ImFabs(dby);
+#if !IMGUI_DEBUG_NAV_SCORING
+    // Early out when 'cand' is farther than the best candidate so far: it can't win the tie-breaks below, and the axial check only runs while DistBox == FLT_MAX.
+    if (dist_box > result->DistBox)
+        return false;
+#endif
 
     // Compute distance between centers (this is off by a factor of 2, but we only compare center distances with each other so it doesn't matter)
     float dcx = (cand.Min.x + cand.Max.x) - (curr.Min.x + curr.Max.x);
@@ -11409,7 +12101,6 @@ static bool ImGui::NavScoreItem(ImGuiNavItemData* result)
         quadrant = (g.LastItemData.ID < g.NavId) ? ImGuiDir_Left : ImGuiDir_Right;
     }
 
-    const ImGuiDir move_dir = g.NavMoveDir;
 #if IMGUI_DEBUG_NAV_SCORING
     char buf[200];
     if (g.IO.KeyCtrl) // Hold CTRL to preview score in matching quadrant. CTRL+Arrow to rotate.
@@ -19020,8 +19711,8 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     // Basic info
     Text("Dear ImGui %s", GetVersion());
     Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
-    Text("%d vertices, %d indices (%d triangles)", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3);
-    Text("%d visible windows, %d active allocations", io.MetricsRenderWindows, io.MetricsActiveAllocations);
+    Text("%d vertices, %d indices (%d triangles), %d instances", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3, io.MetricsRenderInstances);
+    Text("%d visible windows, %d culled windows, %d active allocations", io.MetricsRenderWindows, io.MetricsCulledWindows, io.MetricsActiveAllocations);
     //SameLine(); if (SmallButton("GC")) { g.GcCompactAll = true; }
 
     Separator();
@@ -19719,9 +20410,9 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
     ImGuiContext& g = *GImGui;
     ImGuiMetricsConfig* cfg = &g.DebugMetricsConfig;
     int cmd_count = draw_list->CmdBuffer.Size;
-    if (cmd_count > 0 && draw_list->CmdBuffer.back().ElemCount == 0 && draw_list->CmdBuffer.back().UserCallback == NULL)
+    if (cmd_count > 0 && draw_list->CmdBuffer.back().ElemCount == 0 && draw_list->CmdBuffer.back().InstCount == 0 && draw_list->CmdBuffer.back().UserCallback == NULL)
         cmd_count--;
-    bool node_open = TreeNode(draw_list, "%s: '%s' %d vtx, %d indices, %d cmds", label, draw_list->_OwnerName ? draw_list->_OwnerName : "", draw_list->VtxBuffer.Size, draw_list->IdxBuffer.Size, cmd_count);
+    bool node_open = TreeNode(draw_list, "%s: '%s' %d vtx, %d indices, %d inst, %d cmds", label, draw_list->_OwnerName ? draw_list->_OwnerName : "", draw_list->VtxBuffer.Size, draw_list->IdxBuffer.Size, draw_list->InstBuffer.Size, cmd_count);
     if (draw_list == GetWindowDrawList())
     {
         SameLine();
@@ -19749,9 +20440,23 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
         }
 
         char buf[300];
-        ImFormatString(buf, IM_ARRAYSIZE(buf), "DrawCmd:%5d tris, Tex 0x%p, ClipRect (%4.0f,%4.0f)-(%4.0f,%4.0f)",
-            pcmd->ElemCount / 3, (void*)(intptr_t)pcmd->TextureId,
-            pcmd->ClipRect.x, pcmd->ClipRect.y, pcmd->ClipRect.z, pcmd->ClipRect.w);
+        if (pcmd->InstCount > 0 && pcmd->ElemCount == 0)
+        {
+            BulletText("DrawCmd:%5d inst, Tex 0x%p, ClipRect (%4.0f,%4.0f)-(%4.0f,%4.0f), InstOffset: +%d",
+                pcmd->InstCount, (void*)(intptr_t)pcmd->TextureId,
+                pcmd->ClipRect.x, pcmd->ClipRect.y, pcmd->ClipRect.z, pcmd->ClipRect.w, pcmd->InstOffset);
+            if (IsItemHovered() && cfg->ShowDrawCmdBoundingBoxes && fg_draw_list)
+                DebugNodeDrawCmdShowMeshAndBoundingBox(fg_draw_list, draw_list, pcmd, false, true);
+            continue;
+        }
+        if (pcmd->InstCount > 0)
+            ImFormatString(buf, IM_ARRAYSIZE(buf), "DrawCmd:%5d inst + %d tris, Tex 0x%p, ClipRect (%4.0f,%4.0f)-(%4.0f,%4.0f)",
+                pcmd->InstCount, pcmd->ElemCount / 3, (void*)(intptr_t)pcmd->TextureId,
+                pcmd->ClipRect.x, pcmd->ClipRect.y, pcmd->ClipRect.z, pcmd->ClipRect.w);
+        else
+            ImFormatString(buf, IM_ARRAYSIZE(buf), "DrawCmd:%5d tris, Tex 0x%p, ClipRect (%4.0f,%4.0f)-(%4.0f,%4.0f)",
+                pcmd->ElemCount / 3, (void*)(intptr_t)pcmd->TextureId,
+                pcmd->ClipRect.x, pcmd->ClipRect.y, pcmd->ClipRect.z, pcmd->ClipRect.w);
         bool pcmd_node_open = TreeNode((void*)(pcmd - draw_list->CmdBuffer.begin()), "%s", buf);
         if (IsItemHovered() && (cfg->ShowDrawCmdMesh || cfg->ShowDrawCmdBoundingBoxes) && fg_draw_list)
             DebugNodeDrawCmdShowMeshAndBoundingBox(fg_draw_list, draw_list, pcmd, cfg->ShowDrawCmdMesh, cfg->ShowDrawCmdBoundingBoxes);
@@ -19812,8 +20517,9 @@ void ImGui::DebugNodeDrawCmdShowMeshAndBoundingBox(ImDrawList* out_draw_list, co
 {
     IM_ASSERT(show_mesh || show_aabb);
 
-    // Draw wire-frame version of all triangles
-    ImRect clip_rect = draw_cmd->ClipRect;
+    // Draw wire-frame version of all triangles (in screen space when the command has a transform)
+    const ImDrawTransform transform = draw_cmd->TransformIdx ? draw_list->TransformBuffer[draw_cmd->TransformIdx] : ImDrawTransform();
+    ImRect clip_rect = transform.ApplyToRect(draw_cmd->ClipRect);
     ImRect vtxs_rect(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
     ImDrawListFlags backup_flags = out_draw_list->Flags;
     out_draw_list->Flags &= ~ImDrawListFlags_AntiAliasedLines; // Disable AA on triangle outlines is more readable for very large and thin triangles.
@@ -19824,10 +20530,18 @@ void ImGui::DebugNodeDrawCmdShowMeshAndBoundingBox(ImDrawList* out_draw_list, co
 
         ImVec2 triangle[3];
         for (int n = 0; n < 3; n++, idx_n++)
-            vtxs_rect.Add((triangle[n] = vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n].pos));
+            vtxs_rect.Add((triangle[n] = transform.Apply(vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n].pos)));
         if (show_mesh)
             out_draw_list->AddPolyline(triangle, 3, IM_COL32(255, 255, 0, 255), ImDrawFlags_Closed, 1.0f); // In yellow: mesh triangles
     }
+    for (unsigned int inst_n = draw_cmd->InstOffset, inst_end = draw_cmd->InstOffset + draw_cmd->InstCount; inst_n < inst_end; inst_n++)
+    {
+        ImDrawInstance inst = draw_list->InstBuffer.Data[inst_n]; // Copy as ->AddRect() may invalidate it if out_draw_list==draw_list
+        ImRect inst_rect = transform.ApplyToRect(ImVec4(inst.Min.x, inst.Min.y, inst.Max.x, inst.Max.y));
+        vtxs_rect.Add(inst_rect);
+        if (show_mesh)
+            out_draw_list->AddRect(inst_rect.Min, inst_rect.Max, IM_COL32(255, 255, 0, 255)); // In yellow: instance quads
+    }
     // Draw bounding boxes
     if (show_aabb)
     {
@@ -19941,7 +20655,7 @@ void ImGui::DebugNodeFontGlyph(ImFont*, const ImFontGlyph* glyph)
 // [DEBUG] Display contents of ImGuiStorage
 void ImGui::DebugNodeStorage(ImGuiStorage* storage, const char* label)
 {
-    if (!TreeNode(label, "%s: %d entries, %d bytes", label, storage->Data.Size, storage->Data.size_in_bytes()))
+    if (!TreeNode(label, "%s: %d entries, %d bytes%s", label, storage->Data.Size, storage->Data.size_in_bytes() + storage->HashCtrl.size_in_bytes() + storage->HashSlots.size_in_bytes(), storage->IsHashed() ? " (hashed)" : ""))
         return;
     for (int n = 0; n < storage->Data.Size; n++)
     {
@@ -135,9 +135,13 @@ Index of this file:
 struct ImDrawChannel;               // Temporary storage to output draw commands out of order, used by ImDrawListSplitter and ImDrawList::ChannelsSplit()
 struct ImDrawCmd;                   // A single draw command within a parent ImDrawList (generally maps to 1 GPU draw call, unless it is a callback)
 struct ImDrawData;                  // All draw command lists required to render the frame + pos/size coordinates to use for the projection matrix.
+struct ImDrawExternalBuffer;        // Application owned, reference counted vertex/index data drawn by the renderer without copying into ImDrawList (ImDrawList::AddExternalGeometry)
+struct ImDrawExternalGeometry;      // A range of an ImDrawExternalBuffer referenced by a draw command
+struct ImDrawInstance;              // A single axis aligned textured rectangle drawn by instancing (rect + uv rect + col + rounding + corners = 44 bytes)
 struct ImDrawList;                  // A single draw command list (generally one per window, conceptually you may see this as a dynamic "mesh" builder)
 struct ImDrawListSharedData;        // Data shared among multiple draw lists (typically owned by parent ImGui context, but you may create one yourself)
 struct ImDrawListSplitter;          // Helper to split a draw list into different layers which can be drawn into out of order, then flattened back.
+struct ImDrawTransform;             // A 2D affine transform applied by the renderer to a range of draw commands (ImDrawList::PushTransform)
 struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
@@ -164,7 +168,9 @@ struct ImGuiTableColumnSortSpecs;   // Sorting specification for one column of a
 struct ImGuiTextBuffer;             // Helper to hold and append into a text buffer (~string builder)
 struct ImGuiTextFilter;             // Helper to parse and apply text filters (e.g. "aaaaa[,bbbbb][,ccccc]")
 struct ImGuiViewport;               // A Platform Window (always 1 unless multi-viewport are enabled. One per platform window to output to). In the future may represent Platform Monitor
+struct ImGuiWindow;                 // Storage for one window (opaque structure, unless including imgui_internal.h)
 struct ImGuiWindowClass;            // Window class (rare/advanced uses: provide hints to the platform backend via altered viewport flags and parent/child info)
+struct ImGuiWindowHandle;           // Persistent reference to a window, lets Begin()/BeginChild() skip name formatting, hashing and lookup
 
 // Enumerations
 // - We don't use strongly typed enums much because they add constraints (can't extend in private code, can't store typed in bit fields, extra casting on iteration)
@@ -335,6 +341,7 @@ namespace ImGui
     //    returned true. Begin and BeginChild are the only odd ones out. Will be fixed in a future update.]
     // - Note that the bottom of window stack always contains a window called "Debug".
     IMGUI_API bool          Begin(const char* name, bool* p_open = NULL, ImGuiWindowFlags flags = 0);
+    IMGUI_API bool          Begin(ImGuiWindowHandle* handle, const char* name, bool* p_open = NULL, ImGuiWindowFlags flags = 0); // 'handle' is filled on first use, always pass it with the same 'name'
     IMGUI_API void          End();
 
     // Child Windows
@@ -347,6 +354,7 @@ namespace ImGui
     //    returned true. Begin and BeginChild are the only odd ones out. Will be fixed in a future update.]
     IMGUI_API bool          BeginChild(const char* str_id, const ImVec2& size = ImVec2(0, 0), bool border = false, ImGuiWindowFlags flags = 0);
     IMGUI_API bool          BeginChild(ImGuiID id, const ImVec2& size = ImVec2(0, 0), bool border = false, ImGuiWindowFlags flags = 0);
+    IMGUI_API bool          BeginChild(ImGuiWindowHandle* handle, const char* str_id, const ImVec2& size = ImVec2(0, 0), bool border = false, ImGuiWindowFlags flags = 0); // 'handle' is filled on first use, resolved again if the ID stack differs
     IMGUI_API void          EndChild();
 
     // Windows Utilities
@@ -1582,6 +1590,9 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasMouseCursors       = 1 << 1,   // Backend Platform supports honoring GetMouseCursor() value to change the OS cursor shape.
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if ImGuiConfigFlags_NavEnableSetMousePos is set).
     ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasInstancing = 1 << 4,   // Backend Renderer supports ImDrawCmd::InstCount. This allows rectangles and glyphs to be output as compact ImDrawInstance records instead of 4 vertices + 6 indices each.
+    ImGuiBackendFlags_RendererHasTransform  = 1 << 5,   // Backend Renderer supports ImDrawCmd::TransformIdx. Otherwise, if you use ImDrawList::PushTransform(), call ImDrawData::ApplyTransforms() before rendering.
+    ImGuiBackendFlags_RendererHasExternalGeometry = 1 << 6, // Backend Renderer supports ImDrawCallback_ExternalGeometry commands. Otherwise, ImDrawList::AddExternalGeometry() copies CPU geometry into the draw list.
 
     // [BETA] Viewports
     ImGuiBackendFlags_PlatformHasViewports  = 1 << 10,  // Backend Platform supports multiple viewports.
@@ -2035,6 +2046,7 @@ struct ImGuiIO
     bool        ConfigDragClickToInputText;     // = false          // [BETA] Enable turning DragXXX widgets into text input with a simple mouse click-release (without moving). Not desirable on devices without a keyboard.
     bool        ConfigWindowsResizeFromEdges;   // = true           // Enable resizing of windows from their edges and from the lower-left corner. This requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback. (This used to be a per-window ImGuiWindowFlags_ResizeFromAnySide flag)
     bool        ConfigWindowsMoveFromTitleBarOnly; // = false       // Enable allowing to move windows only when clicking on their title bar. Does not apply to windows without a title bar.
+    bool        ConfigWindowsOcclusionCulling;  // = false          // [BETA] Skip items of windows fully covered by opaque windows in front of them on the previous frame (Begin() returns false). A covered window being revealed shows without contents for one frame.
     float       ConfigMemoryCompactTimer;       // = 60.0f          // Timer (in seconds) to free transient windows/tables memory buffers when unused. Set to -1.0f to disable.
 
     // Debug options
@@ -2114,8 +2126,10 @@ struct ImGuiIO
     float       Framerate;                          // Estimate of application framerate (rolling average over 60 frames, based on io.DeltaTime), in frame per second. Solely for convenience. Slow applications may not want to use a moving average or may want to reset underlying buffers occasionally.
     int         MetricsRenderVertices;              // Vertices output during last call to Render()
     int         MetricsRenderIndices;               // Indices output during last call to Render() = number of triangles * 3
+    int         MetricsRenderInstances;             // Instances output during last call to Render() (only with ImGuiBackendFlags_RendererHasInstancing)
     int         MetricsRenderWindows;               // Number of visible windows
     int         MetricsActiveWindows;               // Number of active windows
+    int         MetricsCulledWindows;               // Number of active windows which skipped their items because they were fully occluded (see io.ConfigWindowsOcclusionCulling)
     int         MetricsActiveAllocations;           // Number of active allocations, updated by MemAlloc/MemFree based on current context. May be off if you have multiple imgui contexts.
     ImVec2      MouseDelta;                         // Mouse delta. Note that this is zero if either current or previous position are invalid (-FLT_MAX,-FLT_MAX), so a disappearing/reappearing mouse won't have a huge delta.
 
@@ -2252,6 +2266,18 @@ struct ImGuiWindowClass
     ImGuiWindowClass() { memset(this, 0, sizeof(*this)); ParentViewportId = (ImGuiID)-1; DockingAllowUnclassed = true; }
 };
 
+// Persistent reference to a window for Begin()/BeginChild() overloads (typically a static or member variable next to the code submitting the window)
+// - The first call using a handle does the regular name lookup and fills it, next calls reuse the window directly.
+// - Handles are tied to the context which filled them: they are resolved again after the context is destroyed or when used with another context.
+struct ImGuiWindowHandle
+{
+    ImGuiWindow*        Window;     // NULL until first use
+    ImU32               Serial;     // ImGuiContext::WindowHandleSerial at the time 'Window' was resolved
+    ImGuiID             Seed;       // BeginChild(): ID stack top the child was resolved under
+
+    ImGuiWindowHandle() { memset(this, 0, sizeof(*this)); }
+};
+
 // Data payload for Drag and Drop operations: AcceptDragDropPayload(), GetDragDropPayload()
 struct ImGuiPayload
 {
@@ -2387,11 +2413,18 @@ struct ImGuiStorage
     };
 
     ImVector<ImGuiStoragePair>      Data;
+    ImVector<ImU8>                  HashCtrl;       // Hashed mode only: 7 bits of key hash per slot, 0x80 = empty slot. Size is a multiple of 16.
+    ImVector<int>                   HashSlots;      // Hashed mode only: index into Data per slot
 
     // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
-    void                Clear() { Data.clear(); }
+    // - Hashed mode (SetHashed(true)) keeps Data in insertion order and indexes it with an open addressing hash table:
+    //   O(1) queries and insertions for large storages (e.g. open state of 100k tree nodes), ~5 bytes more per pair.
+    //   BuildSortByKey() still sorts Data, so code iterating pairs in key order keeps working after calling it.
+    void                Clear() { Data.clear(); if (HashCtrl.Size > 0) memset(HashCtrl.Data, 0x80, (size_t)HashCtrl.Size); }
+    IMGUI_API void      SetHashed(bool hashed);
+    bool                IsHashed() const { return HashCtrl.Size > 0; }
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -2559,18 +2592,29 @@ typedef void (*ImDrawCallback)(const ImDrawList* parent_list, const ImDrawCmd* c
 // It is not done by default because they are many perfectly useful way of altering render state for imgui contents (e.g. changing shader/blending settings before an Image call).
 #define ImDrawCallback_ResetRenderState     (ImDrawCallback)(-1)
 
+// Special Draw callback value emitted by ImDrawList::AddExternalGeometry() (ImGuiBackendFlags_RendererHasExternalGeometry).
+// UserCallbackData is the index of an ImDrawExternalGeometry in the ImDrawList's ExternalBuffer[] array. ClipRect, TextureId and TransformIdx apply as usual.
+#define ImDrawCallback_ExternalGeometry     (ImDrawCallback)(-2)
+
 // Typically, 1 command = 1 GPU draw call (unless command is a callback)
 // - VtxOffset: When 'io.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset' is enabled,
 //   this fields allow us to render meshes larger than 64K vertices while keeping 16-bit indices.
 //   Backends made for <1.71. will typically ignore the VtxOffset fields.
-// - The ClipRect/TextureId/VtxOffset fields must be contiguous as we memcmp() them together (this is asserted for).
+// - InstCount: When 'io.BackendFlags & ImGuiBackendFlags_RendererHasInstancing' is enabled, a command may also
+//   draw InstCount rectangles from the ImDrawList's InstBuffer[]. A command doing both draws its instances first, then its triangles.
+// - TransformIdx: When != 0, vertices, instances and ClipRect are in the local space of ImDrawList::TransformBuffer[TransformIdx],
+//   which the renderer applies to get to screen space (ImGuiBackendFlags_RendererHasTransform, else see ImDrawData::ApplyTransforms()).
+// - The ClipRect/TextureId/VtxOffset/TransformIdx fields must be contiguous as we memcmp() them together (this is asserted for).
 struct ImDrawCmd
 {
     ImVec4          ClipRect;           // 4*4  // Clipping rectangle (x1, y1, x2, y2). Subtract ImDrawData->DisplayPos to get clipping rectangle in "viewport" coordinates
     ImTextureID     TextureId;          // 4-8  // User-provided texture ID. Set by user in ImfontAtlas::SetTexID() for fonts or passed to Image*() functions. Ignore if never using images or multiple fonts atlas.
     unsigned int    VtxOffset;          // 4    // Start offset in vertex buffer. ImGuiBackendFlags_RendererHasVtxOffset: always 0, otherwise may be >0 to support meshes larger than 64K vertices with 16-bit indices.
+    unsigned int    TransformIdx;       // 4    // Index in the callee ImDrawList's TransformBuffer[] array, 0 for identity.
     unsigned int    IdxOffset;          // 4    // Start offset in index buffer.
     unsigned int    ElemCount;          // 4    // Number of indices (multiple of 3) to be rendered as triangles. Vertices are stored in the callee ImDrawList's vtx_buffer[] array, indices in idx_buffer[].
+    unsigned int    InstOffset;         // 4    // Start offset in instance buffer.
+    unsigned int    InstCount;          // 4    // Number of ImDrawInstance to be rendered as quads, from the callee ImDrawList's InstBuffer[] array. ImGuiBackendFlags_RendererHasInstancing: always 0 otherwise.
     ImDrawCallback  UserCallback;       // 4-8  // If != NULL, call the function instead of rendering the vertices. clip_rect and texture_id will be set normally.
     void*           UserCallbackData;   // 4-8  // The draw callback code can access this.
 
@@ -2596,12 +2640,80 @@ struct ImDrawVert
 IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT;
 #endif
 
+// Instance layout (ImGuiBackendFlags_RendererHasInstancing)
+// One axis aligned rectangle, expanded to a quad by the renderer. Replaces 4 ImDrawVert + 6 ImDrawIdx (92 bytes with 16-bit indices).
+// When Rounding > 0.0f the renderer is expected to round the corners enabled in Corners and anti-alias the edges analytically (signed distance).
+// A circle is an instance with all corners rounded and Rounding equal to half its size.
+struct ImDrawInstance
+{
+    ImVec2  Min;        // Upper-left corner
+    ImVec2  Max;        // Lower-right corner
+    ImVec2  UvMin;
+    ImVec2  UvMax;
+    ImU32   Col;
+    float   Rounding;
+    ImU32   Corners;    // One byte per corner, 0xFF when rounded: top-left, top-right, bottom-right, bottom-left (in memory order)
+};
+
+// 2D affine transform: p' = AxisX * p.x + AxisY * p.y + Origin
+// Rotations and skews are supported by the renderer, but clipping rectangles are then only transformed as their bounding box.
+struct ImDrawTransform
+{
+    ImVec2  AxisX;
+    ImVec2  AxisY;
+    ImVec2  Origin;
+
+    ImDrawTransform()                                               { AxisX = ImVec2(1.0f, 0.0f); AxisY = ImVec2(0.0f, 1.0f); Origin = ImVec2(0.0f, 0.0f); }
+    ImDrawTransform(const ImVec2& scale, const ImVec2& translation) { AxisX = ImVec2(scale.x, 0.0f); AxisY = ImVec2(0.0f, scale.y); Origin = translation; }
+    inline ImVec2   Apply(const ImVec2& p) const                    { return ImVec2(AxisX.x * p.x + AxisY.x * p.y + Origin.x, AxisX.y * p.x + AxisY.y * p.y + Origin.y); }
+    IMGUI_API ImVec4 ApplyToRect(const ImVec4& r) const;            // Bounding box of the transformed rectangle (x1, y1, x2, y2)
+    IMGUI_API ImDrawTransform Combine(const ImDrawTransform& local) const; // Transform applying 'local' first, then this
+    IMGUI_API ImDrawTransform Inverse() const;
+};
+
+// External geometry (ImGuiBackendFlags_RendererHasExternalGeometry)
+// Vertex/index data owned by the application, drawn as triangles by the renderer instead of being copied into ImDrawList::VtxBuffer/IdxBuffer.
+// - Data is either in CPU memory (VtxData/IdxData) or in renderer buffer objects (VtxBufferId/IdxBufferId, e.g. OpenGL buffer names).
+// - Vertices are read as ImVec2 position, ImVec2 uv and ImU32 color at the given offsets, the default layout being ImDrawVert.
+// - Reference counted: the creator owns the initial reference, each draw list using the buffer holds one until it is reset on next frame.
+//   The creator may therefore Release() right after submitting. ReleaseFn is called when the count reaches zero.
+struct ImDrawExternalBuffer
+{
+    const void*     VtxData;            // CPU vertices, or NULL when VtxBufferId is set
+    const void*     IdxData;            // CPU indices, or NULL when IdxBufferId is set
+    unsigned int    VtxBufferId;        // Renderer vertex buffer object
+    unsigned int    IdxBufferId;        // Renderer index buffer object
+    int             VtxCount;
+    int             IdxCount;
+    int             IdxSize;            // 2 or 4 (default: sizeof(ImDrawIdx))
+    int             VtxStride;          // Default: sizeof(ImDrawVert)
+    int             VtxPosOffset;       // Default: offsetof(ImDrawVert, pos)
+    int             VtxUvOffset;        // Default: offsetof(ImDrawVert, uv)
+    int             VtxColOffset;       // Default: offsetof(ImDrawVert, col)
+    int             RefCount;
+    void            (*ReleaseFn)(ImDrawExternalBuffer* buffer);
+    void*           UserData;
+
+    ImDrawExternalBuffer()  { memset(this, 0, sizeof(*this)); IdxSize = sizeof(ImDrawIdx); VtxStride = sizeof(ImDrawVert); VtxPosOffset = IM_OFFSETOF(ImDrawVert, pos); VtxUvOffset = IM_OFFSETOF(ImDrawVert, uv); VtxColOffset = IM_OFFSETOF(ImDrawVert, col); RefCount = 1; }
+    void            AddRef()    { RefCount++; }
+    void            Release()   { IM_ASSERT(RefCount > 0); if (--RefCount == 0 && ReleaseFn != NULL) ReleaseFn(this); }
+};
+
+// A range of indices of an external buffer, referenced by ImDrawCallback_ExternalGeometry commands
+struct ImDrawExternalGeometry
+{
+    ImDrawExternalBuffer*   Buffer;
+    unsigned int            IdxOffset;
+    unsigned int            IdxCount;
+};
+
 // [Internal] For use by ImDrawList
 struct ImDrawCmdHeader
 {
     ImVec4          ClipRect;
     ImTextureID     TextureId;
     unsigned int    VtxOffset;
+    unsigned int    TransformIdx;
 };
 
 // [Internal] For use by ImDrawListSplitter
@@ -2609,16 +2721,26 @@ struct ImDrawChannel
 {
     ImVector<ImDrawCmd>         _CmdBuffer;
     ImVector<ImDrawIdx>         _IdxBuffer;
+    ImVector<ImDrawInstance>    _InstBuffer;
+    int                         _Index;      // Channel index at Split(), follows the channel if reordered before Merge() (e.g. by TableMergeDrawChannels())
 };
 
 
 // Split/Merge functions are used to split the draw list into different layers which can be drawn into out of order.
 // This is used by the Columns/Tables API, so items of each column can be batched together in a same draw call.
+// After its first Merge(), Split() lays out channel indices in place within the draw list's IdxBuffer,
+// each channel writing into a region sized from its previous count, in the order channels were last merged in.
+// Merge() then only fixes up commands instead of copying indices.
+// Unused tails of regions are left as degenerate triangles, so ImDrawCmd::ElemCount may include a few of those.
+// A channel outgrowing its region (moved to its own buffer) or channels reordered differently fall back to copying that frame.
 struct ImDrawListSplitter
 {
     int                         _Current;    // Current channel number (0)
     int                         _Count;      // Number of active channels (1+)
     ImVector<ImDrawChannel>     _Channels;   // Draw channels (not resized down so _Count might be < Channels.Size)
+    ImVector<ImDrawIdx>         _IdxStorage; // Draw list index buffer while channels are laid out in place (Size = indices before Split())
+    ImVector<int>               _IdxCounts;  // Index count of each channel at last Merge(), used to size regions at next Split()
+    ImVector<int>               _IdxOrder;   // Channel indices in the order of last Merge(), used to lay out regions at next Split()
 
     inline ImDrawListSplitter()  { memset(this, 0, sizeof(*this)); }
     inline ~ImDrawListSplitter() { ClearFreeMemory(); }
@@ -2627,6 +2749,7 @@ struct ImDrawListSplitter
     IMGUI_API void              Split(ImDrawList* draw_list, int count);
     IMGUI_API void              Merge(ImDrawList* draw_list);
     IMGUI_API void              SetCurrentChannel(ImDrawList* draw_list, int channel_idx);
+    IMGUI_API void              _DetachIdxBuffer(ImDrawList* draw_list); // [Internal] move draw_list->IdxBuffer out of _IdxStorage before it grows past its region
 };
 
 // Flags for ImDrawList functions
@@ -2658,6 +2781,8 @@ enum ImDrawListFlags_
     ImDrawListFlags_AntiAliasedLinesUseTex  = 1 << 1,  // Enable anti-aliased lines/borders using textures when possible. Require backend to render with bilinear filtering (NOT point/nearest filtering).
     ImDrawListFlags_AntiAliasedFill         = 1 << 2,  // Enable anti-aliased edge around filled shapes (rounded rectangles, circles).
     ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_AllowInstancing         = 1 << 4,  // Can emit rectangles and glyphs into InstBuffer. Set when 'ImGuiBackendFlags_RendererHasInstancing' is enabled.
+    ImDrawListFlags_AllowExternalGeometry   = 1 << 5,  // Can emit ImDrawCallback_ExternalGeometry commands. Set when 'ImGuiBackendFlags_RendererHasExternalGeometry' is enabled.
 };
 
 // Draw command list
@@ -2675,6 +2800,9 @@ struct ImDrawList
     ImVector<ImDrawCmd>     CmdBuffer;          // Draw commands. Typically 1 command = 1 GPU draw call, unless the command is a callback.
     ImVector<ImDrawIdx>     IdxBuffer;          // Index buffer. Each command consume ImDrawCmd::ElemCount of those
     ImVector<ImDrawVert>    VtxBuffer;          // Vertex buffer.
+    ImVector<ImDrawInstance> InstBuffer;        // Instance buffer. Each instanced command consume ImDrawCmd::InstCount of those
+    ImVector<ImDrawTransform> TransformBuffer;  // Transforms referred to by ImDrawCmd::TransformIdx. Empty, or [0] is identity.
+    ImVector<ImDrawExternalGeometry> ExternalBuffer; // External geometry referred to by ImDrawCallback_ExternalGeometry commands. Each entry holds a reference on its buffer.
     ImDrawListFlags         Flags;              // Flags, you may poke into these to adjust anti-aliasing settings per-primitive.
 
     // [Internal, used while building lists]
@@ -2683,11 +2811,17 @@ struct ImDrawList
     const char*             _OwnerName;         // Pointer to owner window's name for debugging
     ImDrawVert*             _VtxWritePtr;       // [Internal] point within VtxBuffer.Data after each add command (to avoid using the ImVector<> operators too much)
     ImDrawIdx*              _IdxWritePtr;       // [Internal] point within IdxBuffer.Data after each add command (to avoid using the ImVector<> operators too much)
+    ImDrawInstance*         _InstWritePtr;      // [Internal] point within InstBuffer.Data after each add command
+    ImVec4                  _TriBounds;         // [Internal] bounds of the triangles of the command starting at _TriBoundsIdxOffset, up to _TriBoundsIdxEnd (see _InstancesOverlapTriangles())
+    unsigned int            _TriBoundsIdxOffset;// [Internal]
+    unsigned int            _TriBoundsIdxEnd;   // [Internal]
     ImVector<ImVec4>        _ClipRectStack;     // [Internal]
     ImVector<ImTextureID>   _TextureIdStack;    // [Internal]
+    ImVector<unsigned int>  _TransformStack;    // [Internal] indices into TransformBuffer
     ImVector<ImVec2>        _Path;              // [Internal] current path building
     ImDrawCmdHeader         _CmdHeader;         // [Internal] template of active commands. Fields should match those of CmdBuffer.back().
     ImDrawListSplitter      _Splitter;          // [Internal] for channels api (note: prefer using your own persistent instance of ImDrawListSplitter!)
+    ImDrawListSplitter*     _IdxSplitter;       // [Internal] splitter currently laying out channels in place within IdxBuffer, if any
     float                   _FringeScale;       // [Internal] anti-alias fringe is scaled by this value, this helps to keep things sharp while zooming at vertex buffer content
 
     // If you want to create ImDrawList instances, pass them ImGui::GetDrawListSharedData() or create and use your own ImDrawListSharedData (so you can use ImDrawList without ImGui)
@@ -2702,6 +2836,14 @@ struct ImDrawList
     inline ImVec2   GetClipRectMin() const { const ImVec4& cr = _ClipRectStack.back(); return ImVec2(cr.x, cr.y); }
     inline ImVec2   GetClipRectMax() const { const ImVec4& cr = _ClipRectStack.back(); return ImVec2(cr.z, cr.w); }
 
+    // Render-level transform (e.g. zoom/pan of a canvas without re-tessellating its contents)
+    // - Everything added until PopTransform() is in the local space of 'transform', combined with the current one.
+    // - Also pushes the current clip rectangle converted to local space, so clip rectangles pushed meanwhile are local too.
+    // - Like PushClipRect() this doesn't affect ImGui:: logic (hit-testing, item layout). Renderer needs ImGuiBackendFlags_RendererHasTransform.
+    IMGUI_API void  PushTransform(const ImDrawTransform& transform);
+    IMGUI_API void  PopTransform();
+    IMGUI_API ImDrawTransform GetTransform() const;                 // Current local to screen transform
+
     // Primitives
     // - Filled shapes must always use clockwise winding order. The anti-aliasing fringe depends on it. Counter-clockwise shapes will have "inward" anti-aliasing.
     // - For rectangular primitives, "p_min" and "p_max" represent the upper-left and lower-right corners.
@@ -2736,6 +2878,11 @@ struct ImDrawList
     IMGUI_API void  AddImageQuad(ImTextureID user_texture_id, const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, const ImVec2& uv1 = ImVec2(0, 0), const ImVec2& uv2 = ImVec2(1, 0), const ImVec2& uv3 = ImVec2(1, 1), const ImVec2& uv4 = ImVec2(0, 1), ImU32 col = IM_COL32_WHITE);
     IMGUI_API void  AddImageRounded(ImTextureID user_texture_id, const ImVec2& p_min, const ImVec2& p_max, const ImVec2& uv_min, const ImVec2& uv_max, ImU32 col, float rounding, ImDrawFlags flags = 0);
 
+    // External geometry
+    // - Draws 'idx_count' indices (-1 = all) starting at 'idx_offset' of an application owned buffer, as triangles, with current clip rect and transform.
+    // - With ImGuiBackendFlags_RendererHasExternalGeometry the buffer is referenced, not copied. Otherwise CPU data is copied like PrimReserve() would.
+    IMGUI_API void  AddExternalGeometry(ImDrawExternalBuffer* buffer, ImTextureID user_texture_id, int idx_offset = 0, int idx_count = -1);
+
     // Stateful path API, add points then finish with PathFillConvex() or PathStroke()
     // - Filled shapes must always use clockwise winding order. The anti-aliasing fringe depends on it. Counter-clockwise shapes will have "inward" anti-aliasing.
     inline    void  PathClear()                                                 { _Path.Size = 0; }
@@ -2752,7 +2899,7 @@ struct ImDrawList
     // Advanced
     IMGUI_API void  AddCallback(ImDrawCallback callback, void* callback_data);  // Your rendering function must check for 'UserCallback' in ImDrawCmd and call the function instead of rendering triangles.
     IMGUI_API void  AddDrawCmd();                                               // This is useful if you need to forcefully create a new draw call (to allow for dependent rendering / blending). Otherwise primitives are merged into the same draw-call as much as possible
-    IMGUI_API ImDrawList* CloneOutput() const;                                  // Create a clone of the CmdBuffer/IdxBuffer/VtxBuffer.
+    IMGUI_API ImDrawList* CloneOutput() const;                                  // Create a clone of the CmdBuffer/IdxBuffer/VtxBuffer/InstBuffer/TransformBuffer/ExternalBuffer.
 
     // Advanced: Channels
     // - Use to split render into layers. By switching channels to can render out-of-order (e.g. submit FG primitives before BG primitives)
@@ -2776,6 +2923,16 @@ struct ImDrawList
     inline    void  PrimWriteIdx(ImDrawIdx idx)                                     { *_IdxWritePtr = idx; _IdxWritePtr++; }
     inline    void  PrimVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)         { PrimWriteIdx((ImDrawIdx)_VtxCurrentIdx); PrimWriteVtx(pos, uv, col); } // Write vertex with unique index
 
+    // Advanced: Instance allocations (require ImDrawListFlags_AllowInstancing)
+    // - Each instance is a single axis aligned rectangle. Reserve them via PrimReserveInstances() beforehand.
+    // - A command draws its instances before its triangles. Instances whose 'bounds' (x1, y1, x2, y2) overlap triangles of the current command
+    //   are therefore reserved in a new command. Pass the bounds of what you are about to write to keep sharing the command otherwise.
+    // - Use PrimRectInstanced() to get the fallback to PrimRectUV() automatically when the renderer can't draw instances.
+    IMGUI_API void  PrimReserveInstances(int inst_count, const ImVec4& bounds = ImVec4(-FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX));
+    IMGUI_API void  PrimUnreserveInstances(int inst_count);
+    IMGUI_API void  PrimRectInstanced(const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, ImU32 col);
+    inline    void  PrimWriteInstance(const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, ImU32 col, float rounding = 0.0f, ImU32 corners = 0xFFFFFFFF) { _InstWritePtr->Min = a; _InstWritePtr->Max = b; _InstWritePtr->UvMin = uv_a; _InstWritePtr->UvMax = uv_b; _InstWritePtr->Col = col; _InstWritePtr->Rounding = rounding; _InstWritePtr->Corners = corners; _InstWritePtr++; }
+
     // Obsolete names
     //inline  void  AddBezierCurve(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, ImU32 col, float thickness, int num_segments = 0) { AddBezierCubic(p1, p2, p3, p4, col, thickness, num_segments); } // OBSOLETED in 1.80 (Jan 2021)
     //inline  void  PathBezierCurveTo(const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, int num_segments = 0) { PathBezierCubicCurveTo(p2, p3, p4, num_segments); } // OBSOLETED in 1.80 (Jan 2021)
@@ -2788,6 +2945,9 @@ struct ImDrawList
     IMGUI_API void  _OnChangedClipRect();
     IMGUI_API void  _OnChangedTextureID();
     IMGUI_API void  _OnChangedVtxOffset();
+    IMGUI_API void  _OnChangedTransform();
+    IMGUI_API bool  _InstancesOverlapTriangles(const ImVec4& bounds);
+    IMGUI_API void  _SplitOverlappingInstances(int inst_count);
     IMGUI_API int   _CalcCircleAutoSegmentCount(float radius) const;
     IMGUI_API void  _PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step);
     IMGUI_API void  _PathArcToN(const ImVec2& center, float radius, float a_min, float a_max, int num_segments);
@@ -2802,6 +2962,7 @@ struct ImDrawData
     int             CmdListsCount;          // Number of ImDrawList* to render
     int             TotalIdxCount;          // For convenience, sum of all ImDrawList's IdxBuffer.Size
     int             TotalVtxCount;          // For convenience, sum of all ImDrawList's VtxBuffer.Size
+    int             TotalInstCount;         // For convenience, sum of all ImDrawList's InstBuffer.Size
     ImDrawList**    CmdLists;               // Array of ImDrawList* to render. The ImDrawList are owned by ImGuiContext and only pointed to from here.
     ImVec2          DisplayPos;             // Top-left position of the viewport to render (== top-left of the orthogonal projection matrix to use) (== GetMainViewport()->Pos for the main viewport, == (0.0) in most single-viewport applications)
     ImVec2          DisplaySize;            // Size of the viewport to render (== GetMainViewport()->Size for the main viewport, == io.DisplaySize in most single-viewport applications)
@@ -2811,8 +2972,9 @@ struct ImDrawData
     // Functions
     ImDrawData()    { Clear(); }
     void Clear()    { memset(this, 0, sizeof(*this)); }     // The ImDrawList are owned by ImGuiContext!
-    IMGUI_API void  DeIndexAllBuffers();                    // Helper to convert all buffers from indexed to non-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering!
+    IMGUI_API void  DeIndexAllBuffers();                    // Helper to convert all buffers from indexed to non-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering! Doesn't support instanced commands.
     IMGUI_API void  ScaleClipRects(const ImVec2& fb_scale); // Helper to scale the ClipRect field of each ImDrawCmd. Use if your final output buffer is at a different scale than Dear ImGui expects, or if there is a difference between your window resolution and framebuffer resolution.
+    IMGUI_API void  ApplyTransforms();                      // Helper to bake ImDrawCmd::TransformIdx into vertices, instances and ClipRect, for renderers without ImGuiBackendFlags_RendererHasTransform. Modifies the draw lists!
 };
 
 //-----------------------------------------------------------------------------
@@ -388,25 +388,42 @@ void ImDrawListSharedData::SetCircleTessellationMaxError(float max_error)
 }
 
 // Initialize before use in a new frame. We always have a command ready in the buffer.
+// Forget bounds of triangles accumulated by _InstancesOverlapTriangles(), when the current command may not be the one they were accumulated from
+static inline void ImDrawList_ResetTriBounds(ImDrawList* draw_list)
+{
+    draw_list->_TriBounds = ImVec4(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    draw_list->_TriBoundsIdxOffset = draw_list->_TriBoundsIdxEnd = 0;
+}
+
 void ImDrawList::_ResetForNewFrame()
 {
     // Verify that the ImDrawCmd fields we want to memcmp() are contiguous in memory.
     IM_STATIC_ASSERT(IM_OFFSETOF(ImDrawCmd, ClipRect) == 0);
     IM_STATIC_ASSERT(IM_OFFSETOF(ImDrawCmd, TextureId) == sizeof(ImVec4));
     IM_STATIC_ASSERT(IM_OFFSETOF(ImDrawCmd, VtxOffset) == sizeof(ImVec4) + sizeof(ImTextureID));
+    IM_STATIC_ASSERT(IM_OFFSETOF(ImDrawCmd, TransformIdx) == sizeof(ImVec4) + sizeof(ImTextureID) + sizeof(unsigned int));
     if (_Splitter._Count > 1)
         _Splitter.Merge(this);
+    IM_ASSERT(_IdxSplitter == NULL && "Missing ImDrawListSplitter::Merge() on this draw list!");
 
     CmdBuffer.resize(0);
     IdxBuffer.resize(0);
     VtxBuffer.resize(0);
+    InstBuffer.resize(0);
+    TransformBuffer.resize(0);
+    for (ImDrawExternalGeometry& geometry : ExternalBuffer)
+        geometry.Buffer->Release();
+    ExternalBuffer.resize(0);
     Flags = _Data->InitialFlags;
     memset(&_CmdHeader, 0, sizeof(_CmdHeader));
     _VtxCurrentIdx = 0;
     _VtxWritePtr = NULL;
     _IdxWritePtr = NULL;
+    _InstWritePtr = NULL;
+    ImDrawList_ResetTriBounds(this);
     _ClipRectStack.resize(0);
     _TextureIdStack.resize(0);
+    _TransformStack.resize(0);
     _Path.resize(0);
     _Splitter.Clear();
     CmdBuffer.push_back(ImDrawCmd());
@@ -418,12 +435,19 @@ void ImDrawList::_ClearFreeMemory()
     CmdBuffer.clear();
     IdxBuffer.clear();
     VtxBuffer.clear();
+    InstBuffer.clear();
+    TransformBuffer.clear();
+    for (ImDrawExternalGeometry& geometry : ExternalBuffer)
+        geometry.Buffer->Release();
+    ExternalBuffer.clear();
     Flags = ImDrawListFlags_None;
     _VtxCurrentIdx = 0;
     _VtxWritePtr = NULL;
     _IdxWritePtr = NULL;
+    _InstWritePtr = NULL;
     _ClipRectStack.clear();
     _TextureIdStack.clear();
+    _TransformStack.clear();
     _Path.clear();
     _Splitter.ClearFreeMemory();
 }
@@ -434,6 +458,11 @@ ImDrawList* ImDrawList::CloneOutput() const
     dst->CmdBuffer = CmdBuffer;
     dst->IdxBuffer = IdxBuffer;
     dst->VtxBuffer = VtxBuffer;
+    dst->InstBuffer = InstBuffer;
+    dst->TransformBuffer = TransformBuffer;
+    dst->ExternalBuffer = ExternalBuffer;
+    for (ImDrawExternalGeometry& geometry : dst->ExternalBuffer)
+        geometry.Buffer->AddRef();
     dst->Flags = Flags;
     return dst;
 }
@@ -444,7 +473,9 @@ void ImDrawList::AddDrawCmd()
     draw_cmd.ClipRect = _CmdHeader.ClipRect;    // Same as calling ImDrawCmd_HeaderCopy()
     draw_cmd.TextureId = _CmdHeader.TextureId;
     draw_cmd.VtxOffset = _CmdHeader.VtxOffset;
+    draw_cmd.TransformIdx = _CmdHeader.TransformIdx;
     draw_cmd.IdxOffset = IdxBuffer.Size;
+    draw_cmd.InstOffset = InstBuffer.Size;
 
     IM_ASSERT(draw_cmd.ClipRect.x <= draw_cmd.ClipRect.z && draw_cmd.ClipRect.y <= draw_cmd.ClipRect.w);
     CmdBuffer.push_back(draw_cmd);
@@ -457,7 +488,7 @@ void ImDrawList::_PopUnusedDrawCmd()
     while (CmdBuffer.Size > 0)
     {
         ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
-        if (curr_cmd->ElemCount != 0 || curr_cmd->UserCallback != NULL)
+        if (curr_cmd->ElemCount != 0 || curr_cmd->InstCount != 0 || curr_cmd->UserCallback != NULL)
             return;// break;
         CmdBuffer.pop_back();
     }
@@ -468,7 +499,7 @@ void ImDrawList::AddCallback(ImDrawCallback callback, void* callback_data)
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     IM_ASSERT(curr_cmd->UserCallback == NULL);
-    if (curr_cmd->ElemCount != 0)
+    if (curr_cmd->ElemCount != 0 || curr_cmd->InstCount != 0)
     {
         AddDrawCmd();
         curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
@@ -480,10 +511,11 @@ void ImDrawList::AddCallback(ImDrawCallback callback, void* callback_data)
 }
 
 // Compare ClipRect, TextureId and VtxOffset with a single memcmp()
-#define ImDrawCmd_HeaderSize                            (IM_OFFSETOF(ImDrawCmd, VtxOffset) + sizeof(unsigned int))
-#define ImDrawCmd_HeaderCompare(CMD_LHS, CMD_RHS)       (memcmp(CMD_LHS, CMD_RHS, ImDrawCmd_HeaderSize))    // Compare ClipRect, TextureId, VtxOffset
-#define ImDrawCmd_HeaderCopy(CMD_DST, CMD_SRC)          (memcpy(CMD_DST, CMD_SRC, ImDrawCmd_HeaderSize))    // Copy ClipRect, TextureId, VtxOffset
-#define ImDrawCmd_AreSequentialIdxOffset(CMD_0, CMD_1)  (CMD_0->IdxOffset + CMD_0->ElemCount == CMD_1->IdxOffset)
+#define ImDrawCmd_HeaderSize                            (IM_OFFSETOF(ImDrawCmd, TransformIdx) + sizeof(unsigned int))
+#define ImDrawCmd_HeaderCompare(CMD_LHS, CMD_RHS)       (memcmp(CMD_LHS, CMD_RHS, ImDrawCmd_HeaderSize))    // Compare ClipRect, TextureId, VtxOffset, TransformIdx
+#define ImDrawCmd_HeaderCopy(CMD_DST, CMD_SRC)          (memcpy(CMD_DST, CMD_SRC, ImDrawCmd_HeaderSize))    // Copy ClipRect, TextureId, VtxOffset, TransformIdx
+#define ImDrawCmd_AreSequentialIdxOffset(CMD_0, CMD_1)  (CMD_0->IdxOffset + CMD_0->ElemCount == CMD_1->IdxOffset && CMD_0->InstOffset + CMD_0->InstCount == CMD_1->InstOffset)
+#define ImDrawCmd_CanMergeKinds(CMD_0, CMD_1)           (CMD_0->ElemCount == 0 || CMD_1->InstCount == 0)    // Merged instances are drawn before merged triangles, CMD_1 instances may not move below CMD_0 triangles
 
 // Try to merge two last draw commands
 void ImDrawList::_TryMergeDrawCmds()
@@ -491,9 +523,10 @@ void ImDrawList::_TryMergeDrawCmds()
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     ImDrawCmd* prev_cmd = curr_cmd - 1;
-    if (ImDrawCmd_HeaderCompare(curr_cmd, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && curr_cmd->UserCallback == NULL && prev_cmd->UserCallback == NULL)
+    if (ImDrawCmd_HeaderCompare(curr_cmd, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && ImDrawCmd_CanMergeKinds(prev_cmd, curr_cmd) && curr_cmd->UserCallback == NULL && prev_cmd->UserCallback == NULL)
     {
         prev_cmd->ElemCount += curr_cmd->ElemCount;
+        prev_cmd->InstCount += curr_cmd->InstCount;
         CmdBuffer.pop_back();
     }
 }
@@ -505,7 +538,7 @@ void ImDrawList::_OnChangedClipRect()
     // If current command is used with different settings we need to add a new command
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
-    if (curr_cmd->ElemCount != 0 && memcmp(&curr_cmd->ClipRect, &_CmdHeader.ClipRect, sizeof(ImVec4)) != 0)
+    if ((curr_cmd->ElemCount != 0 || curr_cmd->InstCount != 0) && memcmp(&curr_cmd->ClipRect, &_CmdHeader.ClipRect, sizeof(ImVec4)) != 0)
     {
         AddDrawCmd();
         return;
@@ -514,7 +547,7 @@ void ImDrawList::_OnChangedClipRect()
 
     // Try to merge with previous command if it matches, else use current command
     ImDrawCmd* prev_cmd = curr_cmd - 1;
-    if (curr_cmd->ElemCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && curr_cmd->InstCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
     {
         CmdBuffer.pop_back();
         return;
@@ -528,7 +561,7 @@ void ImDrawList::_OnChangedTextureID()
     // If current command is used with different settings we need to add a new command
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
-    if (curr_cmd->ElemCount != 0 && curr_cmd->TextureId != _CmdHeader.TextureId)
+    if ((curr_cmd->ElemCount != 0 || curr_cmd->InstCount != 0) && curr_cmd->TextureId != _CmdHeader.TextureId)
     {
         AddDrawCmd();
         return;
@@ -537,7 +570,7 @@ void ImDrawList::_OnChangedTextureID()
 
     // Try to merge with previous command if it matches, else use current command
     ImDrawCmd* prev_cmd = curr_cmd - 1;
-    if (curr_cmd->ElemCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && curr_cmd->InstCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
     {
         CmdBuffer.pop_back();
         return;
@@ -553,7 +586,7 @@ void ImDrawList::_OnChangedVtxOffset()
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     //IM_ASSERT(curr_cmd->VtxOffset != _CmdHeader.VtxOffset); // See #3349
-    if (curr_cmd->ElemCount != 0)
+    if (curr_cmd->ElemCount != 0 || curr_cmd->InstCount != 0)
     {
         AddDrawCmd();
         return;
@@ -562,6 +595,30 @@ void ImDrawList::_OnChangedVtxOffset()
     curr_cmd->VtxOffset = _CmdHeader.VtxOffset;
 }
 
+void ImDrawList::_OnChangedTransform()
+{
+    // Pushing/popping a transform also changes the clip rectangle, compare both at once
+    IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
+    ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    if ((curr_cmd->ElemCount != 0 || curr_cmd->InstCount != 0) && ImDrawCmd_HeaderCompare(curr_cmd, &_CmdHeader) != 0)
+    {
+        AddDrawCmd();
+        return;
+    }
+    IM_ASSERT(curr_cmd->UserCallback == NULL);
+
+    // Try to merge with previous command if it matches, else use current command
+    ImDrawCmd* prev_cmd = curr_cmd - 1;
+    if (curr_cmd->ElemCount == 0 && curr_cmd->InstCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
+    {
+        CmdBuffer.pop_back();
+        return;
+    }
+
+    curr_cmd->ClipRect = _CmdHeader.ClipRect;
+    curr_cmd->TransformIdx = _CmdHeader.TransformIdx;
+}
+
 int ImDrawList::_CalcCircleAutoSegmentCount(float radius) const
 {
     // Automatic segment count
@@ -618,6 +675,73 @@ void ImDrawList::PopTextureID()
     _OnChangedTextureID();
 }
 
+ImVec4 ImDrawTransform::ApplyToRect(const ImVec4& r) const
+{
+    const ImVec2 p[4] = { Apply(ImVec2(r.x, r.y)), Apply(ImVec2(r.z, r.y)), Apply(ImVec2(r.z, r.w)), Apply(ImVec2(r.x, r.w)) };
+    ImVec4 out(p[0].x, p[0].y, p[0].x, p[0].y);
+    for (int n = 1; n < 4; n++)
+    {
+        out.x = ImMin(out.x, p[n].x); out.y = ImMin(out.y, p[n].y);
+        out.z = ImMax(out.z, p[n].x); out.w = ImMax(out.w, p[n].y);
+    }
+    return out;
+}
+
+ImDrawTransform ImDrawTransform::Combine(const ImDrawTransform& local) const
+{
+    ImDrawTransform out;
+    out.AxisX = AxisX * local.AxisX.x + AxisY * local.AxisX.y;
+    out.AxisY = AxisX * local.AxisY.x + AxisY * local.AxisY.y;
+    out.Origin = Apply(local.Origin);
+    return out;
+}
+
+ImDrawTransform ImDrawTransform::Inverse() const
+{
+    const float det = AxisX.x * AxisY.y - AxisY.x * AxisX.y;
+    const float inv_det = (det != 0.0f) ? 1.0f / det : 0.0f;
+    ImDrawTransform out;
+    out.AxisX = ImVec2(AxisY.y * inv_det, -AxisX.y * inv_det);
+    out.AxisY = ImVec2(-AxisY.x * inv_det, AxisX.x * inv_det);
+    out.Origin = ImVec2(0.0f, 0.0f);
+    out.Origin = out.Apply(Origin) * -1.0f;
+    return out;
+}
+
+void ImDrawList::PushTransform(const ImDrawTransform& transform)
+{
+    IM_ASSERT(transform.AxisX.x * transform.AxisY.y - transform.AxisY.x * transform.AxisX.y != 0.0f && "Transform must be invertible!");
+    if (TransformBuffer.Size == 0)
+        TransformBuffer.push_back(ImDrawTransform()); // [0] is identity
+
+    // Reuse last transform when pushing the same one again (e.g. multiple Push/Pop blocks on a canvas), so commands can still merge
+    ImDrawTransform combined = TransformBuffer[_CmdHeader.TransformIdx].Combine(transform);
+    if (TransformBuffer.Size == 1 || memcmp(&TransformBuffer.back(), &combined, sizeof(ImDrawTransform)) != 0)
+        TransformBuffer.push_back(combined);
+    _TransformStack.push_back((unsigned int)TransformBuffer.Size - 1);
+
+    // Clip rectangle is expressed in the same space as vertices
+    ImVec4 cr = transform.Inverse().ApplyToRect(_CmdHeader.ClipRect);
+    _ClipRectStack.push_back(cr);
+    _CmdHeader.ClipRect = cr;
+    _CmdHeader.TransformIdx = _TransformStack.back();
+    _OnChangedTransform();
+}
+
+void ImDrawList::PopTransform()
+{
+    _TransformStack.pop_back();
+    _ClipRectStack.pop_back();
+    _CmdHeader.TransformIdx = (_TransformStack.Size == 0) ? 0 : _TransformStack.Data[_TransformStack.Size - 1];
+    _CmdHeader.ClipRect = (_ClipRectStack.Size == 0) ? _Data->ClipRectFullscreen : _ClipRectStack.Data[_ClipRectStack.Size - 1];
+    _OnChangedTransform();
+}
+
+ImDrawTransform ImDrawList::GetTransform() const
+{
+    return (TransformBuffer.Size == 0) ? ImDrawTransform() : TransformBuffer[_CmdHeader.TransformIdx];
+}
+
 // Reserve space for a number of vertices and indices.
 // You must finish filling your reserved data before calling PrimReserve() again, as it may reallocate or
 // submit the intermediate results. PrimUnreserve() can be used to release unused allocations.
@@ -634,6 +758,7 @@ void ImDrawList::PrimReserve(int idx_count, int vtx_count)
         _OnChangedVtxOffset();
     }
 
+    // Triangles are drawn after the command's instances, so they can always be added to it
     ImDrawCmd* draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     draw_cmd->ElemCount += idx_count;
 
@@ -642,6 +767,8 @@ void ImDrawList::PrimReserve(int idx_count, int vtx_count)
     _VtxWritePtr = VtxBuffer.Data + vtx_buffer_old_size;
 
     int idx_buffer_old_size = IdxBuffer.Size;
+    if (_IdxSplitter != NULL && idx_buffer_old_size + idx_count > IdxBuffer.Capacity)
+        _IdxSplitter->_DetachIdxBuffer(this);
     IdxBuffer.resize(idx_buffer_old_size + idx_count);
     _IdxWritePtr = IdxBuffer.Data + idx_buffer_old_size;
 }
@@ -657,6 +784,105 @@ void ImDrawList::PrimUnreserve(int idx_count, int vtx_count)
     IdxBuffer.shrink(IdxBuffer.Size - idx_count);
 }
 
+// Reserve space for a number of instances, see PrimReserve() for rules.
+// Instances join the current command unless they may overlap its triangles, which are drawn after them.
+void ImDrawList::PrimReserveInstances(int inst_count, const ImVec4& bounds)
+{
+    IM_ASSERT_PARANOID(inst_count >= 0);
+    IM_ASSERT(Flags & ImDrawListFlags_AllowInstancing);
+
+    ImDrawCmd* draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    if (draw_cmd->ElemCount != 0 && _InstancesOverlapTriangles(bounds))
+    {
+        AddDrawCmd();
+        draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    }
+    IM_ASSERT_PARANOID(draw_cmd->InstOffset + draw_cmd->InstCount == (unsigned int)InstBuffer.Size);
+    draw_cmd->InstCount += inst_count;
+
+    int inst_buffer_old_size = InstBuffer.Size;
+    InstBuffer.resize(inst_buffer_old_size + inst_count);
+    _InstWritePtr = InstBuffer.Data + inst_buffer_old_size;
+}
+
+// Release the a number of reserved instances from the end of the last reservation made with PrimReserveInstances().
+void ImDrawList::PrimUnreserveInstances(int inst_count)
+{
+    IM_ASSERT_PARANOID(inst_count >= 0);
+
+    ImDrawCmd* draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    draw_cmd->InstCount -= inst_count;
+    InstBuffer.shrink(InstBuffer.Size - inst_count);
+    _InstWritePtr = InstBuffer.Data + InstBuffer.Size;
+}
+
+// Test 'bounds' against the triangles of the current command. Bounds of triangles are accumulated as they are added, not recomputed every time.
+bool ImDrawList::_InstancesOverlapTriangles(const ImVec4& bounds)
+{
+    ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    const unsigned int idx_end = curr_cmd->IdxOffset + curr_cmd->ElemCount;
+    if (_TriBoundsIdxOffset != curr_cmd->IdxOffset || _TriBoundsIdxEnd > idx_end)
+    {
+        _TriBounds = ImVec4(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+        _TriBoundsIdxOffset = _TriBoundsIdxEnd = curr_cmd->IdxOffset;
+    }
+    const ImDrawVert* vtx_buffer = VtxBuffer.Data + curr_cmd->VtxOffset;
+    for (const ImDrawIdx* idx = IdxBuffer.Data + _TriBoundsIdxEnd, *idx_buffer_end = IdxBuffer.Data + idx_end; idx < idx_buffer_end; idx++)
+    {
+        const ImVec2 pos = vtx_buffer[*idx].pos;
+        _TriBounds.x = ImMin(_TriBounds.x, pos.x); _TriBounds.y = ImMin(_TriBounds.y, pos.y);
+        _TriBounds.z = ImMax(_TriBounds.z, pos.x); _TriBounds.w = ImMax(_TriBounds.w, pos.y);
+    }
+    _TriBoundsIdxEnd = idx_end;
+
+    // Nothing outside of the clip rectangle is visible, so it can't overlap
+    const ImVec4& clip_rect = curr_cmd->ClipRect;
+    const float x1 = ImMax(ImMax(bounds.x, _TriBounds.x), clip_rect.x), x2 = ImMin(ImMin(bounds.z, _TriBounds.z), clip_rect.z);
+    const float y1 = ImMax(ImMax(bounds.y, _TriBounds.y), clip_rect.y), y2 = ImMin(ImMin(bounds.w, _TriBounds.w), clip_rect.w);
+    return x1 < x2 && y1 < y2;
+}
+
+// Move the last 'inst_count' instances to a new command if they overlap triangles of the current command.
+// For callers who only know the bounds of their instances once written, after reserving them with empty bounds.
+void ImDrawList::_SplitOverlappingInstances(int inst_count)
+{
+    ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    if (curr_cmd->ElemCount == 0 || inst_count == 0)
+        return;
+    IM_ASSERT_PARANOID(curr_cmd->InstCount >= (unsigned int)inst_count && curr_cmd->InstOffset + curr_cmd->InstCount == (unsigned int)InstBuffer.Size);
+
+    ImVec4 bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (const ImDrawInstance* inst = InstBuffer.Data + InstBuffer.Size - inst_count; inst < InstBuffer.Data + InstBuffer.Size; inst++)
+    {
+        const float pad = (inst->Rounding > 0.0f) ? 1.0f : 0.0f; // Renderer anti-aliases rounded instances outside of their rectangle
+        bounds.x = ImMin(bounds.x, inst->Min.x - pad); bounds.y = ImMin(bounds.y, inst->Min.y - pad);
+        bounds.z = ImMax(bounds.z, inst->Max.x + pad); bounds.w = ImMax(bounds.w, inst->Max.y + pad);
+    }
+    if (!_InstancesOverlapTriangles(bounds))
+        return;
+
+    curr_cmd->InstCount -= inst_count;
+    AddDrawCmd();
+    curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    curr_cmd->InstOffset -= inst_count;
+    curr_cmd->InstCount = inst_count;
+}
+
+// Axis aligned textured rectangle, as one instance when the renderer supports it, else as two triangles.
+void ImDrawList::PrimRectInstanced(const ImVec2& a, const ImVec2& c, const ImVec2& uv_a, const ImVec2& uv_c, ImU32 col)
+{
+    if (Flags & ImDrawListFlags_AllowInstancing)
+    {
+        PrimReserveInstances(1, ImVec4(ImMin(a.x, c.x), ImMin(a.y, c.y), ImMax(a.x, c.x), ImMax(a.y, c.y)));
+        PrimWriteInstance(a, c, uv_a, uv_c, col);
+    }
+    else
+    {
+        PrimReserve(6, 4);
+        PrimRectUV(a, c, uv_a, uv_c, col);
+    }
+}
+
 // Fully unrolled with inline call to keep our debug builds decently fast.
 void ImDrawList::PrimRect(const ImVec2& a, const ImVec2& c, ImU32 col)
 {
@@ -1352,6 +1578,13 @@ static inline ImDrawFlags FixRectCornerFlags(ImDrawFlags flags)
     return flags;
 }
 
+// Convert ImDrawFlags_RoundCornersXXX to the per-corner bytes of ImDrawInstance::Corners
+static inline ImU32 ImDrawInstanceCorners(ImDrawFlags flags)
+{
+    return ((flags & ImDrawFlags_RoundCornersTopLeft) ? 0x000000FF : 0) | ((flags & ImDrawFlags_RoundCornersTopRight) ? 0x0000FF00 : 0) |
+        ((flags & ImDrawFlags_RoundCornersBottomRight) ? 0x00FF0000 : 0) | ((flags & ImDrawFlags_RoundCornersBottomLeft) ? 0xFF000000 : 0);
+}
+
 void ImDrawList::PathRect(const ImVec2& a, const ImVec2& b, float rounding, ImDrawFlags flags)
 {
     flags = FixRectCornerFlags(flags);
@@ -1393,6 +1626,18 @@ void ImDrawList::AddRect(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, fl
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if ((Flags & ImDrawListFlags_AllowInstancing) && thickness == 1.0f && (rounding < 0.5f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone) &&
+        p_min.x == ImFloor(p_min.x) && p_min.y == ImFloor(p_min.y) && p_max.x == ImFloor(p_max.x) && p_max.y == ImFloor(p_max.y) && p_max.x - p_min.x >= 2.0f && p_max.y - p_min.y >= 2.0f)
+    {
+        // Pixel aligned 1 pixel border (e.g. FrameBorderSize): one instance per edge covers the same pixels as the stroked path.
+        const ImVec2 uv = _Data->TexUvWhitePixel;
+        PrimReserveInstances(4, ImVec4(p_min.x, p_min.y, p_max.x, p_max.y));
+        PrimWriteInstance(p_min, ImVec2(p_max.x, p_min.y + 1.0f), uv, uv, col);
+        PrimWriteInstance(ImVec2(p_min.x, p_max.y - 1.0f), p_max, uv, uv, col);
+        PrimWriteInstance(ImVec2(p_min.x, p_min.y + 1.0f), ImVec2(p_min.x + 1.0f, p_max.y - 1.0f), uv, uv, col);
+        PrimWriteInstance(ImVec2(p_max.x - 1.0f, p_min.y + 1.0f), ImVec2(p_max.x, p_max.y - 1.0f), uv, uv, col);
+        return;
+    }
     if (Flags & ImDrawListFlags_AntiAliasedLines)
         PathRect(p_min + ImVec2(0.50f, 0.50f), p_max - ImVec2(0.50f, 0.50f), rounding, flags);
     else
@@ -1406,8 +1651,16 @@ void ImDrawList::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 c
         return;
     if (rounding < 0.5f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
     {
-        PrimReserve(6, 4);
-        PrimRect(p_min, p_max, col);
+        PrimRectInstanced(p_min, p_max, _Data->TexUvWhitePixel, _Data->TexUvWhitePixel, col);
+    }
+    else if ((Flags & ImDrawListFlags_AllowInstancing) && (Flags & ImDrawListFlags_AntiAliasedFill))
+    {
+        // Renderer computes coverage of the rounded corners. Unlike PathRect() a lone rounded corner is also limited to half the size.
+        flags = FixRectCornerFlags(flags);
+        rounding = ImMin(rounding, ImFabs(p_max.x - p_min.x) * 0.5f - 1.0f);
+        rounding = ImMin(rounding, ImFabs(p_max.y - p_min.y) * 0.5f - 1.0f);
+        PrimReserveInstances(1, ImVec4(ImMin(p_min.x, p_max.x) - 1.0f, ImMin(p_min.y, p_max.y) - 1.0f, ImMax(p_min.x, p_max.x) + 1.0f, ImMax(p_min.y, p_max.y) + 1.0f)); // + anti-aliasing
+        PrimWriteInstance(p_min, p_max, _Data->TexUvWhitePixel, _Data->TexUvWhitePixel, col, ImMax(rounding, 0.0f), ImDrawInstanceCorners(flags));
     }
     else
     {
@@ -1507,6 +1760,14 @@ void ImDrawList::AddCircleFilled(const ImVec2& center, float radius, ImU32 col,
     if ((col & IM_COL32_A_MASK) == 0 || radius < 0.5f)
         return;
 
+    if (num_segments <= 0 && (Flags & ImDrawListFlags_AllowInstancing) && (Flags & ImDrawListFlags_AntiAliasedFill))
+    {
+        // Single quad, renderer computes coverage from the distance to the circle
+        PrimReserveInstances(1, ImVec4(center.x - radius - 1.0f, center.y - radius - 1.0f, center.x + radius + 1.0f, center.y + radius + 1.0f)); // + anti-aliasing
+        PrimWriteInstance(ImVec2(center.x - radius, center.y - radius), ImVec2(center.x + radius, center.y + radius), _Data->TexUvWhitePixel, _Data->TexUvWhitePixel, col, radius);
+        return;
+    }
+
     if (num_segments <= 0)
     {
         // Use arc with automatic segment count
@@ -1615,8 +1876,7 @@ void ImDrawList::AddImage(ImTextureID user_texture_id, const ImVec2& p_min, cons
     if (push_texture_id)
         PushTextureID(user_texture_id);
 
-    PrimReserve(6, 4);
-    PrimRectUV(p_min, p_max, uv_min, uv_max, col);
+    PrimRectInstanced(p_min, p_max, uv_min, uv_max, col);
 
     if (push_texture_id)
         PopTextureID();
@@ -1664,6 +1924,83 @@ void ImDrawList::AddImageRounded(ImTextureID user_texture_id, const ImVec2& p_mi
         PopTextureID();
 }
 
+static inline unsigned int ImDrawList_ReadExternalIdx(const ImDrawExternalBuffer* buffer, int n)
+{
+    return (buffer->IdxSize == 2) ? ((const ImU16*)buffer->IdxData)[n] : ((const ImU32*)buffer->IdxData)[n];
+}
+
+static inline void ImDrawList_WriteExternalVtx(ImDrawList* draw_list, const ImDrawExternalBuffer* buffer, unsigned int n)
+{
+    const unsigned char* src = (const unsigned char*)buffer->VtxData + (size_t)n * buffer->VtxStride;
+    ImVec2 pos, uv;
+    ImU32 col;
+    memcpy(&pos, src + buffer->VtxPosOffset, sizeof(pos));
+    memcpy(&uv, src + buffer->VtxUvOffset, sizeof(uv));
+    memcpy(&col, src + buffer->VtxColOffset, sizeof(col));
+    draw_list->PrimWriteVtx(pos, uv, col);
+}
+
+void ImDrawList::AddExternalGeometry(ImDrawExternalBuffer* buffer, ImTextureID user_texture_id, int idx_offset, int idx_count)
+{
+    IM_ASSERT(buffer != NULL && buffer->RefCount > 0);
+    IM_ASSERT(buffer->IdxSize == 2 || buffer->IdxSize == 4);
+    if (idx_count < 0)
+        idx_count = buffer->IdxCount - idx_offset;
+    IM_ASSERT(idx_offset >= 0 && idx_offset + idx_count <= buffer->IdxCount);
+    if (idx_count <= 0)
+        return;
+
+    const bool push_texture_id = user_texture_id != _CmdHeader.TextureId;
+    if (push_texture_id)
+        PushTextureID(user_texture_id);
+
+    if (Flags & ImDrawListFlags_AllowExternalGeometry)
+    {
+        ImDrawExternalGeometry geometry;
+        geometry.Buffer = buffer;
+        geometry.IdxOffset = (unsigned int)idx_offset;
+        geometry.IdxCount = (unsigned int)idx_count;
+        buffer->AddRef();
+        ExternalBuffer.push_back(geometry);
+        AddCallback(ImDrawCallback_ExternalGeometry, (void*)(size_t)(ExternalBuffer.Size - 1));
+    }
+    else
+    {
+        // Renderer can't reference the buffer: copy all vertices and the requested indices
+        IM_ASSERT(buffer->VtxData != NULL && buffer->IdxData != NULL && "Renderer doesn't support ImGuiBackendFlags_RendererHasExternalGeometry, buffer data must be in CPU memory!");
+        if (sizeof(ImDrawIdx) == 2 && buffer->VtxCount >= (1 << 16))
+        {
+            // 16-bit indices can't address all vertices from one VtxOffset: copy a vertex per index instead,
+            // in batches small enough for PrimReserve() to move VtxOffset between them
+            IM_ASSERT((Flags & ImDrawListFlags_AllowVtxOffset) && "Copying more than 64K vertices with 16-bit indices requires ImGuiBackendFlags_RendererHasVtxOffset!");
+            const int batch_max = ((1 << 16) - 1) / 3 * 3;
+            for (int batch_offset = idx_offset; batch_offset < idx_offset + idx_count; batch_offset += batch_max)
+            {
+                const int batch_count = ImMin(batch_max, idx_offset + idx_count - batch_offset);
+                PrimReserve(batch_count, batch_count);
+                for (int n = batch_offset; n < batch_offset + batch_count; n++)
+                {
+                    PrimWriteIdx((ImDrawIdx)_VtxCurrentIdx);
+                    ImDrawList_WriteExternalVtx(this, buffer, ImDrawList_ReadExternalIdx(buffer, n));
+                }
+            }
+        }
+        else
+        {
+            // PrimReserve() moves VtxOffset when needed so that vtx_base + idx fits
+            PrimReserve(idx_count, buffer->VtxCount);
+            const unsigned int vtx_base = _VtxCurrentIdx;
+            for (int n = 0; n < buffer->VtxCount; n++)
+                ImDrawList_WriteExternalVtx(this, buffer, n);
+            for (int n = idx_offset; n < idx_offset + idx_count; n++)
+                PrimWriteIdx((ImDrawIdx)(vtx_base + ImDrawList_ReadExternalIdx(buffer, n)));
+        }
+    }
+
+    if (push_texture_id)
+        PopTextureID();
+}
+
 
 //-----------------------------------------------------------------------------
 // [SECTION] ImDrawListSplitter
@@ -1671,23 +2008,47 @@ void ImDrawList::AddImageRounded(ImTextureID user_texture_id, const ImVec2& p_mi
 // FIXME: This may be a little confusing, trying to be a little too low-level/optimal instead of just doing vector swap..
 //-----------------------------------------------------------------------------
 
+// Leave some room for growth and for text, which over-reserves before trimming.
+static inline int ImDrawListSplitter_CalcIdxRegionSize(int idx_count)
+{
+    return idx_count + (idx_count / 48) * 3 + 64 * 6;
+}
+
+static inline bool ImDrawListSplitter_IsIdxView(const ImVector<ImDrawIdx>& storage, const ImVector<ImDrawIdx>& buf)
+{
+    return buf.Data >= storage.Data && buf.Data < storage.Data + storage.Capacity;
+}
+
+static void ImDrawListSplitter_DetachIdxView(ImVector<ImDrawIdx>& buf)
+{
+    const ImDrawIdx* view = buf.Data;
+    const int size = buf.Size;
+    memset(&buf, 0, sizeof(buf)); // Don't free, the view points within ImDrawListSplitter::_IdxStorage
+    buf.resize(size);
+    if (size > 0)
+        memcpy(buf.Data, view, (size_t)size * sizeof(ImDrawIdx));
+}
+
 void ImDrawListSplitter::ClearFreeMemory()
 {
+    IM_ASSERT(_IdxStorage.Data == NULL && "Missing Merge(), channels are laid out within the draw list index buffer!");
     for (int i = 0; i < _Channels.Size; i++)
     {
         if (i == _Current)
-            memset(&_Channels[i], 0, sizeof(_Channels[i]));  // Current channel is a copy of CmdBuffer/IdxBuffer, don't destruct again
+            memset(&_Channels[i], 0, sizeof(_Channels[i]));  // Current channel is a copy of CmdBuffer/IdxBuffer/InstBuffer, don't destruct again
         _Channels[i]._CmdBuffer.clear();
         _Channels[i]._IdxBuffer.clear();
+        _Channels[i]._InstBuffer.clear();
     }
     _Current = 0;
     _Count = 1;
     _Channels.clear();
+    _IdxCounts.clear();
+    _IdxOrder.clear();
 }
 
 void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
 {
-    IM_UNUSED(draw_list);
     IM_ASSERT(_Current == 0 && _Count <= 1 && "Nested channel splitting is not supported. Please use separate instances of ImDrawListSplitter.");
     int old_channels_count = _Channels.Size;
     if (old_channels_count < channels_count)
@@ -1711,8 +2072,44 @@ void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
         {
             _Channels[i]._CmdBuffer.resize(0);
             _Channels[i]._IdxBuffer.resize(0);
+            _Channels[i]._InstBuffer.resize(0);
         }
     }
+
+    for (int i = 0; i < channels_count; i++)
+        _Channels[i]._Index = i;
+
+    // Lay out channel indices in place within the draw list buffer, using last Merge() counts to size each region.
+    // Channels of a nested splitter use their own buffers, as its channel 0 may already be a region of ours.
+    if (channels_count <= 1 || _IdxCounts.Size == 0 || draw_list->_IdxSplitter != NULL)
+        return;
+    const int idx_start = draw_list->IdxBuffer.Size;
+    int idx_end = idx_start;
+    for (int i = 0; i < channels_count; i++)
+        idx_end += ImDrawListSplitter_CalcIdxRegionSize(i < _IdxCounts.Size ? _IdxCounts[i] : 0);
+    memcpy(&_IdxStorage, &draw_list->IdxBuffer, sizeof(_IdxStorage));
+    if (idx_end > _IdxStorage.Capacity)
+        _IdxStorage.reserve(_IdxStorage._grow_capacity(idx_end));
+
+    // Channel 0 keeps writing after existing indices, draw_list->IdxBuffer is its view (Capacity being its region end).
+    // Other channels follow in the order they were last merged in (e.g. reordered by TableMergeDrawChannels()), new channels last.
+    for (int i = 1; i < channels_count; i++)
+        _Channels[i]._IdxBuffer.clear();
+    int idx_offset = 0;
+    for (int order_n = -1; order_n < ImMax(_IdxOrder.Size, channels_count); order_n++)
+    {
+        const int i = (order_n < 0) ? 0 : (order_n < _IdxOrder.Size) ? _IdxOrder[order_n] : order_n;
+        if (order_n >= 0 && (i == 0 || i >= channels_count))
+            continue;
+        ImVector<ImDrawIdx>& buf = (i == 0) ? draw_list->IdxBuffer : _Channels[i]._IdxBuffer;
+        const int region_size = (i == 0 ? idx_start : 0) + ImDrawListSplitter_CalcIdxRegionSize(i < _IdxCounts.Size ? _IdxCounts[i] : 0);
+        buf.Data = _IdxStorage.Data + idx_offset;
+        buf.Size = (i == 0) ? idx_start : 0;
+        buf.Capacity = region_size;
+        idx_offset += region_size;
+    }
+    draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size;
+    draw_list->_IdxSplitter = this;
 }
 
 void ImDrawListSplitter::Merge(ImDrawList* draw_list)
@@ -1724,53 +2121,127 @@ void ImDrawListSplitter::Merge(ImDrawList* draw_list)
     SetCurrentChannel(draw_list, 0);
     draw_list->_PopUnusedDrawCmd();
 
-    // Calculate our final buffer sizes. Also fix the incorrect IdxOffset values in each command.
+    // Record index counts and merge order to lay out regions at next Split()
+    bool idx_in_place = (_IdxStorage.Data != NULL);
+    _IdxCounts.resize(_Count);
+    _IdxOrder.resize(_Count);
+    for (int i = 0; i < _Count; i++)
+    {
+        const int channel_idx = _Channels[i]._Index;
+        IM_ASSERT(channel_idx >= 0 && channel_idx < _Count);
+        _IdxOrder[i] = channel_idx;
+        _IdxCounts[channel_idx] = (i == 0) ? (idx_in_place ? draw_list->IdxBuffer.Size - _IdxStorage.Size : 0) : _Channels[i]._IdxBuffer.Size;
+    }
+
+    // Hand the index buffer back to the draw list. Indices can stay in place if every channel is still in its region and regions are in merge order.
+    // Otherwise (a channel outgrew its region and got its own buffer, or channels were reordered differently) detach all of them and merge by copying.
+    if (idx_in_place)
+    {
+        int idx_end = 0;
+        for (int i = 0; i < _Count && idx_in_place; i++)
+        {
+            const ImVector<ImDrawIdx>& buf = (i == 0) ? draw_list->IdxBuffer : _Channels[i]._IdxBuffer;
+            if (!ImDrawListSplitter_IsIdxView(_IdxStorage, buf))
+                idx_in_place = false;
+            else if (buf.Size > 0 && buf.Data < _IdxStorage.Data + idx_end)
+                idx_in_place = false;
+            else if (buf.Size > 0)
+                idx_end = (int)(buf.Data - _IdxStorage.Data) + buf.Size;
+        }
+        if (!idx_in_place)
+            for (int i = 1; i < _Count; i++)
+                if (ImDrawListSplitter_IsIdxView(_IdxStorage, _Channels[i]._IdxBuffer))
+                    ImDrawListSplitter_DetachIdxView(_Channels[i]._IdxBuffer);
+        if (ImDrawListSplitter_IsIdxView(_IdxStorage, draw_list->IdxBuffer))
+            draw_list->IdxBuffer.Capacity = _IdxStorage.Capacity;
+        else
+            _IdxStorage.clear();
+        memset(&_IdxStorage, 0, sizeof(_IdxStorage));
+        draw_list->_IdxSplitter = NULL;
+    }
+
+    // Calculate our final buffer sizes. Also fix the incorrect IdxOffset/InstOffset values in each command.
     int new_cmd_buffer_count = 0;
     int new_idx_buffer_count = 0;
+    int new_inst_buffer_count = 0;
     ImDrawCmd* last_cmd = (_Count > 0 && draw_list->CmdBuffer.Size > 0) ? &draw_list->CmdBuffer.back() : NULL;
     int idx_offset = last_cmd ? last_cmd->IdxOffset + last_cmd->ElemCount : 0;
+    int inst_offset = last_cmd ? last_cmd->InstOffset + last_cmd->InstCount : 0;
     for (int i = 1; i < _Count; i++)
     {
         ImDrawChannel& ch = _Channels[i];
-        if (ch._CmdBuffer.Size > 0 && ch._CmdBuffer.back().ElemCount == 0 && ch._CmdBuffer.back().UserCallback == NULL) // Equivalent of PopUnusedDrawCmd()
+        if (ch._CmdBuffer.Size > 0 && ch._CmdBuffer.back().ElemCount == 0 && ch._CmdBuffer.back().InstCount == 0 && ch._CmdBuffer.back().UserCallback == NULL) // Equivalent of PopUnusedDrawCmd()
             ch._CmdBuffer.pop_back();
 
+        // Indices laid out in place stay in their region, fill the gap since previous channel indices with degenerate triangles.
+        int idx_gap = 0;
+        if (idx_in_place && ch._IdxBuffer.Size > 0)
+        {
+            idx_gap = (int)(ch._IdxBuffer.Data - draw_list->IdxBuffer.Data) - idx_offset;
+            memset(draw_list->IdxBuffer.Data + idx_offset, 0, (size_t)idx_gap * sizeof(ImDrawIdx));
+        }
+
         if (ch._CmdBuffer.Size > 0 && last_cmd != NULL)
         {
             // Do not include ImDrawCmd_AreSequentialIdxOffset() in the compare as we rebuild IdxOffset values ourselves.
             // Manipulating IdxOffset (e.g. by reordering draw commands like done by RenderDimmedBackgroundBehindWindow()) is not supported within a splitter.
+            // A command may only span a gap when both sides are triangles adjacent to it.
             ImDrawCmd* next_cmd = &ch._CmdBuffer[0];
-            if (ImDrawCmd_HeaderCompare(last_cmd, next_cmd) == 0 && last_cmd->UserCallback == NULL && next_cmd->UserCallback == NULL)
+            const bool can_span_gap = (idx_gap == 0) || (idx_gap % 3 == 0 && last_cmd->ElemCount > 0 && next_cmd->ElemCount > 0 && last_cmd->IdxOffset + last_cmd->ElemCount == (unsigned int)idx_offset);
+            if (ImDrawCmd_HeaderCompare(last_cmd, next_cmd) == 0 && ImDrawCmd_CanMergeKinds(last_cmd, next_cmd) && last_cmd->UserCallback == NULL && next_cmd->UserCallback == NULL && can_span_gap)
             {
                 // Merge previous channel last draw command with current channel first draw command if matching.
-                last_cmd->ElemCount += next_cmd->ElemCount;
-                idx_offset += next_cmd->ElemCount;
+                last_cmd->ElemCount += idx_gap + next_cmd->ElemCount;
+                last_cmd->InstCount += next_cmd->InstCount;
+                idx_offset += idx_gap + next_cmd->ElemCount;
+                inst_offset += next_cmd->InstCount;
+                idx_gap = 0;
                 ch._CmdBuffer.erase(ch._CmdBuffer.Data); // FIXME-OPT: Improve for multiple merges.
             }
         }
+        idx_offset += idx_gap;
         if (ch._CmdBuffer.Size > 0)
             last_cmd = &ch._CmdBuffer.back();
         new_cmd_buffer_count += ch._CmdBuffer.Size;
         new_idx_buffer_count += ch._IdxBuffer.Size;
+        new_inst_buffer_count += ch._InstBuffer.Size;
         for (int cmd_n = 0; cmd_n < ch._CmdBuffer.Size; cmd_n++)
         {
             ch._CmdBuffer.Data[cmd_n].IdxOffset = idx_offset;
+            ch._CmdBuffer.Data[cmd_n].InstOffset = inst_offset;
             idx_offset += ch._CmdBuffer.Data[cmd_n].ElemCount;
+            inst_offset += ch._CmdBuffer.Data[cmd_n].InstCount;
         }
     }
     draw_list->CmdBuffer.resize(draw_list->CmdBuffer.Size + new_cmd_buffer_count);
-    draw_list->IdxBuffer.resize(draw_list->IdxBuffer.Size + new_idx_buffer_count);
+    if (idx_in_place)
+    {
+        new_idx_buffer_count = 0;
+        draw_list->IdxBuffer.Size = idx_offset;
+    }
+    else
+    {
+        if (draw_list->_IdxSplitter != NULL && draw_list->IdxBuffer.Size + new_idx_buffer_count > draw_list->IdxBuffer.Capacity)
+            draw_list->_IdxSplitter->_DetachIdxBuffer(draw_list);
+        draw_list->IdxBuffer.resize(draw_list->IdxBuffer.Size + new_idx_buffer_count);
+    }
+    draw_list->InstBuffer.resize(draw_list->InstBuffer.Size + new_inst_buffer_count);
 
     // Write commands and indices in order (they are fairly small structures, we don't copy vertices only indices)
     ImDrawCmd* cmd_write = draw_list->CmdBuffer.Data + draw_list->CmdBuffer.Size - new_cmd_buffer_count;
     ImDrawIdx* idx_write = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size - new_idx_buffer_count;
+    ImDrawInstance* inst_write = draw_list->InstBuffer.Data + draw_list->InstBuffer.Size - new_inst_buffer_count;
     for (int i = 1; i < _Count; i++)
     {
         ImDrawChannel& ch = _Channels[i];
         if (int sz = ch._CmdBuffer.Size) { memcpy(cmd_write, ch._CmdBuffer.Data, sz * sizeof(ImDrawCmd)); cmd_write += sz; }
-        if (int sz = ch._IdxBuffer.Size) { memcpy(idx_write, ch._IdxBuffer.Data, sz * sizeof(ImDrawIdx)); idx_write += sz; }
+        if (int sz = ch._InstBuffer.Size) { memcpy(inst_write, ch._InstBuffer.Data, sz * sizeof(ImDrawInstance)); inst_write += sz; }
+        if (idx_in_place)
+            memset(&ch._IdxBuffer, 0, sizeof(ch._IdxBuffer)); // Region of draw_list->IdxBuffer, don't free
+        else if (int sz = ch._IdxBuffer.Size) { memcpy(idx_write, ch._IdxBuffer.Data, sz * sizeof(ImDrawIdx)); idx_write += sz; }
     }
     draw_list->_IdxWritePtr = idx_write;
+    draw_list->_InstWritePtr = inst_write;
 
     // Ensure there's always a non-callback draw command trailing the command-buffer
     if (draw_list->CmdBuffer.Size == 0 || draw_list->CmdBuffer.back().UserCallback != NULL)
@@ -1778,34 +2249,45 @@ void ImDrawListSplitter::Merge(ImDrawList* draw_list)
 
     // If current command is used with different settings we need to add a new command
     ImDrawCmd* curr_cmd = &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1];
-    if (curr_cmd->ElemCount == 0)
-        ImDrawCmd_HeaderCopy(curr_cmd, &draw_list->_CmdHeader); // Copy ClipRect, TextureId, VtxOffset
+    if (curr_cmd->ElemCount == 0 && curr_cmd->InstCount == 0)
+        ImDrawCmd_HeaderCopy(curr_cmd, &draw_list->_CmdHeader); // Copy ClipRect, TextureId, VtxOffset, TransformIdx
     else if (ImDrawCmd_HeaderCompare(curr_cmd, &draw_list->_CmdHeader) != 0)
         draw_list->AddDrawCmd();
+    ImDrawList_ResetTriBounds(draw_list);
 
     _Count = 1;
 }
 
+void ImDrawListSplitter::_DetachIdxBuffer(ImDrawList* draw_list)
+{
+    if (ImDrawListSplitter_IsIdxView(_IdxStorage, draw_list->IdxBuffer))
+        ImDrawListSplitter_DetachIdxView(draw_list->IdxBuffer);
+}
+
 void ImDrawListSplitter::SetCurrentChannel(ImDrawList* draw_list, int idx)
 {
     IM_ASSERT(idx >= 0 && idx < _Count);
     if (_Current == idx)
         return;
 
-    // Overwrite ImVector (12/16 bytes), four times. This is merely a silly optimization instead of doing .swap()
+    // Overwrite ImVector (12/16 bytes), six times. This is merely a silly optimization instead of doing .swap()
     memcpy(&_Channels.Data[_Current]._CmdBuffer, &draw_list->CmdBuffer, sizeof(draw_list->CmdBuffer));
     memcpy(&_Channels.Data[_Current]._IdxBuffer, &draw_list->IdxBuffer, sizeof(draw_list->IdxBuffer));
+    memcpy(&_Channels.Data[_Current]._InstBuffer, &draw_list->InstBuffer, sizeof(draw_list->InstBuffer));
     _Current = idx;
     memcpy(&draw_list->CmdBuffer, &_Channels.Data[idx]._CmdBuffer, sizeof(draw_list->CmdBuffer));
     memcpy(&draw_list->IdxBuffer, &_Channels.Data[idx]._IdxBuffer, sizeof(draw_list->IdxBuffer));
+    memcpy(&draw_list->InstBuffer, &_Channels.Data[idx]._InstBuffer, sizeof(draw_list->InstBuffer));
     draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size;
+    draw_list->_InstWritePtr = draw_list->InstBuffer.Data + draw_list->InstBuffer.Size;
+    ImDrawList_ResetTriBounds(draw_list);
 
     // If current command is used with different settings we need to add a new command
     ImDrawCmd* curr_cmd = (draw_list->CmdBuffer.Size == 0) ? NULL : &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1];
     if (curr_cmd == NULL)
         draw_list->AddDrawCmd();
-    else if (curr_cmd->ElemCount == 0)
-        ImDrawCmd_HeaderCopy(curr_cmd, &draw_list->_CmdHeader); // Copy ClipRect, TextureId, VtxOffset
+    else if (curr_cmd->ElemCount == 0 && curr_cmd->InstCount == 0)
+        ImDrawCmd_HeaderCopy(curr_cmd, &draw_list->_CmdHeader); // Copy ClipRect, TextureId, VtxOffset, TransformIdx
     else if (ImDrawCmd_HeaderCompare(curr_cmd, &draw_list->_CmdHeader) != 0)
         draw_list->AddDrawCmd();
 }
@@ -1822,6 +2304,7 @@ void ImDrawData::DeIndexAllBuffers()
     for (int i = 0; i < CmdListsCount; i++)
     {
         ImDrawList* cmd_list = CmdLists[i];
+        IM_ASSERT(cmd_list->InstBuffer.empty() && "DeIndexAllBuffers() doesn't support instanced commands, don't set ImGuiBackendFlags_RendererHasInstancing!");
         if (cmd_list->IdxBuffer.empty())
             continue;
         new_vtx_buffer.resize(cmd_list->IdxBuffer.Size);
@@ -1849,6 +2332,48 @@ void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
     }
 }
 
+// Helper to bake per-command transforms (ImDrawList::PushTransform) into the geometry, for renderers which can't apply them.
+// Instances and clip rectangles are replaced by their transformed bounding box, which is exact for scale + translation.
+void ImDrawData::ApplyTransforms()
+{
+    ImBitVector transformed_vtx;
+    for (int i = 0; i < CmdListsCount; i++)
+    {
+        ImDrawList* cmd_list = CmdLists[i];
+        if (cmd_list->TransformBuffer.Size == 0)
+            continue;
+        transformed_vtx.Create(cmd_list->VtxBuffer.Size);
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            ImDrawCmd* cmd = &cmd_list->CmdBuffer[cmd_i];
+            if (cmd->TransformIdx == 0)
+                continue;
+            IM_ASSERT(cmd->UserCallback != ImDrawCallback_ExternalGeometry && "External geometry can't be transformed on the CPU, renderer needs ImGuiBackendFlags_RendererHasTransform!");
+            const ImDrawTransform& transform = cmd_list->TransformBuffer[cmd->TransformIdx];
+            for (unsigned int n = 0; n < cmd->ElemCount; n++)
+            {
+                const int vtx_i = (int)(cmd->VtxOffset + cmd_list->IdxBuffer[cmd->IdxOffset + n]);
+                if (transformed_vtx.TestBit(vtx_i))
+                    continue;
+                transformed_vtx.SetBit(vtx_i);
+                cmd_list->VtxBuffer[vtx_i].pos = transform.Apply(cmd_list->VtxBuffer[vtx_i].pos);
+            }
+            const float scale = ImSqrt(ImFabs(transform.AxisX.x * transform.AxisY.y - transform.AxisY.x * transform.AxisX.y));
+            for (unsigned int n = 0; n < cmd->InstCount; n++)
+            {
+                ImDrawInstance& inst = cmd_list->InstBuffer[cmd->InstOffset + n];
+                ImVec4 r = transform.ApplyToRect(ImVec4(inst.Min.x, inst.Min.y, inst.Max.x, inst.Max.y));
+                inst.Min = ImVec2(r.x, r.y);
+                inst.Max = ImVec2(r.z, r.w);
+                inst.Rounding *= scale;
+            }
+            cmd->ClipRect = transform.ApplyToRect(cmd->ClipRect);
+            cmd->TransformIdx = 0;
+        }
+        cmd_list->TransformBuffer.resize(0);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] Helpers ShadeVertsXXX functions
 //-----------------------------------------------------------------------------
@@ -3561,8 +4086,7 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     float scale = (size >= 0.0f) ? (size / FontSize) : 1.0f;
     float x = IM_FLOOR(pos.x);
     float y = IM_FLOOR(pos.y);
-    draw_list->PrimReserve(6, 4);
-    draw_list->PrimRectUV(ImVec2(x + glyph->X0 * scale, y + glyph->Y0 * scale), ImVec2(x + glyph->X1 * scale, y + glyph->Y1 * scale), ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1), col);
+    draw_list->PrimRectInstanced(ImVec2(x + glyph->X0 * scale, y + glyph->Y0 * scale), ImVec2(x + glyph->X1 * scale, y + glyph->Y1 * scale), ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1), col);
 }
 
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
@@ -3620,13 +4144,21 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     if (s == text_end)
         return;
 
-    // Reserve vertices for remaining worse case (over-reserving is useful and easily amortized)
-    const int vtx_count_max = (int)(text_end - s) * 4;
-    const int idx_count_max = (int)(text_end - s) * 6;
+    // Reserve vertices (or instances) for remaining worse case (over-reserving is useful and easily amortized)
+    // Instances are reserved in the current command regardless of its triangles, as glyph bounds are only known once written (see below).
+    const bool use_instances = (draw_list->Flags & ImDrawListFlags_AllowInstancing) != 0;
+    const int vtx_count_max = use_instances ? 0 : (int)(text_end - s) * 4;
+    const int idx_count_max = use_instances ? 0 : (int)(text_end - s) * 6;
+    const int inst_count_max = use_instances ? (int)(text_end - s) : 0;
     const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
-    draw_list->PrimReserve(idx_count_max, vtx_count_max);
+    const int inst_expected_size = draw_list->InstBuffer.Size + inst_count_max;
+    if (use_instances)
+        draw_list->PrimReserveInstances(inst_count_max, ImVec4(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX));
+    else
+        draw_list->PrimReserve(idx_count_max, vtx_count_max);
     ImDrawVert*  vtx_write = draw_list->_VtxWritePtr;
     ImDrawIdx*   idx_write = draw_list->_IdxWritePtr;
+    ImDrawInstance* inst_write = draw_list->_InstWritePtr;
     unsigned int vtx_index = draw_list->_VtxCurrentIdx;
 
     const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
@@ -3725,6 +4257,14 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
                 ImU32 glyph_col = glyph->Colored ? col_untinted : col;
 
                 // We are NOT calling PrimRectUV() here because non-inlined causes too much overhead in a debug builds. Inlined here:
+                if (use_instances)
+                {
+                    inst_write->Min.x = x1; inst_write->Min.y = y1; inst_write->Max.x = x2; inst_write->Max.y = y2;
+                    inst_write->UvMin.x = u1; inst_write->UvMin.y = v1; inst_write->UvMax.x = u2; inst_write->UvMax.y = v2;
+                    inst_write->Col = glyph_col; inst_write->Rounding = 0.0f; inst_write->Corners = 0xFFFFFFFF;
+                    inst_write++;
+                }
+                else
                 {
                     vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
                     vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
@@ -3742,6 +4282,14 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     }
 
     // Give back unused vertices (clipped ones, blanks) ~ this is essentially a PrimUnreserve() action.
+    if (use_instances)
+    {
+        draw_list->InstBuffer.Size = (int)(inst_write - draw_list->InstBuffer.Data); // Same as calling shrink()
+        draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].InstCount -= (inst_expected_size - draw_list->InstBuffer.Size);
+        draw_list->_InstWritePtr = inst_write;
+        draw_list->_SplitOverlappingInstances(draw_list->InstBuffer.Size - (inst_expected_size - inst_count_max));
+        return;
+    }
     draw_list->VtxBuffer.Size = (int)(vtx_write - draw_list->VtxBuffer.Data); // Same as calling shrink()
     draw_list->IdxBuffer.Size = (int)(idx_write - draw_list->IdxBuffer.Data);
     draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
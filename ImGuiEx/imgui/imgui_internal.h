@@ -1147,6 +1147,7 @@ enum ImGuiNextWindowDataFlags_
     ImGuiNextWindowDataFlags_HasViewport        = 1 << 8,
     ImGuiNextWindowDataFlags_HasDock            = 1 << 9,
     ImGuiNextWindowDataFlags_HasWindowClass     = 1 << 10,
+    ImGuiNextWindowDataFlags_HasWindow          = 1 << 11,  // Begin() uses 'Window' instead of looking up its name. Set by ImGuiWindowHandle overloads.
 };
 
 // Storage for SetNexWindow** functions
@@ -1171,6 +1172,7 @@ struct ImGuiNextWindowData
     ImGuiID                     ViewportId;
     ImGuiID                     DockId;
     ImGuiWindowClass            WindowClass;
+    ImGuiWindow*                Window;
     ImVec2                      MenuBarOffsetMinVal;    // (Always on) This is not exposed publicly, so we don't clear it and it doesn't have a corresponding flag (could we? for consistency?)
 
     ImGuiNextWindowData()       { memset(this, 0, sizeof(*this)); }
@@ -1234,6 +1236,22 @@ struct ImGuiWindowStackData
     ImGuiStackSizes         StackSizesOnBegin;      // Store size of various stacks for asserting
 };
 
+// Uniform grid over window hit-test rectangles (OuterRectClipped + hover padding), updated by Begin() when a rectangle changes.
+// FindHoveredWindow() only tests the windows stored in the cell under the mouse, plus the oversized ones.
+struct ImGuiWindowHitGrid
+{
+    ImGuiStorage                        CellMap;            // Cell key -> index into Cells[] + 1
+    ImVector<ImVector<ImGuiWindow*> >   Cells;
+    int                                 CellsUsedCount;     // Number of Cells[] storing at least one window, the others were left by windows moving away
+    ImVector<ImGuiWindow*>              Oversized;          // Windows covering too many cells, tested by every query
+    ImVector<ImGuiWindow*>              Candidates;         // Temporary buffer for FindHoveredWindow()
+    ImVec2                              Padding;            // Stored rectangles are expanded by this, they are all stored again when it changes
+    bool                                DisplayIndexDirty;  // Set when g.Windows order changed since ImGuiWindow::DisplayIndex were updated
+
+    ImGuiWindowHitGrid()    { CellsUsedCount = 0; DisplayIndexDirty = true; }
+    ~ImGuiWindowHitGrid()   { Cells.clear_destruct(); }
+};
+
 struct ImGuiShrinkWidthItem
 {
     int         Index;
@@ -1963,9 +1981,18 @@ struct ImGuiContext
     ImVector<ImGuiWindow*>  Windows;                            // Windows, sorted in display order, back to front
     ImVector<ImGuiWindow*>  WindowsFocusOrder;                  // Root windows, sorted in focus order, back to front.
     ImVector<ImGuiWindow*>  WindowsTempSortBuffer;              // Temporary buffer used in EndFrame() to reorder windows so parents are kept before their child
+    bool                    WindowsSortDirty;                   // Set when g.Windows order or a list of child windows changed, EndFrame() only sorts g.Windows again when set
+    int                     WindowsSortActivatedCount;          // Number of windows submitted this frame which were not active on the previous frame
+    int                     WindowsSortChildCount;              // Number of child windows submitted this frame
+    int                     WindowsSortActiveCountPrev;         // Number of active windows at the end of the previous frame
+    int                     WindowsSortChildCountPrev;
+    ImVector<ImGuiWindow*>  WindowsTempOccluders;               // Temporary buffer used in NewFrame() to collect opaque windows for occlusion culling
     ImVector<ImGuiWindowStackData> CurrentWindowStack;
     ImGuiStorage            WindowsById;                        // Map window's ImGuiID to ImGuiWindow*
+    ImU32                   WindowHandleSerial;                 // Unique to this context while its windows are alive, an ImGuiWindowHandle with another serial is stale
+    ImGuiWindowHitGrid      WindowsHitGrid;                     // Spatial index for FindHoveredWindow()
     int                     WindowsActiveCount;                 // Number of unique windows submitted by frame
+    int                     WindowsCulledCount;                 // Number of submitted windows which skipped their items due to occlusion culling
     ImVec2                  WindowsHoverPadding;                // Padding around resizable windows for which hovering on counts as hovering the window == ImMax(style.TouchExtraPadding, WINDOWS_HOVER_PADDING)
     ImGuiWindow*            CurrentWindow;                      // Window being drawn into
     ImGuiWindow*            HoveredWindow;                      // Window the mouse is hovering. Will typically catch mouse inputs.
@@ -2261,6 +2288,10 @@ struct ImGuiContext
         InputEventsNextMouseSource = ImGuiMouseSource_Mouse;
         InputEventsNextEventId = 1;
 
+        WindowHandleSerial = 0;
+        WindowsSortDirty = true;
+        WindowsSortActivatedCount = WindowsSortChildCount = 0;
+        WindowsSortActiveCountPrev = WindowsSortChildCountPrev = 0;
         WindowsActiveCount = 0;
         CurrentWindow = NULL;
         HoveredWindow = NULL;
@@ -2463,6 +2494,7 @@ struct IMGUI_API ImGuiWindowTempData
     int                     TreeDepth;              // Current tree depth.
     ImU32                   TreeJumpToParentOnPopMask; // Store a copy of !g.NavIdIsAlive for TreeDepth 0..31.. Could be turned into a ImU64 if necessary.
     ImVector<ImGuiWindow*>  ChildWindows;
+    int                     ChildWindowsCountPrev;  // ChildWindows.Size on the previous frame, used to detect changes in the list
     ImGuiStorage*           StateStorage;           // Current persistent per-window storage (store e.g. tree node open/close state)
     ImGuiOldColumns*        CurrentColumns;         // Current columns set
     int                     CurrentTableIdx;        // Current table index (into g.Tables)
@@ -2524,6 +2556,10 @@ struct IMGUI_API ImGuiWindow
     bool                    IsFallbackWindow;                   // Set on the "Debug##Default" window.
     bool                    IsExplicitChild;                    // Set when passed _ChildWindow, left to false by BeginDocked()
     bool                    HasCloseButton;                     // Set when the window has a close button (p_open != NULL)
+    bool                    IsBgOpaque;                         // Set when the window background was rendered fully opaque, allowing it to occlude windows behind it.
+    bool                    OcclusionCulled;                    // Set in NewFrame() when the window was fully covered by opaque windows on the previous frame.
+    bool                    SkipItemsOccluded;                  // Set when SkipItems was forced by occlusion culling. Content sizes are preserved while set.
+    signed char             OccluderFrames;                     // Number of consecutive previous frames (up to 2) the window was opaque over OccluderRect. Only trusted as an occluder from 2.
     signed char             ResizeBorderHeld;                   // Current border being held for resize (-1: none, otherwise 0-3)
     short                   BeginCount;                         // Number of Begin() during the current frame (generally 0 or 1, 1+ if appending via multiple Begin/End pairs)
     short                   BeginCountPreviousFrame;            // Number of Begin() during the previous frame
@@ -2552,6 +2588,7 @@ struct IMGUI_API ImGuiWindow
     // The best way to understand what those rectangles are is to use the 'Metrics->Tools->Show Windows Rectangles' viewer.
     // The main 'OuterRect', omitted as a field, is window->Rect().
     ImRect                  OuterRectClipped;                   // == Window->Rect() just after setup in Begin(). == window->Rect() for root window.
+    ImRect                  OccluderRect;                       // Area covered by the opaque background on the previous frame (see UpdateWindowsOcclusionCulling())
     ImRect                  InnerRect;                          // Inner rectangle (omit title bar, menu bar, scroll bar)
     ImRect                  InnerClipRect;                      // == InnerRect shrunk by WindowPadding*0.5f on each side, clipped within viewport or parent clip rect.
     ImRect                  WorkRect;                           // Initially covers the whole scrolling region. Reduced by containers e.g columns/tables when active. Shrunk by WindowPadding*1.0f on each side. This is meant to replace ContentRegionRect over time (from 1.71+ onward).
@@ -2560,6 +2597,10 @@ struct IMGUI_API ImGuiWindow
     ImRect                  ContentRegionRect;                  // FIXME: This is currently confusing/misleading. It is essentially WorkRect but not handling of scrolling. We currently rely on it as right/bottom aligned sizing operation need some size to rely on.
     ImVec2ih                HitTestHoleSize;                    // Define an optional rectangular hole where mouse will pass-through the window.
     ImVec2ih                HitTestHoleOffset;
+    ImVec2ih                HitGridCellMin, HitGridCellMax;     // Cells of g.WindowsHitGrid this window is stored in
+    ImS8                    HitGridState;                       // 0: not stored in g.WindowsHitGrid, 1: stored in cells, 2: stored in Oversized
+    int                     DisplayIndex;                       // Index in g.Windows, refreshed by FindHoveredWindow() when the display order changed
+    int                     DisplaySubtreeSize;                 // Number of windows from this one in g.Windows which EndFrame() sorted together: this window followed by its active child windows
 
     int                     LastFrameActive;                    // Last frame number the window was Active.
     int                     LastFrameJustFocused;               // Last frame number the window was made Focused.
@@ -3424,10 +3465,12 @@ namespace ImGui
     // Widgets
     IMGUI_API void          TextEx(const char* text, const char* text_end = NULL, ImGuiTextFlags flags = 0);
     IMGUI_API bool          ButtonEx(const char* label, const ImVec2& size_arg = ImVec2(0, 0), ImGuiButtonFlags flags = 0);
+    IMGUI_API bool          ButtonEx(ImGuiID id, const char* label, const ImVec2& size_arg, ImGuiButtonFlags flags);   // Use given 'id' instead of hashing 'label'
     IMGUI_API bool          ArrowButtonEx(const char* str_id, ImGuiDir dir, ImVec2 size_arg, ImGuiButtonFlags flags = 0);
     IMGUI_API bool          ImageButtonEx(ImGuiID id, ImTextureID texture_id, const ImVec2& size, const ImVec2& uv0, const ImVec2& uv1, const ImVec4& bg_col, const ImVec4& tint_col, ImGuiButtonFlags flags = 0);
     IMGUI_API void          SeparatorEx(ImGuiSeparatorFlags flags);
     IMGUI_API void          SeparatorTextEx(ImGuiID id, const char* label, const char* label_end, float extra_width);
+    IMGUI_API bool          CheckboxEx(ImGuiID id, const char* label, bool* v);
     IMGUI_API bool          CheckboxFlags(const char* label, ImS64* flags, ImS64 flags_value);
     IMGUI_API bool          CheckboxFlags(const char* label, ImU64* flags, ImU64 flags_value);
 
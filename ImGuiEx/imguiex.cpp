@@ -1,46 +1,1955 @@
 #include "imguiex.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+
 #define GLAD_GL_IMPLEMENTATION
 
-#include <glad/gl.h>
-#include <GLFW/glfw3.h>
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+
+#include <backends/imgui_impl_glfw.h>
+#include <backends/imgui_impl_offscreen.h>
+#include <backends/imgui_impl_opengl3.h>
+
+#include <imgui_internal.h>
+
+// Own static copy of stb_rect_pack, imgui_draw.cpp keeps its copy static too
+#ifdef _MSC_VER
+#pragma warning (push)
+#pragma warning (disable: 6011)                             // (stb_rectpack) Dereferencing NULL pointer 'cur->next'.
+#pragma warning (disable: 28182)                            // (stb_rectpack) Dereferencing NULL pointer. 'cur' contains the same NULL value as 'cur->next' did.
+#endif
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-function"        // stbrp_setup_heuristic() isn't used
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"          // stbrp_setup_heuristic() isn't used
+#endif
+
+#define STBRP_STATIC
+#define STBRP_ASSERT(x) IM_ASSERT(x)
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <imstb_rectpack.h>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+#ifdef _MSC_VER
+#pragma warning (pop)
+#endif
+
+// stb_image.h isn't bundled, put it on the include path to load PNG, JPEG, BMP... QOI is always supported
+#if __has_include(<stb_image.h>)
+#define IMGUIEX_HAS_STB_IMAGE
+#ifndef IMGUIEX_STB_IMAGE_EXTERNAL
+#define STBI_ASSERT(x) IM_ASSERT(x)
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#endif
+#include <stb_image.h>
+#endif
+
+namespace ImGuiEx
+{
+    static bool Overlaps(const ImVec4& a, const ImVec4& b)
+    {
+        return a.x < b.z && b.x < a.z && a.y < b.w && b.y < a.w;
+    }
+
+    static ImVec4 Intersect(const ImVec4& a, const ImVec4& b)
+    {
+        return ImVec4(ImMax(a.x, b.x), ImMax(a.y, b.y), ImMin(a.z, b.z), ImMin(a.w, b.w));
+    }
+
+    // Cached window images hold premultiplied colors, they are composited with this blend state
+    static void PremultipliedBlendCallback(const ImDrawList*, const ImDrawCmd*)
+    {
+        glBlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    ImGuiID Label::Combine(ImGuiID seed) const
+    {
+        // XORs the contributions of the set bits of the inverted seed, four bits per step with SSE2
+        const uint32_t state = ~seed;
+#if defined(IMGUI_ENABLE_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+        const __m128i broadcast = _mm_set1_epi32(static_cast<int>(state));
+        __m128i bits = _mm_set_epi32(0x10000000, 0x20000000, 0x40000000, static_cast<int>(0x80000000u));
+        __m128i sum = _mm_setzero_si128();
+        for (int bit = 0; bit < 32; bit += 4, bits = _mm_srli_epi32(bits, 4))
+        {
+            const __m128i mask = _mm_cmpeq_epi32(_mm_and_si128(broadcast, bits), bits);
+            sum = _mm_xor_si128(sum, _mm_and_si128(mask, _mm_loadu_si128(reinterpret_cast<const __m128i*>(seedBits + bit))));
+        }
+        sum = _mm_xor_si128(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_xor_si128(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        const uint32_t shifted = static_cast<uint32_t>(_mm_cvtsi128_si32(sum));
+#else
+        uint32_t shifted = 0;
+        for (int bit = 0; bit < 32; bit++)
+            shifted ^= seedBits[bit] & (0u - ((state >> (31 - bit)) & 1));
+#endif
+        return ~(shifted ^ hash);
+    }
+
+    ImGuiID GetID(const Label& label)
+    {
+        ImGuiContext& g = *GImGui;
+        const ImGuiID id = label.Combine(g.CurrentWindow->IDStack.back());
+        if (g.DebugHookIdInfo == id)
+            ImGui::DebugHookIdInfo(id, ImGuiDataType_String, label.text, nullptr);
+        return id;
+    }
+
+    void PushID(const Label& label)
+    {
+        ImGuiWindow* window = ImGui::GetCurrentWindow();
+        window->IDStack.push_back(GetID(label));
+    }
+
+    bool Button(const Label& label, const ImVec2& size)
+    {
+        if (ImGui::GetCurrentWindow()->SkipItems)
+            return false;
+        return ImGui::ButtonEx(GetID(label), label.text, size, ImGuiButtonFlags_None);
+    }
+
+    bool Checkbox(const Label& label, bool* v)
+    {
+        if (ImGui::GetCurrentWindow()->SkipItems)
+            return false;
+        return ImGui::CheckboxEx(GetID(label), label.text, v);
+    }
+
+    bool TreeNode(const Label& label)
+    {
+        if (ImGui::GetCurrentWindow()->SkipItems)
+            return false;
+        return ImGui::TreeNodeBehavior(GetID(label), 0, label.text);
+    }
+
+    bool CollapsingHeader(const Label& label, ImGuiTreeNodeFlags flags)
+    {
+        if (ImGui::GetCurrentWindow()->SkipItems)
+            return false;
+        return ImGui::TreeNodeBehavior(GetID(label), flags | ImGuiTreeNodeFlags_CollapsingHeader, label.text);
+    }
+
+    bool DamageTracker::Update(const ImDrawData* drawData)
+    {
+        const ImVec4 bounds(drawData->DisplayPos.x, drawData->DisplayPos.y,
+            drawData->DisplayPos.x + drawData->DisplaySize.x, drawData->DisplayPos.y + drawData->DisplaySize.y);
+
+        bool full = m_invalid || bounds.x != m_bounds.x || bounds.y != m_bounds.y || bounds.z != m_bounds.z || bounds.w != m_bounds.w;
+        m_bounds = bounds;
+        m_invalid = false;
+
+        m_current.clear();
+        m_rects.clear();
+        m_transformed.clear();
+
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+        {
+            const ImDrawList* list = drawData->CmdLists[n];
+
+            for (const ImDrawCmd& cmd : list->CmdBuffer)
+            {
+                if (cmd.UserCallback == ImDrawCallback_ExternalGeometry)
+                {
+                    // External buffers may change without notice, so the clipped area is damaged every frame
+                    const ImDrawTransform transform = cmd.TransformIdx ? list->TransformBuffer[cmd.TransformIdx] : ImDrawTransform();
+                    const ImGuiID hash = ImHashData(&cmd.ClipRect, sizeof(cmd.ClipRect), static_cast<ImGuiID>(ImGui::GetFrameCount()));
+                    m_current.push_back({ hash, transform.ApplyToRect(cmd.ClipRect) });
+                    if (cmd.TransformIdx != 0)
+                        m_transformed.push_back(m_current.back().rect);
+                    continue;
+                }
+                if (cmd.UserCallback != nullptr)
+                {
+                    // Callback output can't be diffed, so it damages everything
+                    full |= cmd.UserCallback != ImDrawCallback_ResetRenderState && cmd.UserCallback != PremultipliedBlendCallback;
+                    continue;
+                }
+
+                // Geometry and clip rect are local to the command transform, compare them as such and damage the screen area
+                const ImDrawTransform transform = cmd.TransformIdx ? list->TransformBuffer[cmd.TransformIdx] : ImDrawTransform();
+                ImVec4 drawn(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+                if (cmd.InstCount != 0)
+                {
+                    // Instanced rectangles carry absolute positions, no rebasing needed
+                    const ImDrawInstance* inst = list->InstBuffer.Data + cmd.InstOffset;
+
+                    ImVec4 rect(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+                    for (unsigned int i = 0; i < cmd.InstCount; i++)
+                    {
+                        // Rounded instances get a 1 pixel antialiasing fringe from the renderer
+                        const float pad = inst[i].Rounding > 0.0f ? 1.0f : 0.0f;
+                        rect.x = ImMin(rect.x, inst[i].Min.x - pad);
+                        rect.y = ImMin(rect.y, inst[i].Min.y - pad);
+                        rect.z = ImMax(rect.z, inst[i].Max.x + pad);
+                        rect.w = ImMax(rect.w, inst[i].Max.y + pad);
+                    }
+
+                    // A command may also hold triangles, drawn after its instances: hash those separately below
+                    rect = Intersect(rect, cmd.ClipRect);
+                    if (rect.z > rect.x && rect.w > rect.y)
+                    {
+                        ImGuiID hash = ImHashData(&cmd.ClipRect, sizeof(cmd.ClipRect));
+                        hash = ImHashData(&cmd.TextureId, sizeof(cmd.TextureId), hash);
+                        hash = ImHashData(&transform, sizeof(transform), hash);
+                        hash = ImHashData(inst, cmd.InstCount * sizeof(ImDrawInstance), hash);
+
+                        m_current.push_back({ hash, transform.ApplyToRect(rect) });
+                        drawn = m_current.back().rect;
+                    }
+                }
+
+                if (cmd.ElemCount != 0)
+                {
+                    // Rebase indices so that commands shifted inside the vertex buffer still compare equal
+                    const ImDrawIdx* idx = list->IdxBuffer.Data + cmd.IdxOffset;
+                    const ImDrawVert* vtx = list->VtxBuffer.Data + cmd.VtxOffset;
+
+                    ImDrawIdx first = idx[0], last = idx[0];
+                    for (unsigned int i = 1; i < cmd.ElemCount; i++)
+                    {
+                        first = ImMin(first, idx[i]);
+                        last = ImMax(last, idx[i]);
+                    }
+
+                    m_indices.resize(static_cast<int>(cmd.ElemCount));
+                    for (unsigned int i = 0; i < cmd.ElemCount; i++)
+                        m_indices[i] = static_cast<ImDrawIdx>(idx[i] - first);
+
+                    ImVec4 rect(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+                    for (int i = first; i <= last; i++)
+                    {
+                        rect.x = ImMin(rect.x, vtx[i].pos.x);
+                        rect.y = ImMin(rect.y, vtx[i].pos.y);
+                        rect.z = ImMax(rect.z, vtx[i].pos.x);
+                        rect.w = ImMax(rect.w, vtx[i].pos.y);
+                    }
+
+                    rect = Intersect(rect, cmd.ClipRect);
+                    if (rect.z > rect.x && rect.w > rect.y)
+                    {
+                        ImGuiID hash = ImHashData(&cmd.ClipRect, sizeof(cmd.ClipRect));
+                        hash = ImHashData(&cmd.TextureId, sizeof(cmd.TextureId), hash);
+                        hash = ImHashData(&transform, sizeof(transform), hash);
+                        hash = ImHashData(m_indices.Data, m_indices.size_in_bytes(), hash);
+                        hash = ImHashData(vtx + first, (last - first + 1) * sizeof(ImDrawVert), hash);
+
+                        m_current.push_back({ hash, transform.ApplyToRect(rect) });
+                        drawn = ImVec4(ImMin(drawn.x, m_current.back().rect.x), ImMin(drawn.y, m_current.back().rect.y), ImMax(drawn.z, m_current.back().rect.z), ImMax(drawn.w, m_current.back().rect.w));
+                    }
+                }
+
+                if (cmd.TransformIdx != 0)
+                    m_transformed.push_back(drawn);
+            }
+        }
+
+        if (full)
+        {
+            std::swap(m_previous, m_current);
+            m_rects.push_back(m_bounds);
+            return true;
+        }
+
+        // Match commands by content, unmatched or reordered ones damage their area in both frames
+        m_sorted.resize(m_previous.size());
+        for (size_t i = 0; i < m_previous.size(); i++)
+            m_sorted[i] = { m_previous[i].hash, static_cast<int>(i) };
+        std::sort(m_sorted.begin(), m_sorted.end());
+
+        m_matched.assign(m_previous.size(), false);
+        int lastMatched = -1;
+
+        for (const Entry& entry : m_current)
+        {
+            auto it = std::lower_bound(m_sorted.begin(), m_sorted.end(), std::make_pair(entry.hash, 0));
+            while (it != m_sorted.end() && it->first == entry.hash && m_matched[it->second])
+                ++it;
+
+            if (it == m_sorted.end() || it->first != entry.hash)
+            {
+                AddRect(entry.rect);
+                continue;
+            }
+
+            m_matched[it->second] = true;
+            if (it->second < lastMatched)
+                AddRect(entry.rect);
+            else
+                lastMatched = it->second;
+        }
+
+        for (size_t i = 0; i < m_previous.size(); i++)
+            if (!m_matched[i])
+                AddRect(m_previous[i].rect);
+
+        // Transformed commands can't be clipped to a damaged rectangle (see Clip()), they are redrawn whole or not at all
+        for (bool grown = !m_rects.empty(); grown;)
+        {
+            grown = false;
+            for (const ImVec4& drawn : m_transformed)
+                for (const ImVec4& rect : m_rects)
+                {
+                    const ImVec4 visible = Intersect(drawn, m_bounds);
+                    if (Overlaps(visible, rect) && (visible.x < rect.x || visible.y < rect.y || visible.z > rect.z || visible.w > rect.w))
+                    {
+                        AddRect(visible);
+                        grown = true;
+                        break;
+                    }
+                }
+        }
+
+        std::swap(m_previous, m_current);
+        return !m_rects.empty();
+    }
+
+    void DamageTracker::Invalidate()
+    {
+        m_invalid = true;
+    }
+
+    void DamageTracker::Clip(ImDrawData* drawData, const ImVec4& rect)
+    {
+        m_clipRects.clear();
+        size_t transformed = 0;
+
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+        {
+            for (ImDrawCmd& cmd : drawData->CmdLists[n]->CmdBuffer)
+            {
+                m_clipRects.push_back(cmd.ClipRect);
+                if (cmd.TransformIdx != 0 && (cmd.UserCallback == nullptr || cmd.UserCallback == ImDrawCallback_ExternalGeometry))
+                {
+                    // The clip rect is in local space, and its screen bounds may exceed 'rect' once rotated. Update() made sure
+                    // the drawn area is either within 'rect' or away from it: draw the command unclipped, or skip it.
+                    if (!Overlaps(m_transformed[transformed++], rect))
+                        cmd.ClipRect = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+                    continue;
+                }
+                cmd.ClipRect = Intersect(cmd.ClipRect, rect);
+            }
+        }
+    }
+
+    void DamageTracker::Restore(ImDrawData* drawData)
+    {
+        size_t i = 0;
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+            for (ImDrawCmd& cmd : drawData->CmdLists[n]->CmdBuffer)
+                cmd.ClipRect = m_clipRects[i++];
+    }
+
+    const std::vector<ImVec4>& DamageTracker::GetRects() const
+    {
+        return m_rects;
+    }
+
+    void DamageTracker::AddRect(const ImVec4& rect)
+    {
+        // Snap to whole pixels so that antialiased edges are fully redrawn
+        ImVec4 merged(ImFloor(rect.x) - 1.0f, ImFloor(rect.y) - 1.0f, ImCeil(rect.z) + 1.0f, ImCeil(rect.w) + 1.0f);
+        merged = Intersect(merged, m_bounds);
+        if (merged.z <= merged.x || merged.w <= merged.y)
+            return;
+
+        // Absorb overlapping rectangles until the set is disjoint
+        for (size_t i = 0; i < m_rects.size();)
+        {
+            if (Overlaps(m_rects[i], merged))
+            {
+                merged = ImVec4(ImMin(merged.x, m_rects[i].x), ImMin(merged.y, m_rects[i].y), ImMax(merged.z, m_rects[i].z), ImMax(merged.w, m_rects[i].w));
+                m_rects.erase(m_rects.begin() + i);
+                i = 0;
+            }
+            else
+            {
+                i++;
+            }
+        }
+
+        m_rects.push_back(merged);
+
+        // Each rectangle costs a full draw data submission, past a few of them a single pass is cheaper
+        const size_t maxRects = 8;
+        if (m_rects.size() > maxRects)
+        {
+            ImVec4 bounds = m_rects[0];
+            for (const ImVec4& r : m_rects)
+                bounds = ImVec4(ImMin(bounds.x, r.x), ImMin(bounds.y, r.y), ImMax(bounds.z, r.z), ImMax(bounds.w, r.w));
+            m_rects.assign(1, bounds);
+        }
+    }
+
+    WindowCache::WindowCache(bool interactive)
+        : m_interactive(interactive)
+    {
+    }
+
+    WindowCache::~WindowCache()
+    {
+        if (m_list)
+            IM_DELETE(m_list);
+
+        if (m_framebuffer)
+        {
+            glDeleteFramebuffers(1, &m_framebuffer);
+            glDeleteTextures(1, &m_texture);
+        }
+    }
+
+    bool WindowCache::Begin(const char* name, bool* open, ImGuiWindowFlags flags)
+    {
+        const bool visible = ImGui::Begin(name, open, flags);
+        m_live = true;
+        if (!visible)
+            return false;
+
+        ImGuiContext& g = *GImGui;
+        ImGuiWindow* window = g.CurrentWindow;
+
+        // Image is only valid for the same visible area, scrolling and pixel density. Moving the window is fine.
+        const ImRect& rect = window->InnerClipRect;
+        const ImVec2 size = rect.GetSize();
+        const ImVec2 offset(rect.Min.x - window->Pos.x, rect.Min.y - window->Pos.y);
+        const ImVec2 scale = g.IO.DisplayFramebufferScale;
+        if (size.x != m_size.x || size.y != m_size.y || offset.x != m_offset.x || offset.y != m_offset.y ||
+            window->Scroll.x != m_scroll.x || window->Scroll.y != m_scroll.y || scale.x != m_scale.x || scale.y != m_scale.y)
+        {
+            m_size = size;
+            m_offset = offset;
+            m_scroll = window->Scroll;
+            m_scale = scale;
+            m_invalid = true;
+        }
+
+        const bool interacting = m_interactive && (ImGui::IsWindowHovered(ImGuiHoveredFlags_ChildWindows) || (g.ActiveId != 0 && g.ActiveIdWindow == window));
+        if (m_invalid || interacting || !m_captured || size.x <= 0.0f || size.y <= 0.0f)
+        {
+            m_invalid = false;
+            m_captured = false;
+
+            // Content starts after the decorations already in the draw list
+            m_cmdStart = window->DrawList->CmdBuffer.Size - 1;
+            m_idxStart = window->DrawList->IdxBuffer.Size;
+            m_instStart = window->DrawList->InstBuffer.Size;
+            m_rect = rect.ToVec4();
+
+            // Contents are likely to change again next frame while interacting, don't bother capturing them
+            m_live = !interacting;
+            return true;
+        }
+
+        if (!m_rendered)
+            Render();
+
+        ImDrawList* drawList = window->DrawList;
+        drawList->AddCallback(PremultipliedBlendCallback, nullptr);
+        drawList->AddImage(reinterpret_cast<ImTextureID>(static_cast<intptr_t>(m_texture)), rect.Min, rect.Max, ImVec2(0.0f, 1.0f), ImVec2(1.0f, 0.0f));
+        drawList->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+
+        // Keep scrolling range and auto-resize as if contents were submitted
+        window->DC.CursorMaxPos = ImMax(window->DC.CursorMaxPos, ImVec2(window->DC.CursorStartPos.x + m_contentSize.x, window->DC.CursorStartPos.y + m_contentSize.y));
+        window->DC.IdealMaxPos = ImMax(window->DC.IdealMaxPos, ImVec2(window->DC.CursorStartPos.x + m_idealSize.x, window->DC.CursorStartPos.y + m_idealSize.y));
+
+        m_live = false;
+        return false;
+    }
+
+    void WindowCache::End()
+    {
+        ImGuiWindow* window = GImGui->CurrentWindow;
+        if (m_live && !window->SkipItems)
+            Capture(window);
+        m_live = false;
+
+        ImGui::End();
+    }
+
+    void WindowCache::Invalidate()
+    {
+        m_invalid = true;
+    }
+
+    bool WindowCache::IsCached() const
+    {
+        return m_captured && !m_invalid;
+    }
+
+    void WindowCache::Capture(ImGuiWindow* window)
+    {
+        const ImDrawList* source = window->DrawList;
+        if (!m_list)
+            m_list = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+
+        // Whole buffers are copied, commands are trimmed to the range submitted since Begin()
+        m_list->CmdBuffer.resize(0);
+        m_list->VtxBuffer = source->VtxBuffer;
+        m_list->IdxBuffer = source->IdxBuffer;
+        m_list->InstBuffer = source->InstBuffer;
+        m_list->TransformBuffer = source->TransformBuffer;
+
+        // External geometry is referenced, keep the buffers alive as long as the cache uses them
+        for (ImDrawExternalGeometry& geometry : m_list->ExternalBuffer)
+            geometry.Buffer->Release();
+        m_list->ExternalBuffer = source->ExternalBuffer;
+        for (ImDrawExternalGeometry& geometry : m_list->ExternalBuffer)
+            geometry.Buffer->AddRef();
+
+        for (int n = m_cmdStart; n < source->CmdBuffer.Size; n++)
+        {
+            ImDrawCmd cmd = source->CmdBuffer[n];
+            if (cmd.IdxOffset < static_cast<unsigned int>(m_idxStart))
+            {
+                cmd.ElemCount -= ImMin(cmd.ElemCount, m_idxStart - cmd.IdxOffset);
+                cmd.IdxOffset = m_idxStart;
+            }
+            if (cmd.InstOffset < static_cast<unsigned int>(m_instStart))
+            {
+                cmd.InstCount -= ImMin(cmd.InstCount, m_instStart - cmd.InstOffset);
+                cmd.InstOffset = m_instStart;
+            }
+            if (cmd.ElemCount != 0 || cmd.InstCount != 0 || cmd.UserCallback != nullptr)
+                m_list->CmdBuffer.push_back(cmd);
+        }
+
+        m_contentSize = ImVec2(window->DC.CursorMaxPos.x - window->DC.CursorStartPos.x, window->DC.CursorMaxPos.y - window->DC.CursorStartPos.y);
+        m_idealSize = ImVec2(window->DC.IdealMaxPos.x - window->DC.CursorStartPos.x, window->DC.IdealMaxPos.y - window->DC.CursorStartPos.y);
+        m_captured = true;
+        m_rendered = false;
+    }
+
+    void WindowCache::Render()
+    {
+        const int width = static_cast<int>((m_rect.z - m_rect.x) * m_scale.x);
+        const int height = static_cast<int>((m_rect.w - m_rect.y) * m_scale.y);
+
+        if (width != m_width || height != m_height)
+        {
+            if (!m_framebuffer)
+            {
+                glGenFramebuffers(1, &m_framebuffer);
+                glGenTextures(1, &m_texture);
+            }
+
+            GLint lastTexture = 0;
+            glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTexture);
+            glBindTexture(GL_TEXTURE_2D, m_texture);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glBindTexture(GL_TEXTURE_2D, lastTexture);
+
+            m_width = width;
+            m_height = height;
+        }
+
+        GLint lastFramebuffer = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &lastFramebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0);
+
+        GLfloat lastClearColor[4];
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, lastClearColor);
+        const GLboolean lastScissorTest = glIsEnabled(GL_SCISSOR_TEST);
+        glDisable(GL_SCISSOR_TEST);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glClearColor(lastClearColor[0], lastClearColor[1], lastClearColor[2], lastClearColor[3]);
+        if (lastScissorTest)
+            glEnable(GL_SCISSOR_TEST);
+
+        ImDrawData drawData;
+        drawData.Valid = true;
+        drawData.CmdListsCount = 1;
+        drawData.CmdLists = &m_list;
+        drawData.TotalVtxCount = m_list->VtxBuffer.Size;
+        drawData.TotalIdxCount = m_list->IdxBuffer.Size;
+        drawData.TotalInstCount = m_list->InstBuffer.Size;
+        drawData.DisplayPos = ImVec2(m_rect.x, m_rect.y);
+        drawData.DisplaySize = ImVec2(m_rect.z - m_rect.x, m_rect.w - m_rect.y);
+        drawData.FramebufferScale = m_scale;
+        ImGui_ImplOpenGL3_RenderDrawData(&drawData);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, lastFramebuffer);
+        m_rendered = true;
+    }
+
+    struct ImageAtlas::Page
+    {
+        stbrp_context context;
+        std::vector<stbrp_node> nodes;
+        std::vector<unsigned char> pixels;
+        ImTextureID texture = 0;
+        int width = 0, height = 0;
+        int images = 0;
+        int lastUsed = -1;
+        bool shared = true;
+    };
+
+    // Images are packed with a border of their edge pixels so that bilinear filtering doesn't bleed neighbours in
+    static const int ImageAtlasPadding = 1;
+
+    ImageAtlas::ImageAtlas(int pageSize, int maxPages)
+        : m_pageSize(pageSize), m_maxPages(maxPages)
+    {
+        IM_ASSERT(pageSize > 0 && maxPages > 0);
+    }
+
+    ImageAtlas::~ImageAtlas()
+    {
+        // Renderer shutdown already released the textures
+        if (ImGui::GetCurrentContext() == nullptr || ImGui::GetIO().BackendRendererUserData == nullptr)
+        {
+            for (Page* page : m_pages)
+                delete page;
+            return;
+        }
+
+        for (int i = 0; i < (int)m_pages.size(); i++)
+            if (m_pages[i])
+                DestroyPage(i);
+    }
+
+    ImageAtlas::Handle ImageAtlas::Add(const void* pixels, int width, int height)
+    {
+        if (pixels == nullptr || width <= 0 || height <= 0)
+            return 0;
+
+        Handle handle;
+        if (!m_free.empty())
+        {
+            handle = m_free.back();
+            m_free.pop_back();
+        }
+        else
+        {
+            m_entries.emplace_back();
+            handle = (Handle)m_entries.size();
+        }
+
+        Entry& entry = m_entries[handle - 1];
+        entry.pixels.assign((const unsigned char*)pixels, (const unsigned char*)pixels + (size_t)width * height * 4);
+        entry.width = width;
+        entry.height = height;
+        entry.page = -1;
+        return handle;
+    }
+
+    void ImageAtlas::Remove(Handle handle)
+    {
+        if (handle == 0 || handle > m_entries.size() || m_entries[handle - 1].width == 0)
+            return;
+
+        Entry& entry = m_entries[handle - 1];
+        if (entry.page >= 0)
+        {
+            Page* page = m_pages[entry.page];
+            page->images--;
+            if (!page->shared)
+                DestroyPage(entry.page);
+            else if (page->images == 0)
+                EvictPage(entry.page); // Nothing left, reclaim the whole page
+        }
+
+        entry = Entry();
+        m_free.push_back(handle);
+    }
+
+    bool ImageAtlas::Get(Handle handle, ImTextureID& texture, ImVec2& uv0, ImVec2& uv1)
+    {
+        if (handle == 0 || handle > m_entries.size() || m_entries[handle - 1].width == 0)
+            return false;
+
+        Entry& entry = m_entries[handle - 1];
+        if (entry.page < 0 && !Place(entry))
+            return false;
+
+        Page* page = m_pages[entry.page];
+        page->lastUsed = ImGui::GetFrameCount();
+        texture = page->texture;
+        uv0 = ImVec2((float)entry.x / page->width, (float)entry.y / page->height);
+        uv1 = ImVec2((float)(entry.x + entry.width) / page->width, (float)(entry.y + entry.height) / page->height);
+        return true;
+    }
+
+    void ImageAtlas::Image(Handle handle, const ImVec2& size, const ImVec4& tint, const ImVec4& border)
+    {
+        ImTextureID texture;
+        ImVec2 uv0, uv1;
+        if (Get(handle, texture, uv0, uv1))
+            ImGui::Image(texture, size, uv0, uv1, tint, border);
+        else
+            ImGui::Dummy(size);
+    }
+
+    bool ImageAtlas::ImageButton(const char* id, Handle handle, const ImVec2& size)
+    {
+        ImTextureID texture;
+        ImVec2 uv0, uv1;
+        if (Get(handle, texture, uv0, uv1))
+            return ImGui::ImageButton(id, texture, size, uv0, uv1);
+        return ImGui::Button(id, size);
+    }
+
+    void ImageAtlas::AddImage(ImDrawList* drawList, Handle handle, const ImVec2& min, const ImVec2& max, ImU32 col)
+    {
+        ImTextureID texture;
+        ImVec2 uv0, uv1;
+        if (Get(handle, texture, uv0, uv1))
+            drawList->AddImage(texture, min, max, uv0, uv1, col);
+    }
+
+    int ImageAtlas::GetPageCount() const
+    {
+        return (int)std::count_if(m_pages.begin(), m_pages.end(), [](const Page* page) { return page != nullptr; });
+    }
+
+    static bool PackRect(stbrp_context* context, int width, int height, int& x, int& y)
+    {
+        stbrp_rect rect = {};
+        rect.w = (stbrp_coord)width;
+        rect.h = (stbrp_coord)height;
+        stbrp_pack_rects(context, &rect, 1);
+        x = rect.x;
+        y = rect.y;
+        return rect.was_packed != 0;
+    }
+
+    bool ImageAtlas::Place(Entry& entry)
+    {
+        const int width = entry.width + ImageAtlasPadding * 2;
+        const int height = entry.height + ImageAtlasPadding * 2;
+        const int frame = ImGui::GetFrameCount();
+
+        int index = -1;
+        int x = 0, y = 0;
+        if (width > m_pageSize / 2 || height > m_pageSize / 2)
+        {
+            index = CreatePage(width, height, false);
+        }
+        else
+        {
+            int shared = 0;
+            for (int i = 0; i < (int)m_pages.size(); i++)
+            {
+                if (!m_pages[i] || !m_pages[i]->shared)
+                    continue;
+                shared++;
+                if (index < 0 && PackRect(&m_pages[i]->context, width, height, x, y))
+                    index = i;
+            }
+
+            while (index < 0)
+            {
+                // Pages drawn this frame can't be evicted, their UVs are already in the draw lists
+                int lru = -1;
+                for (int i = 0; i < (int)m_pages.size(); i++)
+                    if (m_pages[i] && m_pages[i]->shared && m_pages[i]->lastUsed < frame && (lru < 0 || m_pages[i]->lastUsed < m_pages[lru]->lastUsed))
+                        lru = i;
+
+                if (shared < m_maxPages || lru < 0)
+                {
+                    index = CreatePage(m_pageSize, m_pageSize, true);
+                }
+                else if (shared > m_maxPages)
+                {
+                    // Shrink back after a frame that needed more pages than allowed
+                    DestroyPage(lru);
+                    shared--;
+                    continue;
+                }
+                else
+                {
+                    EvictPage(lru);
+                    index = lru;
+                }
+                if (!PackRect(&m_pages[index]->context, width, height, x, y))
+                    return false;
+            }
+        }
+
+        // Copy with edge pixels extruded into the padding
+        Page* page = m_pages[index];
+        const int stride = page->width * 4;
+        for (int py = 0; py < height; py++)
+        {
+            const int sy = ImClamp(py - ImageAtlasPadding, 0, entry.height - 1);
+            const unsigned char* src = entry.pixels.data() + (size_t)sy * entry.width * 4;
+            unsigned char* dst = page->pixels.data() + (size_t)(y + py) * stride + (size_t)x * 4;
+            for (int px = 0; px < ImageAtlasPadding; px++)
+            {
+                memcpy(dst + px * 4, src, 4);
+                memcpy(dst + (width - 1 - px) * 4, src + (entry.width - 1) * 4, 4);
+            }
+            memcpy(dst + ImageAtlasPadding * 4, src, (size_t)entry.width * 4);
+        }
+        ImGui_ImplOpenGL3_UpdateDynamicTexture(page->texture, x, y, width, height);
+
+        entry.page = index;
+        entry.x = x + ImageAtlasPadding;
+        entry.y = y + ImageAtlasPadding;
+        page->images++;
+        return true;
+    }
+
+    int ImageAtlas::CreatePage(int width, int height, bool shared)
+    {
+        Page* page = new Page();
+        page->width = width;
+        page->height = height;
+        page->shared = shared;
+        page->pixels.assign((size_t)width * height * 4, 0);
+        page->nodes.resize(width);
+        stbrp_init_target(&page->context, width, height, page->nodes.data(), (int)page->nodes.size());
+        page->texture = ImGui_ImplOpenGL3_CreateDynamicTexture(page->pixels.data(), width, height, ImGui_ImplOpenGL3_TextureFormat_RGBA32);
+
+        auto slot = std::find(m_pages.begin(), m_pages.end(), nullptr);
+        if (slot != m_pages.end())
+        {
+            *slot = page;
+            return (int)(slot - m_pages.begin());
+        }
+        m_pages.push_back(page);
+        return (int)m_pages.size() - 1;
+    }
+
+    void ImageAtlas::EvictPage(int index)
+    {
+        Page* page = m_pages[index];
+        for (Entry& entry : m_entries)
+            if (entry.page == index)
+                entry.page = -1;
+        page->images = 0;
+        stbrp_init_target(&page->context, page->width, page->height, page->nodes.data(), (int)page->nodes.size());
+    }
+
+    void ImageAtlas::DestroyPage(int index)
+    {
+        EvictPage(index);
+        ImGui_ImplOpenGL3_DestroyDynamicTexture(m_pages[index]->texture);
+        delete m_pages[index];
+        m_pages[index] = nullptr;
+    }
+
+    // Frames in flight between glReadPixels() and mapping, the oldest one had a whole frame to complete on the GPU
+    static const int CaptureBufferCount = 2;
+
+    static void PutU32BE(std::vector<unsigned char>& out, uint32_t value)
+    {
+        const unsigned char bytes[4] = { (unsigned char)(value >> 24), (unsigned char)(value >> 16), (unsigned char)(value >> 8), (unsigned char)value };
+        out.insert(out.end(), bytes, bytes + 4);
+    }
+
+    // QOI, see https://qoiformat.org/qoi-specification.pdf
+    void EncodeQOI(const unsigned char* rgb, int width, int height, std::vector<unsigned char>& out)
+    {
+        const unsigned char header[4] = { 'q', 'o', 'i', 'f' };
+        out.insert(out.end(), header, header + 4);
+        PutU32BE(out, (uint32_t)width);
+        PutU32BE(out, (uint32_t)height);
+        out.push_back(3); // RGB
+        out.push_back(0); // sRGB
+
+        // Pixels are opaque, entries hold alpha so that unwritten ones (zero alpha) never match like the decoder's
+        unsigned char index[64][4] = {};
+        unsigned char prev[3] = { 0, 0, 0 };
+        int run = 0;
+        const size_t count = (size_t)width * height;
+        for (size_t n = 0; n < count; n++, rgb += 3)
+        {
+            if (rgb[0] == prev[0] && rgb[1] == prev[1] && rgb[2] == prev[2])
+            {
+                if (++run == 62 || n == count - 1)
+                {
+                    out.push_back((unsigned char)(0xC0 | (run - 1)));
+                    run = 0;
+                }
+                continue;
+            }
+            if (run > 0)
+            {
+                out.push_back((unsigned char)(0xC0 | (run - 1)));
+                run = 0;
+            }
+
+            const int hash = (rgb[0] * 3 + rgb[1] * 5 + rgb[2] * 7 + 255 * 11) % 64;
+            if (index[hash][0] == rgb[0] && index[hash][1] == rgb[1] && index[hash][2] == rgb[2] && index[hash][3] == 255)
+            {
+                out.push_back((unsigned char)hash);
+            }
+            else
+            {
+                memcpy(index[hash], rgb, 3);
+                index[hash][3] = 255;
+                const int dr = (signed char)(rgb[0] - prev[0]);
+                const int dg = (signed char)(rgb[1] - prev[1]);
+                const int db = (signed char)(rgb[2] - prev[2]);
+                if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1)
+                {
+                    out.push_back((unsigned char)(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                }
+                else if (dg >= -32 && dg <= 31 && dr - dg >= -8 && dr - dg <= 7 && db - dg >= -8 && db - dg <= 7)
+                {
+                    out.push_back((unsigned char)(0x80 | (dg + 32)));
+                    out.push_back((unsigned char)((dr - dg + 8) << 4 | (db - dg + 8)));
+                }
+                else
+                {
+                    const unsigned char op[4] = { 0xFE, rgb[0], rgb[1], rgb[2] };
+                    out.insert(out.end(), op, op + 4);
+                }
+            }
+            memcpy(prev, rgb, 3);
+        }
+
+        const unsigned char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+        out.insert(out.end(), padding, padding + 8);
+    }
+
+    static void PutChunkPNG(std::vector<unsigned char>& out, const char* type, const unsigned char* data, size_t size)
+    {
+        PutU32BE(out, (uint32_t)size);
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data, data + size);
+        // ImHashData() is the zlib CRC-32
+        PutU32BE(out, ImHashData(data, size, ImHashData(type, 4)));
+    }
+
+    // PNG with stored (uncompressed) deflate blocks, 'scanlines' already start with their filter type byte
+    static void EncodePNG(const unsigned char* scanlines, int width, int height, std::vector<unsigned char>& out, std::vector<unsigned char>& scratch)
+    {
+        const size_t size = ((size_t)width * 3 + 1) * height;
+
+        scratch.clear();
+        scratch.reserve(size + (size / 65535 + 1) * 5 + 6);
+        scratch.push_back(0x78);
+        scratch.push_back(0x01);
+        for (size_t offset = 0; offset < size; )
+        {
+            const size_t block = ImMin<size_t>(size - offset, 65535);
+            const unsigned char header[5] = { (unsigned char)(offset + block == size), (unsigned char)block, (unsigned char)(block >> 8), (unsigned char)~block, (unsigned char)(~block >> 8) };
+            scratch.insert(scratch.end(), header, header + 5);
+            scratch.insert(scratch.end(), scanlines + offset, scanlines + offset + block);
+            offset += block;
+        }
+
+        // Adler-32, 5552 is the longest run before the sums can overflow
+        uint32_t a = 1, b = 0;
+        for (size_t offset = 0; offset < size; )
+        {
+            const size_t end = ImMin<size_t>(size, offset + 5552);
+            for (; offset < end; offset++)
+            {
+                a += scanlines[offset];
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+        }
+        PutU32BE(scratch, b << 16 | a);
+
+        const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        out.insert(out.end(), signature, signature + 8);
+        unsigned char header[13] = { 0, 0, 0, 0, 0, 0, 0, 0, 8, 2, 0, 0, 0 }; // 8 bits RGB
+        for (int n = 0; n < 4; n++)
+        {
+            header[n] = (unsigned char)(width >> (24 - n * 8));
+            header[4 + n] = (unsigned char)(height >> (24 - n * 8));
+        }
+        PutChunkPNG(out, "IHDR", header, sizeof(header));
+        PutChunkPNG(out, "IDAT", scratch.data(), scratch.size());
+        PutChunkPNG(out, "IEND", nullptr, 0);
+    }
+
+    // YUV 4:2:0 planes, BT.601 full range to match the C420jpeg stream header, odd last row/column are cropped
+    static void EncodeY4M(const unsigned char* rgba, int width, int height, std::vector<unsigned char>& out)
+    {
+        const int w = width & ~1, h = height & ~1;
+        const size_t pitch = (size_t)width * 4;
+        const char frame[6] = { 'F', 'R', 'A', 'M', 'E', '\n' };
+        out.insert(out.end(), frame, frame + 6);
+
+        const size_t start = out.size();
+        out.resize(start + (size_t)w * h * 3 / 2);
+        unsigned char* yPlane = out.data() + start;
+        unsigned char* uPlane = yPlane + (size_t)w * h;
+        unsigned char* vPlane = uPlane + (size_t)w * h / 4;
+        for (int y = 0; y < h; y += 2)
+        {
+            // Rows are bottom-up
+            const unsigned char* row0 = rgba + (size_t)(height - 1 - y) * pitch;
+            const unsigned char* row1 = row0 - pitch;
+            for (int x = 0; x < w; x += 2)
+            {
+                const unsigned char* p[4] = { row0 + x * 4, row0 + x * 4 + 4, row1 + x * 4, row1 + x * 4 + 4 };
+                int r = 0, g = 0, b = 0;
+                for (int n = 0; n < 4; n++)
+                {
+                    yPlane[(size_t)(y + n / 2) * w + x + n % 2] = (unsigned char)((77 * p[n][0] + 150 * p[n][1] + 29 * p[n][2] + 128) >> 8);
+                    r += p[n][0]; g += p[n][1]; b += p[n][2];
+                }
+                r = (r + 2) / 4; g = (g + 2) / 4; b = (b + 2) / 4;
+                uPlane[(size_t)(y / 2) * (w / 2) + x / 2] = (unsigned char)ImClamp((-43 * r - 85 * g + 128 * b + 32896) >> 8, 0, 255);
+                vPlane[(size_t)(y / 2) * (w / 2) + x / 2] = (unsigned char)ImClamp((128 * r - 107 * g - 21 * b + 32896) >> 8, 0, 255);
+            }
+        }
+    }
+
+    FrameCapture::~FrameCapture()
+    {
+        Stop();
+    }
+
+    bool FrameCapture::Start(const CaptureSettings& settings)
+    {
+        Stop();
+        IM_ASSERT(settings.frameInterval > 0 && settings.workers > 0 && settings.maxPendingFrames > 0);
+
+        m_settings = settings;
+        m_stats = CaptureStats();
+        m_frameIndex = 0;
+        m_readbackTime = 0.0;
+        m_readbacks = 0;
+        m_nextSequence = m_nextWrite = 0;
+        m_videoWidth = m_videoHeight = 0;
+        m_stopping = false;
+
+        if (m_settings.format == CaptureFormat::Y4M)
+        {
+            m_video = fopen((m_settings.path + ".y4m").c_str(), "wb");
+            if (!m_video)
+                return false;
+        }
+
+        // Memory is bounded by the number of frames, their pixels are allocated on first use
+        for (int n = 0; n < m_settings.maxPendingFrames; n++)
+            m_frames.push_back(new Frame());
+        m_free = m_frames;
+
+        m_buffers.resize(CaptureBufferCount);
+        m_pending.assign(CaptureBufferCount, false);
+        glGenBuffers(CaptureBufferCount, m_buffers.data());
+        m_slot = 0;
+        m_width = m_height = 0;
+
+        for (int n = 0; n < m_settings.workers; n++)
+            m_workers.emplace_back(&FrameCapture::Work, this);
+
+        m_capturing = true;
+        return true;
+    }
+
+    void FrameCapture::Stop()
+    {
+        if (!m_capturing)
+            return;
+
+        for (int n = 0; n < CaptureBufferCount; n++)
+            ReadBack((m_slot + n) % CaptureBufferCount);
+        glDeleteBuffers(CaptureBufferCount, m_buffers.data());
+        m_buffers.clear();
+
+        // Workers drain the queue before leaving
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& worker : m_workers)
+            worker.join();
+        m_workers.clear();
+
+        if (m_video)
+        {
+            fclose(m_video);
+            m_video = nullptr;
+        }
+
+        for (Frame* frame : m_frames)
+            delete frame;
+        m_frames.clear();
+        m_free.clear();
+        m_capturing = false;
+    }
+
+    bool FrameCapture::IsCapturing() const
+    {
+        return m_capturing;
+    }
+
+    void FrameCapture::Capture(uint32_t framebuffer, int width, int height)
+    {
+        if (!m_capturing || width <= 0 || height <= 0)
+            return;
+        if (m_frameIndex++ % m_settings.frameInterval != 0)
+            return;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        GLint lastFramebuffer, lastPackBuffer, lastPackAlignment;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &lastFramebuffer);
+        glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &lastPackBuffer);
+        glGetIntegerv(GL_PACK_ALIGNMENT, &lastPackAlignment);
+
+        // Frames in flight keep the previous size, they are read back before buffers are resized
+        if (width != m_width || height != m_height)
+        {
+            for (int n = 0; n < CaptureBufferCount; n++)
+                ReadBack((m_slot + n) % CaptureBufferCount);
+
+            m_width = width;
+            m_height = height;
+            for (uint32_t buffer : m_buffers)
+            {
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+                glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)width * height * 4, nullptr, GL_STREAM_READ);
+            }
+        }
+
+        ReadBack(m_slot);
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffers[m_slot]);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        m_pending[m_slot] = true;
+        m_slot = (m_slot + 1) % CaptureBufferCount;
+
+        glPixelStorei(GL_PACK_ALIGNMENT, lastPackAlignment);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, lastPackBuffer);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, lastFramebuffer);
+
+        m_readbackTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        m_readbacks++;
+    }
+
+    CaptureStats FrameCapture::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        CaptureStats stats = m_stats;
+        stats.readbackTime = m_readbacks ? m_readbackTime / m_readbacks : 0.0;
+        return stats;
+    }
+
+    void FrameCapture::ReadBack(int slot)
+    {
+        if (!m_pending[slot])
+            return;
+        m_pending[slot] = false;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffers[slot]);
+        if (const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)m_width * m_height * 4, GL_MAP_READ_BIT))
+        {
+            Submit(static_cast<const unsigned char*>(pixels), m_width, m_height);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    void FrameCapture::Submit(const unsigned char* pixels, int width, int height)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_stats.captured++;
+
+        // Under backpressure either this frame or the oldest one not picked up by a worker yet is dropped
+        Frame* frame = nullptr;
+        if (!m_free.empty())
+        {
+            frame = m_free.back();
+            m_free.pop_back();
+        }
+        else if (m_settings.drop == CaptureDrop::Oldest && !m_queue.empty())
+        {
+            frame = m_queue.front();
+            m_queue.pop_front();
+            m_stats.dropped++;
+        }
+        else
+        {
+            m_stats.dropped++;
+            return;
+        }
+        lock.unlock();
+
+        frame->pixels.assign(pixels, pixels + (size_t)width * height * 4);
+        frame->width = width;
+        frame->height = height;
+
+        lock.lock();
+        m_queue.push_back(frame);
+        lock.unlock();
+        m_wake.notify_one();
+    }
+
+    void FrameCapture::Work()
+    {
+        std::vector<unsigned char> output, scratch;
+        for (;;)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty())
+                return;
+
+            // Sequence follows queue order, so it is the capture order of kept frames
+            Frame* frame = m_queue.front();
+            m_queue.pop_front();
+            frame->sequence = m_nextSequence++;
+            lock.unlock();
+
+            output.clear();
+            Encode(*frame, output, scratch);
+            const bool written = Write(*frame, output);
+
+            lock.lock();
+            if (written)
+            {
+                m_stats.encoded++;
+                m_stats.bytesWritten += output.size();
+            }
+            else
+            {
+                m_stats.failed++;
+            }
+            m_free.push_back(frame);
+        }
+    }
+
+    void FrameCapture::Encode(const Frame& frame, std::vector<unsigned char>& output, std::vector<unsigned char>& scratch) const
+    {
+        if (m_settings.format == CaptureFormat::Y4M)
+        {
+            EncodeY4M(frame.pixels.data(), frame.width, frame.height, output);
+            return;
+        }
+
+        // Top row first, framebuffer alpha is meaningless once presented. PNG rows lead with filter type 0 (none)
+        const bool png = m_settings.format == CaptureFormat::PNG;
+        const size_t pitch = (size_t)frame.width * 4;
+        std::vector<unsigned char> rgb(((size_t)frame.width * 3 + png) * frame.height);
+        unsigned char* dst = rgb.data();
+        for (int y = frame.height - 1; y >= 0; y--)
+        {
+            if (png)
+                *dst++ = 0;
+            const unsigned char* src = frame.pixels.data() + y * pitch;
+            for (int x = 0; x < frame.width; x++, src += 4, dst += 3)
+            {
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+            }
+        }
+
+        if (png)
+            EncodePNG(rgb.data(), frame.width, frame.height, output, scratch);
+        else
+            EncodeQOI(rgb.data(), frame.width, frame.height, output);
+    }
+
+    bool FrameCapture::Write(const Frame& frame, const std::vector<unsigned char>& output)
+    {
+        if (m_settings.format != CaptureFormat::Y4M)
+        {
+            char suffix[32];
+            snprintf(suffix, sizeof(suffix), "_%06llu.%s", (unsigned long long)frame.sequence + 1, m_settings.format == CaptureFormat::QOI ? "qoi" : "png");
+            FILE* file = fopen((m_settings.path + suffix).c_str(), "wb");
+            if (!file)
+                return false;
+            const bool written = fwrite(output.data(), 1, output.size(), file) == output.size();
+            return fclose(file) == 0 && written;
+        }
+
+        // Workers encode in parallel but append to the video in sequence order
+        std::unique_lock<std::mutex> lock(m_videoMutex);
+        m_written.wait(lock, [&] { return m_nextWrite == frame.sequence; });
+        m_nextWrite++;
+
+        // Stream size is the first frame's, frames of another size are skipped
+        const int width = frame.width & ~1, height = frame.height & ~1;
+        if (m_videoWidth == 0)
+        {
+            m_videoWidth = width;
+            m_videoHeight = height;
+            fprintf(m_video, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", width, height, m_settings.fps);
+        }
+        const bool written = width == m_videoWidth && height == m_videoHeight && fwrite(output.data(), 1, output.size(), m_video) == output.size();
+
+        lock.unlock();
+        m_written.notify_all();
+        return written;
+    }
+
+    bool DecodeQOI(const unsigned char* data, size_t size, std::vector<unsigned char>& pixels, int& width, int& height)
+    {
+        if (size < 22 || memcmp(data, "qoif", 4) != 0)
+            return false;
+        const uint32_t w = (uint32_t)data[4] << 24 | data[5] << 16 | data[6] << 8 | data[7];
+        const uint32_t h = (uint32_t)data[8] << 24 | data[9] << 16 | data[10] << 8 | data[11];
+        if (w == 0 || h == 0 || w > 16384 || h > 16384)
+            return false;
+        width = (int)w;
+        height = (int)h;
+
+        pixels.resize((size_t)w * h * 4);
+        unsigned char index[64][4] = {};
+        unsigned char px[4] = { 0, 0, 0, 255 };
+        const unsigned char* src = data + 14;
+        const unsigned char* end = data + size - 8;
+        int run = 0;
+        for (unsigned char* dst = pixels.data(); dst < pixels.data() + pixels.size(); dst += 4)
+        {
+            if (run > 0)
+            {
+                run--;
+            }
+            else if (src < end)
+            {
+                const unsigned char op = *src++;
+                if (op == 0xFE && end - src >= 3)
+                {
+                    memcpy(px, src, 3);
+                    src += 3;
+                }
+                else if (op == 0xFF && end - src >= 4)
+                {
+                    memcpy(px, src, 4);
+                    src += 4;
+                }
+                else if ((op & 0xC0) == 0x00)
+                {
+                    memcpy(px, index[op], 4);
+                }
+                else if ((op & 0xC0) == 0x40)
+                {
+                    px[0] += ((op >> 4) & 3) - 2;
+                    px[1] += ((op >> 2) & 3) - 2;
+                    px[2] += (op & 3) - 2;
+                }
+                else if ((op & 0xC0) == 0x80 && src < end)
+                {
+                    const int dg = (op & 0x3F) - 32;
+                    const unsigned char next = *src++;
+                    px[0] += dg + (next >> 4) - 8;
+                    px[1] += dg;
+                    px[2] += dg + (next & 15) - 8;
+                }
+                else if ((op & 0xC0) == 0xC0 && op < 0xFE)
+                {
+                    run = op & 0x3F;
+                }
+                else
+                {
+                    return false;
+                }
+                memcpy(index[(px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64], px, 4);
+            }
+            memcpy(dst, px, 4);
+        }
+        return true;
+    }
+
+    static bool DecodeImage(const unsigned char* data, size_t size, std::vector<unsigned char>& pixels, int& width, int& height)
+    {
+        if (DecodeQOI(data, size, pixels, width, height))
+            return true;
+#ifdef IMGUIEX_HAS_STB_IMAGE
+        int channels;
+        if (unsigned char* decoded = stbi_load_from_memory(data, (int)size, &width, &height, &channels, 4))
+        {
+            pixels.assign(decoded, decoded + (size_t)width * height * 4);
+            stbi_image_free(decoded);
+            return true;
+        }
+#endif
+        return false;
+    }
+
+    // Box filter, every source pixel contributes to exactly one destination pixel
+    static void Downscale(std::vector<unsigned char>& pixels, int& width, int& height, int maxWidth, int maxHeight)
+    {
+        const float scale = ImMin(maxWidth > 0 ? (float)maxWidth / width : 1.0f, maxHeight > 0 ? (float)maxHeight / height : 1.0f);
+        if (scale >= 1.0f)
+            return;
+
+        const int w = ImMax(1, (int)(width * scale + 0.5f));
+        const int h = ImMax(1, (int)(height * scale + 0.5f));
+        std::vector<unsigned char> result((size_t)w * h * 4);
+        std::vector<uint32_t> sums((size_t)w * 4);
+        std::vector<uint32_t> counts(w);
+        for (int y = 0; y < h; y++)
+        {
+            std::fill(sums.begin(), sums.end(), 0);
+            std::fill(counts.begin(), counts.end(), 0);
+            const int y0 = (int)((int64_t)y * height / h), y1 = (int)((int64_t)(y + 1) * height / h);
+            for (int sy = y0; sy < y1; sy++)
+            {
+                const unsigned char* src = pixels.data() + (size_t)sy * width * 4;
+                for (int sx = 0; sx < width; sx++, src += 4)
+                {
+                    const int x = (int)((int64_t)sx * w / width);
+                    uint32_t* sum = &sums[(size_t)x * 4];
+                    sum[0] += src[0]; sum[1] += src[1]; sum[2] += src[2]; sum[3] += src[3];
+                    counts[x]++;
+                }
+            }
+            unsigned char* dst = result.data() + (size_t)y * w * 4;
+            for (int x = 0; x < w * 4; x++)
+                dst[x] = (unsigned char)((sums[x] + counts[x / 4] / 2) / counts[x / 4]);
+        }
+
+        pixels.swap(result);
+        width = w;
+        height = h;
+    }
+
+    TextureLoader::TextureLoader(int workers)
+        : m_workerCount(workers)
+    {
+        IM_ASSERT(workers > 0);
+    }
+
+    TextureLoader::~TextureLoader()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& worker : m_workers)
+            worker.join();
+
+        for (Job* job : m_queue)
+            delete job;
+        for (Job* job : m_done)
+            delete job;
+
+        // Renderer shutdown already released the textures
+        const bool context = ImGui::GetCurrentContext() != nullptr && ImGui::GetIO().BackendRendererUserData != nullptr;
+        for (Entry& entry : m_entries)
+        {
+            if (entry.decoded)
+                delete entry.job;
+            if (context && entry.texture)
+                glDeleteTextures(1, &entry.texture);
+        }
+        if (context && m_defaultPlaceholder)
+            glDeleteTextures(1, &m_defaultPlaceholder);
+    }
+
+    static std::string TextureKey(const std::string& path, int maxWidth, int maxHeight)
+    {
+        return path + '|' + std::to_string(maxWidth) + 'x' + std::to_string(maxHeight);
+    }
 
-#include <backends/imgui_impl_glfw.h>
-#include <backends/imgui_impl_opengl3.h>
+    TextureLoader::Handle TextureLoader::Load(const std::string& path, int maxWidth, int maxHeight)
+    {
+        auto found = m_paths.find(TextureKey(path, maxWidth, maxHeight));
+        if (found != m_paths.end())
+        {
+            m_entries[found->second - 1].refs++;
+            return found->second;
+        }
 
-namespace ImGuiEx
-{
-    Window::Window(const std::string& title, uint32_t width, uint32_t height, bool viewports, bool docking)
-        : m_title(title), m_width(width), m_height(height), m_viewports(viewports), m_docking(docking)
+        Entry entry;
+        entry.path = path;
+        entry.maxWidth = maxWidth;
+        entry.maxHeight = maxHeight;
+        return Queue(std::move(entry));
+    }
+
+    TextureLoader::Handle TextureLoader::LoadMemory(const void* data, size_t size, int maxWidth, int maxHeight)
     {
-        glfwInit();
+        if (data == nullptr || size == 0)
+            return 0;
+
+        Entry entry;
+        entry.source = std::make_shared<const std::vector<unsigned char>>((const unsigned char*)data, (const unsigned char*)data + size);
+        entry.maxWidth = maxWidth;
+        entry.maxHeight = maxHeight;
+        return Queue(std::move(entry));
+    }
 
-        m_handle = glfwCreateWindow(m_width, m_height, m_title.data(), nullptr, glfwGetCurrentContext());
-        glfwMakeContextCurrent(m_handle);
-        glfwSwapInterval(0);
+    TextureLoader::Handle TextureLoader::LoadPixels(const void* pixels, int width, int height, int maxWidth, int maxHeight)
+    {
+        if (pixels == nullptr || width <= 0 || height <= 0)
+            return 0;
+
+        Entry entry;
+        entry.source = std::make_shared<const std::vector<unsigned char>>((const unsigned char*)pixels, (const unsigned char*)pixels + (size_t)width * height * 4);
+        entry.sourceWidth = width;
+        entry.sourceHeight = height;
+        entry.maxWidth = maxWidth;
+        entry.maxHeight = maxHeight;
+        return Queue(std::move(entry));
+    }
 
-        static bool initGL = false;
-        if (!initGL)
+    TextureLoader::Handle TextureLoader::Queue(Entry&& entry)
+    {
+        Handle handle;
+        if (!m_free.empty())
+        {
+            handle = m_free.back();
+            m_free.pop_back();
+        }
+        else
         {
-            initGL = true;
-            gladLoadGL(glfwGetProcAddress);
+            m_entries.emplace_back();
+            handle = (Handle)m_entries.size();
+        }
 
-            Viewport(0, 0, GetWidth(), GetHeight());
-            Clear(0.3f, 0.3f, 0.3f, 0.3f);
+        entry.state = TextureState::Loading;
+        entry.refs = 1;
+        if (!entry.path.empty())
+            m_paths[TextureKey(entry.path, entry.maxWidth, entry.maxHeight)] = handle;
+        m_entries[handle - 1] = std::move(entry);
+
+        Submit(handle);
+        return handle;
+    }
+
+    void TextureLoader::Submit(Handle handle)
+    {
+        Entry& entry = m_entries[handle - 1];
+        Job* job = new Job();
+        job->handle = handle;
+        job->path = entry.path;
+        job->source = entry.source;
+        job->width = entry.sourceWidth;
+        job->height = entry.sourceHeight;
+        job->maxWidth = entry.maxWidth;
+        job->maxHeight = entry.maxHeight;
+        entry.job = job;
+        entry.decoded = false;
+
+        if (m_workers.empty())
+            for (int n = 0; n < m_workerCount; n++)
+                m_workers.emplace_back(&TextureLoader::Work, this);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.push_back(job);
+        }
+        m_wake.notify_one();
+    }
+
+    void TextureLoader::AddRef(Handle handle)
+    {
+        if (GetState(handle) != TextureState::Invalid)
+            m_entries[handle - 1].refs++;
+    }
+
+    void TextureLoader::Release(Handle handle)
+    {
+        if (GetState(handle) != TextureState::Invalid && --m_entries[handle - 1].refs <= 0)
+            Remove(handle);
+    }
+
+    void TextureLoader::Remove(Handle handle)
+    {
+        if (GetState(handle) == TextureState::Invalid)
+            return;
+
+        Entry& entry = m_entries[handle - 1];
+        if (entry.job && entry.decoded)
+        {
+            m_uploads.erase(std::find(m_uploads.begin(), m_uploads.end(), handle));
+            delete entry.job;
+        }
+        else if (entry.job)
+        {
+            // Queued jobs go right away, the others are dropped by Update() once workers are done with them
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto queued = std::find(m_queue.begin(), m_queue.end(), entry.job);
+            if (queued != m_queue.end())
+            {
+                m_queue.erase(queued);
+                delete entry.job;
+            }
+            else
+            {
+                entry.job->cancelled = true;
+            }
+        }
+        if (entry.texture)
+        {
+            m_textures.erase(entry.texture);
+            glDeleteTextures(1, &entry.texture);
         }
+        if (!entry.path.empty())
+            m_paths.erase(TextureKey(entry.path, entry.maxWidth, entry.maxHeight));
+        m_residentBytes -= entry.memory;
 
-        m_lastTime = GetTime();
+        entry = Entry();
+        m_free.push_back(handle);
+    }
+
+    void TextureLoader::Clear()
+    {
+        for (Handle handle = 1; handle <= m_entries.size(); handle++)
+            Remove(handle);
+    }
+
+    void TextureLoader::SetBudget(size_t bytesPerFrame, double millisecondsPerFrame)
+    {
+        m_budgetBytes = bytesPerFrame;
+        m_budgetTime = millisecondsPerFrame;
+    }
+
+    void TextureLoader::SetMemoryBudget(size_t bytes)
+    {
+        m_memoryBudget = bytes;
+    }
+
+    void TextureLoader::SetPlaceholder(ImTextureID texture)
+    {
+        m_placeholder = texture;
+    }
+
+    void TextureLoader::Update()
+    {
+        const auto start = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (Job* job : m_done)
+            {
+                if (job->cancelled)
+                {
+                    delete job;
+                    continue;
+                }
+
+                Entry& entry = m_entries[job->handle - 1];
+                entry.decoded = true;
+                if (job->failed)
+                {
+                    entry.state = TextureState::Failed;
+                    entry.job = nullptr;
+                    delete job;
+                    continue;
+                }
+                entry.width = job->width;
+                entry.height = job->height;
+                m_uploads.push_back(job->handle);
+            }
+            m_done.clear();
+        }
+
+        if (m_placeholder == 0 && m_defaultPlaceholder == 0 && !m_entries.empty())
+        {
+            const unsigned char grey[4] = { 128, 128, 128, 255 };
+            glGenTextures(1, &m_defaultPlaceholder);
+            glBindTexture(GL_TEXTURE_2D, m_defaultPlaceholder);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, grey);
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+
+        if (m_uploads.empty() && (m_memoryBudget == 0 || m_residentBytes <= m_memoryBudget))
+        {
+            m_uploadTime = 0.0;
+            return;
+        }
+
+        GLint lastTexture, lastUnpackBuffer, lastAlignment, lastRowLength;
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTexture);
+        glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &lastUnpackBuffer);
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &lastAlignment);
+        glGetIntegerv(GL_UNPACK_ROW_LENGTH, &lastRowLength);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+        size_t bytes = 0;
+        while (!m_uploads.empty())
+        {
+            const Handle handle = m_uploads.front();
+            if (!Upload(handle, bytes, start))
+                break;
+
+            // Counts as drawn so that it isn't evicted before it had a chance to be
+            Entry& entry = m_entries[handle - 1];
+            entry.state = TextureState::Ready;
+            entry.lastUsed = ImGui::GetFrameCount();
+            delete entry.job;
+            entry.job = nullptr;
+            m_uploads.pop_front();
+        }
+        m_uploadedBytes += bytes;
+
+        // Track() ran for the previous frame, its images are still on screen
+        if (m_memoryBudget > 0)
+        {
+            const int frame = ImGui::GetFrameCount() - 1;
+            while (m_residentBytes > m_memoryBudget)
+            {
+                Handle lru = 0;
+                for (Handle handle = 1; handle <= m_entries.size(); handle++)
+                {
+                    const Entry& entry = m_entries[handle - 1];
+                    if (entry.state == TextureState::Ready && entry.lastUsed < frame && (lru == 0 || entry.lastUsed < m_entries[lru - 1].lastUsed))
+                        lru = handle;
+                }
+                if (lru == 0)
+                    break;
+                Evict(lru);
+            }
+        }
+
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, lastRowLength);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, lastAlignment);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, lastUnpackBuffer);
+        glBindTexture(GL_TEXTURE_2D, lastTexture);
+
+        m_uploadTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    bool TextureLoader::Upload(Handle handle, size_t& bytes, std::chrono::steady_clock::time_point start)
+    {
+        Entry& entry = m_entries[handle - 1];
+        const size_t pitch = (size_t)entry.width * 4;
+        if (entry.memory == 0)
+        {
+            // Storage allocation isn't free either, images that don't fit what is left of the budget start on a fresh frame
+            if (bytes > 0 && bytes + pitch * entry.height > m_budgetBytes)
+                return false;
+
+            if (!entry.texture)
+            {
+                glGenTextures(1, &entry.texture);
+                glBindTexture(GL_TEXTURE_2D, entry.texture);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                m_textures[entry.texture] = handle;
+            }
+            glBindTexture(GL_TEXTURE_2D, entry.texture);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, entry.width, entry.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            entry.memory = pitch * entry.height;
+            m_residentBytes += entry.memory;
+        }
+        else
+        {
+            glBindTexture(GL_TEXTURE_2D, entry.texture);
+        }
+
+        while (entry.uploadedRows < entry.height)
+        {
+            const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (bytes > 0 && (bytes + pitch > m_budgetBytes || elapsed >= m_budgetTime))
+                return false;
+
+            const int rows = ImClamp((int)((m_budgetBytes > bytes ? m_budgetBytes - bytes : 0) / pitch), 1, entry.height - entry.uploadedRows);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, entry.uploadedRows, entry.width, rows, GL_RGBA, GL_UNSIGNED_BYTE, entry.job->pixels.data() + entry.uploadedRows * pitch);
+            entry.uploadedRows += rows;
+            bytes += rows * pitch;
+        }
+        return true;
+    }
+
+    // Texture keeps its name so that IDs handed out stay valid, only its storage shrinks
+    void TextureLoader::Evict(Handle handle)
+    {
+        Entry& entry = m_entries[handle - 1];
+        const unsigned char grey[4] = { 128, 128, 128, 255 };
+        glBindTexture(GL_TEXTURE_2D, entry.texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, grey);
+
+        m_residentBytes -= entry.memory;
+        entry.memory = 0;
+        entry.uploadedRows = 0;
+        entry.state = TextureState::Evicted;
+        m_evictions++;
+    }
+
+    void TextureLoader::Track(const ImDrawData* drawData)
+    {
+        if (m_textures.empty() || drawData == nullptr)
+            return;
+
+        const int frame = ImGui::GetFrameCount();
+        uint32_t last = 0;
+        for (int i = 0; i < drawData->CmdListsCount; i++)
+        {
+            for (const ImDrawCmd& cmd : drawData->CmdLists[i]->CmdBuffer)
+            {
+                const uint32_t texture = (uint32_t)(intptr_t)cmd.GetTexID();
+                if (texture == last)
+                    continue;
+                last = texture;
+
+                auto found = m_textures.find(texture);
+                if (found == m_textures.end())
+                    continue;
+
+                Entry& entry = m_entries[found->second - 1];
+                entry.lastUsed = frame;
+                if (entry.state == TextureState::Evicted)
+                {
+                    entry.state = TextureState::Loading;
+                    Submit(found->second);
+                    m_reloads++;
+                }
+            }
+        }
+    }
+
+    void TextureLoader::Work()
+    {
+        std::vector<unsigned char> data;
+        for (;;)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_stopping)
+                return;
+
+            Job* job = m_queue.front();
+            m_queue.pop_front();
+            lock.unlock();
+
+            if (job->width > 0)
+            {
+                job->pixels = *job->source;
+            }
+            else
+            {
+                data.clear();
+                if (!job->path.empty())
+                {
+                    if (FILE* file = fopen(job->path.c_str(), "rb"))
+                    {
+                        fseek(file, 0, SEEK_END);
+                        const long size = ftell(file);
+                        fseek(file, 0, SEEK_SET);
+                        data.resize(size > 0 ? (size_t)size : 0);
+                        if (fread(data.data(), 1, data.size(), file) != data.size())
+                            data.clear();
+                        fclose(file);
+                    }
+                }
+                const std::vector<unsigned char>& encoded = job->source ? *job->source : data;
+                job->failed = encoded.empty() || !DecodeImage(encoded.data(), encoded.size(), job->pixels, job->width, job->height);
+            }
+            if (!job->failed)
+                Downscale(job->pixels, job->width, job->height, job->maxWidth, job->maxHeight);
+
+            lock.lock();
+            m_done.push_back(job);
+        }
+    }
+
+    TextureState TextureLoader::GetState(Handle handle) const
+    {
+        if (handle == 0 || handle > m_entries.size())
+            return TextureState::Invalid;
+        return m_entries[handle - 1].state;
+    }
 
-        glfwSetWindowUserPointer(m_handle, this);
-        glfwSetInputMode(m_handle, GLFW_STICKY_KEYS, GLFW_TRUE);
-        glfwSetInputMode(m_handle, GLFW_STICKY_MOUSE_BUTTONS, GLFW_TRUE);
-        glfwSetInputMode(m_handle, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
+    ImTextureID TextureLoader::GetTexture(Handle handle)
+    {
+        // Evicted images draw their own grey pixel, so that Track() sees them and reloads them
+        const TextureState state = GetState(handle);
+        if (state == TextureState::Ready || state == TextureState::Evicted)
+            return (ImTextureID)(intptr_t)m_entries[handle - 1].texture;
+        return m_placeholder ? m_placeholder : (ImTextureID)(intptr_t)m_defaultPlaceholder;
+    }
+
+    bool TextureLoader::GetSize(Handle handle, int& width, int& height) const
+    {
+        if (handle == 0 || handle > m_entries.size() || m_entries[handle - 1].width == 0)
+            return false;
+        width = m_entries[handle - 1].width;
+        height = m_entries[handle - 1].height;
+        return true;
+    }
+
+    void TextureLoader::Image(Handle handle, const ImVec2& size, const ImVec4& tint, const ImVec4& border)
+    {
+        ImTextureID texture = GetTexture(handle);
+        if (texture)
+            ImGui::Image(texture, size, ImVec2(0, 0), ImVec2(1, 1), tint, border);
+        else
+            ImGui::Dummy(size);
+    }
+
+    void TextureLoader::AddImage(ImDrawList* drawList, Handle handle, const ImVec2& min, const ImVec2& max, ImU32 col)
+    {
+        ImTextureID texture = GetTexture(handle);
+        if (texture)
+            drawList->AddImage(texture, min, max, ImVec2(0, 0), ImVec2(1, 1), col);
+    }
+
+    TextureLoaderStats TextureLoader::GetStats() const
+    {
+        TextureLoaderStats stats;
+        for (const Entry& entry : m_entries)
+        {
+            stats.loading += entry.state == TextureState::Loading;
+            stats.ready += entry.state == TextureState::Ready;
+            stats.evicted += entry.state == TextureState::Evicted;
+            stats.failed += entry.state == TextureState::Failed;
+        }
+        stats.residentBytes = m_residentBytes;
+        stats.uploadedBytes = m_uploadedBytes;
+        stats.evictions = m_evictions;
+        stats.reloads = m_reloads;
+        stats.uploadTime = m_uploadTime;
+        return stats;
+    }
+
+    Window::Window(const std::string& title, uint32_t width, uint32_t height, bool viewports, bool docking, Platform platform)
+        : m_title(title), m_width(width), m_height(height), m_viewports(viewports), m_docking(docking), m_platform(platform)
+    {
+        if (m_platform == Platform::GLFW)
+        {
+            glfwInit();
+
+            m_handle = glfwCreateWindow(m_width, m_height, m_title.data(), nullptr, glfwGetCurrentContext());
+            glfwMakeContextCurrent(m_handle);
+            glfwSwapInterval(0);
+
+            static bool initGL = false;
+            if (!initGL)
+            {
+                initGL = true;
+                gladLoadGL(glfwGetProcAddress);
+
+                Viewport(0, 0, GetWidth(), GetHeight());
+                Clear(0.3f, 0.3f, 0.3f, 0.3f);
+            }
+
+            glfwSetWindowUserPointer(m_handle, this);
+            glfwSetInputMode(m_handle, GLFW_STICKY_KEYS, GLFW_TRUE);
+            glfwSetInputMode(m_handle, GLFW_STICKY_MOUSE_BUTTONS, GLFW_TRUE);
+            glfwSetInputMode(m_handle, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
+
+            glfwSetFramebufferSizeCallback(m_handle, OnFramebufferSizeCallbackWrapper);
+            glfwSetKeyCallback(m_handle, OnKeyCallbackWrapper);
+            glfwSetCursorPosCallback(m_handle, OnCursorCallbackWrapper);
+            glfwSetMouseButtonCallback(m_handle, OnMouseCallbackWrapper);
+            glfwSetScrollCallback(m_handle, OnScrollCallbackWrapper);
+        }
+        else
+        {
+            // Secondary viewports need platform windows
+            m_viewports = false;
+        }
 
-        glfwSetFramebufferSizeCallback(m_handle, OnFramebufferSizeCallbackWrapper);
-        glfwSetKeyCallback(m_handle, OnKeyCallbackWrapper);
-        glfwSetCursorPosCallback(m_handle, OnCursorCallbackWrapper);
-        glfwSetMouseButtonCallback(m_handle, OnMouseCallbackWrapper);
-        glfwSetScrollCallback(m_handle, OnScrollCallbackWrapper);
+        m_lastTime = GetTime();
 
         IMGUI_CHECKVERSION();
         ImGui::CreateContext();
@@ -56,8 +1965,26 @@ namespace ImGuiEx
 
         ImGui::StyleColorsClassic();
 
-        ImGui_ImplGlfw_InitForOpenGL(m_handle, true);
+        if (m_platform == Platform::GLFW)
+        {
+            ImGui_ImplGlfw_InitForOpenGL(m_handle, true);
+        }
+        else
+        {
+            // The offscreen backend owns the GL context, functions are loaded from whichever library provided it
+            const ImGui_ImplOffscreen_Api api = m_platform == Platform::EGL ? ImGui_ImplOffscreen_Api_EGL : m_platform == Platform::OSMesa ? ImGui_ImplOffscreen_Api_OSMesa : ImGui_ImplOffscreen_Api_Auto;
+            // Without a context Execute() returns false right away
+            m_running = ImGui_ImplOffscreen_Init(static_cast<int>(m_width), static_cast<int>(m_height), api);
+            if (!m_running)
+                return;
+
+            gladLoadGL(ImGui_ImplOffscreen_GetProcAddress);
+            m_framebuffer = ImGui_ImplOffscreen_GetFramebuffer();
+        }
         ImGui_ImplOpenGL3_Init();
+        ImGui_ImplOpenGL3_SetShaderCachePath("imgui_shaders.bin"); // Next to imgui.ini
+        if (m_viewports)
+            ImGui_ImplGlfw_SetWindowPoolSize(8, 2); // First popup and tooltip don't hitch
     }
 
     Window::~Window()
@@ -68,11 +1995,22 @@ namespace ImGuiEx
             layer = nullptr;
         }
 
-        ImGui_ImplOpenGL3_Shutdown();
-        ImGui_ImplGlfw_Shutdown();
+        // Offscreen context goes away with its backend
+        StopCapture();
+        m_textures.Clear();
+        SetDamageTracking(false);
+
+        ImGuiIO& io = ImGui::GetIO();
+        if (io.BackendRendererUserData)
+            ImGui_ImplOpenGL3_Shutdown();
+        if (m_handle)
+            ImGui_ImplGlfw_Shutdown();
+        else if (io.BackendPlatformUserData)
+            ImGui_ImplOffscreen_Shutdown();
         ImGui::DestroyContext();
 
-        glfwDestroyWindow(m_handle);
+        if (m_handle)
+            glfwDestroyWindow(m_handle);
     }
 
     void Window::PushLayer(Layer* layer)
@@ -81,13 +2019,23 @@ namespace ImGuiEx
         m_layers.back()->OnAttach();
     }
 
+    // Seconds, unchanged frames still run this often for timers (text cursor blink, tooltip delay...)
+    static const double DamageIdleTimeout = 0.1;
+
     bool Window::Execute()
     {
+        if (!m_handle && !m_framebuffer)
+            return false;
+
         while (m_running && !ShouldClose())
         {
             ImGui_ImplOpenGL3_NewFrame();
-            ImGui_ImplGlfw_NewFrame();
+            if (m_handle)
+                ImGui_ImplGlfw_NewFrame();
+            else
+                ImGui_ImplOffscreen_NewFrame();
             ImGui::NewFrame();
+            m_textures.Update();
 
             for (auto& layer : m_layers)
             {
@@ -99,11 +2047,11 @@ namespace ImGuiEx
             io.DisplaySize = ImVec2(static_cast<float>(GetWidth()), static_cast<float>(GetHeight()));
 
             ImGui::Render();
+            for (ImGuiViewport* viewport : ImGui::GetPlatformIO().Viewports)
+                m_textures.Track(viewport->DrawData);
 
-            Viewport(0, 0, GetWidth(), GetHeight());
-            Clear(0.3f, 0.3f, 0.3f, 0.3f);
-
-            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            const bool present = RenderFrame(ImGui::GetDrawData(), false);
+            CaptureFrame(ImGui::GetDrawData());
 
             if (io.ConfigFlags & ImGuiConfigFlags_DockingEnable)
             {
@@ -122,8 +2070,16 @@ namespace ImGuiEx
             m_deltaTime = time - m_lastTime;
             m_lastTime = time;
 
-            PollEvents();
-            SwapBuffers();
+            // Nothing changed: skip presenting and wait for an event, with a timeout for timers such as the text cursor blink
+            if (present)
+            {
+                PollEvents();
+                SwapBuffers();
+            }
+            else
+            {
+                WaitEvents(DamageIdleTimeout);
+            }
         }
 
         for (auto& layer : m_layers)
@@ -134,9 +2090,16 @@ namespace ImGuiEx
 
     bool Window::Execute(Layer* layer)
     {        
+        if (!m_handle && !m_framebuffer)
+            return false;
+
         ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
+        if (m_handle)
+            ImGui_ImplGlfw_NewFrame();
+        else
+            ImGui_ImplOffscreen_NewFrame();
         ImGui::NewFrame();
+        m_textures.Update();
         
         layer->OnUpdate(m_deltaTime);
         layer->OnRender();
@@ -145,7 +2108,12 @@ namespace ImGuiEx
         io.DisplaySize = ImVec2(static_cast<float>(GetWidth()), static_cast<float>(GetHeight()));
         
         ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        for (ImGuiViewport* viewport : ImGui::GetPlatformIO().Viewports)
+            m_textures.Track(viewport->DrawData);
+
+        // The caller presents every frame, so unchanged frames are still copied from the damage framebuffer
+        RenderFrame(ImGui::GetDrawData(), true);
+        CaptureFrame(ImGui::GetDrawData());
         
         if (io.ConfigFlags & ImGuiConfigFlags_DockingEnable)
         {
@@ -161,7 +2129,7 @@ namespace ImGuiEx
         }
 
         double time = GetTime();
-        m_deltaTime = m_lastTime - time;
+        m_deltaTime = time - m_lastTime;
         m_lastTime = time;
 
         return true;
@@ -172,6 +2140,131 @@ namespace ImGuiEx
         m_running = false;
     }
 
+    void Window::SetDamageTracking(bool enabled)
+    {
+        m_damageTracking = enabled;
+        m_damage.Invalidate();
+
+        if (!enabled && m_damageFramebuffer)
+        {
+            GLFWwindow* backup = m_handle ? glfwGetCurrentContext() : nullptr;
+            if (m_handle)
+                glfwMakeContextCurrent(m_handle);
+
+            glDeleteFramebuffers(1, &m_damageFramebuffer);
+            glDeleteTextures(1, &m_damageTexture);
+            m_damageFramebuffer = m_damageTexture = 0;
+            m_damageWidth = m_damageHeight = 0;
+
+            if (m_handle)
+                glfwMakeContextCurrent(backup);
+        }
+    }
+
+    bool Window::GetDamageTracking() const
+    {
+        return m_damageTracking;
+    }
+
+    void Window::SetVSync(bool enabled)
+    {
+        m_vsync = enabled;
+        if (m_handle)
+            ImGui_ImplGlfw_SetSwapInterval(enabled ? 1 : 0);
+    }
+
+    bool Window::GetVSync() const
+    {
+        return m_vsync;
+    }
+
+    void Window::CaptureFrame(ImDrawData* drawData)
+    {
+        if (!m_capture.IsCapturing())
+            return;
+
+        // With damage tracking the offscreen copy holds the whole frame, whatever was presented
+        const int width = static_cast<int>(drawData->DisplaySize.x * drawData->FramebufferScale.x);
+        const int height = static_cast<int>(drawData->DisplaySize.y * drawData->FramebufferScale.y);
+        m_capture.Capture(m_damageTracking ? m_damageFramebuffer : m_framebuffer, width, height);
+    }
+
+    bool Window::RenderFrame(ImDrawData* drawData, bool always)
+    {
+        if (m_damageTracking)
+            return RenderDamaged(drawData, always);
+
+        Viewport(0, 0, GetWidth(), GetHeight());
+        Clear(0.3f, 0.3f, 0.3f, 0.3f);
+        ImGui_ImplOpenGL3_RenderDrawData(drawData);
+        return true;
+    }
+
+    bool Window::RenderDamaged(ImDrawData* drawData, bool always)
+    {
+        const int width = static_cast<int>(drawData->DisplaySize.x * drawData->FramebufferScale.x);
+        const int height = static_cast<int>(drawData->DisplaySize.y * drawData->FramebufferScale.y);
+        if (width <= 0 || height <= 0)
+            return false;
+
+        // Default framebuffer content is undefined after a swap, so frames accumulate offscreen
+        if (width != m_damageWidth || height != m_damageHeight)
+        {
+            if (!m_damageFramebuffer)
+            {
+                glGenFramebuffers(1, &m_damageFramebuffer);
+                glGenTextures(1, &m_damageTexture);
+            }
+
+            glBindTexture(GL_TEXTURE_2D, m_damageTexture);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glBindTexture(GL_TEXTURE_2D, 0);
+
+            glBindFramebuffer(GL_FRAMEBUFFER, m_damageFramebuffer);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_damageTexture, 0);
+            glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+
+            m_damageWidth = width;
+            m_damageHeight = height;
+            m_damage.Invalidate();
+        }
+
+        const bool changed = m_damage.Update(drawData);
+        if (!changed && !always)
+            return false;
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_damageFramebuffer);
+        Viewport(0, 0, width, height);
+
+        const ImVec2 offset = drawData->DisplayPos;
+        const ImVec2 scale = drawData->FramebufferScale;
+
+        for (const ImVec4& rect : m_damage.GetRects())
+        {
+            const int x = static_cast<int>((rect.x - offset.x) * scale.x);
+            const int y = static_cast<int>((rect.y - offset.y) * scale.y);
+            const int w = static_cast<int>((rect.z - rect.x) * scale.x);
+            const int h = static_cast<int>((rect.w - rect.y) * scale.y);
+
+            glEnable(GL_SCISSOR_TEST);
+            glScissor(x, height - y - h, w, h);
+            Clear(0.3f, 0.3f, 0.3f, 0.3f);
+
+            m_damage.Clip(drawData, rect);
+            ImGui_ImplOpenGL3_RenderDrawData(drawData);
+            m_damage.Restore(drawData);
+        }
+
+        glDisable(GL_SCISSOR_TEST);
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_damageFramebuffer);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_framebuffer);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+
+        return changed;
+    }
+
     void Window::Viewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
     {
         glViewport(x, y, static_cast<int>(width), static_cast<int>(height));
@@ -185,27 +2278,71 @@ namespace ImGuiEx
 
     bool Window::ShouldClose()
     {
-        return glfwWindowShouldClose(m_handle);
+        return m_handle ? glfwWindowShouldClose(m_handle) : false;
     }
 
     void Window::SwapBuffers()
     {
-        glfwSwapBuffers(m_handle);
+        // Offscreen frames stay in the framebuffer object, nothing to present
+        if (!m_handle)
+            return;
+
+        // Applies the swap interval policy shared with secondary viewports
+        ImGui_ImplGlfw_PresentMainViewport();
+    }
+
+    void Window::ReadPixels(std::vector<unsigned char>& pixels) const
+    {
+        if (!m_handle)
+        {
+            pixels.resize(static_cast<size_t>(m_width) * m_height * 4);
+            ImGui_ImplOffscreen_ReadPixels(pixels.data());
+            return;
+        }
+
+        // Last presented frame is in the front buffer, rows are bottom-up
+        int width = 0, height = 0;
+        glfwGetFramebufferSize(m_handle, &width, &height);
+        std::vector<unsigned char> rows(static_cast<size_t>(width) * height * 4);
+
+        GLint lastFramebuffer, lastPackAlignment;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &lastFramebuffer);
+        glGetIntegerv(GL_PACK_ALIGNMENT, &lastPackAlignment);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glReadBuffer(GL_FRONT);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rows.data());
+        glPixelStorei(GL_PACK_ALIGNMENT, lastPackAlignment);
+        glReadBuffer(GL_BACK);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, lastFramebuffer);
+
+        const size_t pitch = static_cast<size_t>(width) * 4;
+        pixels.resize(rows.size());
+        for (int y = 0; y < height; y++)
+            std::copy_n(rows.data() + (height - 1 - y) * pitch, pitch, pixels.data() + y * pitch);
     }
 
     void Window::WaitEvents()
     {
-        glfwWaitEvents();
+        if (m_handle)
+            glfwWaitEvents();
+    }
+
+    void Window::WaitEvents(double timeout)
+    {
+        if (m_handle)
+            glfwWaitEventsTimeout(timeout);
     }
 
     void Window::PollEvents()
     {
-        glfwPollEvents();
+        if (m_handle)
+            glfwPollEvents();
     }
 
     double Window::GetTime() const
     {
-        return glfwGetTime();
+        return m_handle ? glfwGetTime() : ImGui_ImplOffscreen_GetTime();
     }
 
     void* Window::GetHandle() const
@@ -213,6 +2350,36 @@ namespace ImGuiEx
         return m_handle;
     }
 
+    bool Window::StartCapture(const CaptureSettings& settings)
+    {
+        return m_capture.Start(settings);
+    }
+
+    void Window::StopCapture()
+    {
+        m_capture.Stop();
+    }
+
+    bool Window::IsCapturing() const
+    {
+        return m_capture.IsCapturing();
+    }
+
+    CaptureStats Window::GetCaptureStats() const
+    {
+        return m_capture.GetStats();
+    }
+
+    TextureLoader& Window::GetTextureLoader()
+    {
+        return m_textures;
+    }
+
+    Platform Window::GetPlatform() const
+    {
+        return m_platform;
+    }
+
     const std::string& Window::GetTitle() const
     {
         return m_title;
@@ -230,12 +2397,12 @@ namespace ImGuiEx
 
     Action Window::GetKey(KeyCode code) const
     {
-        return static_cast<Action>(glfwGetKey(m_handle, static_cast<int>(code)));
+        return m_handle ? static_cast<Action>(glfwGetKey(m_handle, static_cast<int>(code))) : Action::Release;
     }
 
     Action Window::GetMouse(ButtonCode code) const
     {
-        return static_cast<Action>(glfwGetMouseButton(m_handle, static_cast<int>(code)));
+        return m_handle ? static_cast<Action>(glfwGetMouseButton(m_handle, static_cast<int>(code))) : Action::Release;
     }
 
     void Window::GetScroll(double& xoffset, double& yoffset) const
@@ -245,7 +2412,9 @@ namespace ImGuiEx
 
     void Window::GetCursor(double& x, double& y) const
     {
-        glfwGetCursorPos(m_handle, &x, &y);
+        x = y = 0.0;
+        if (m_handle)
+            glfwGetCursorPos(m_handle, &x, &y);
         y = m_height - y - 1.0;
     }
 
@@ -1,12 +1,22 @@
 #pragma once
 
+#include <cstdio>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <functional>
+#include <memory>
+#include <unordered_map>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
 
 #include <imgui.h>
 
 struct GLFWwindow;
+struct ImGuiWindow;
 
 namespace ImGuiEx
 {
@@ -178,6 +188,474 @@ namespace ImGuiEx
         virtual void OnRender() {}
     };
 
+#if defined(__cpp_consteval)
+#define IMGUIEX_CONSTEVAL consteval
+#else
+#define IMGUIEX_CONSTEVAL constexpr
+#endif
+
+    // String literal label hashed at compile time, gives the same IDs as ImGui::GetID(label), "##" and "###" included.
+    // Only combining with the ID stack seed is left at runtime, which costs the same whatever the label length.
+    // Create labels with IMGUIEX_LABEL("text"), or as constexpr variables: before C++20 a Label constructed
+    // any other way may be hashed at runtime, which is much slower than ImGui::GetID().
+    struct Label
+    {
+        template <size_t N>
+        explicit IMGUIEX_CONSTEVAL Label(const char (&str)[N])
+            : text(str)
+        {
+            size_t length = 0;
+            while (length < N - 1 && str[length])
+                length++;
+
+            // Like ImHashStr(), "###" restarts hashing from the seed
+            size_t start = 0;
+            for (size_t i = 0; i + 2 < length; i++)
+                if (str[i] == '#' && str[i + 1] == '#' && str[i + 2] == '#')
+                    start = i;
+
+            for (size_t i = start; i < length; i++)
+            {
+                hash ^= static_cast<unsigned char>(str[i]);
+                for (int bit = 0; bit < 8; bit++)
+                    hash = (hash >> 1) ^ (hash & 1 ? Polynomial : 0);
+            }
+
+            // CRC is linear: the seed contributes seed * x^(8 * length) mod polynomial, stored per seed bit
+            uint32_t power = 0x80000000u;       // x^0, bit reflected
+            uint32_t square = 0x00800000u;      // x^8
+            for (size_t n = length - start; n; n >>= 1, square = Multiply(square, square))
+                if (n & 1)
+                    power = Multiply(power, square);
+            for (int bit = 0; bit < 32; bit++)
+            {
+                seedBits[bit] = power;
+                power = (power >> 1) ^ (power & 1 ? Polynomial : 0);
+            }
+        }
+
+        // Same as ImHashStr(text, 0, seed)
+        ImGuiID Combine(ImGuiID seed) const;
+
+        const char* text = nullptr;
+        uint32_t hash = 0;                      // CRC32 state after hashed characters, from a zero state
+        uint32_t seedBits[32] = {};             // Contribution of each seed bit to the final state, highest bit first
+
+    private:
+        static constexpr uint32_t Polynomial = 0xEDB88320u;
+
+        // Carry-less product modulo polynomial, bit reflected like the CRC
+        static constexpr uint32_t Multiply(uint32_t a, uint32_t b)
+        {
+            uint32_t product = 0;
+            for (; a; a <<= 1)
+            {
+                if (a & 0x80000000u)
+                    product ^= b;
+                b = (b >> 1) ^ (b & 1 ? Polynomial : 0);
+            }
+            return product;
+        }
+    };
+
+    // Label hashed by the compiler whatever the language standard, e.g. ImGuiEx::Button(IMGUIEX_LABEL("OK"))
+#define IMGUIEX_LABEL(STR) ([]() -> const ::ImGuiEx::Label& { static constexpr ::ImGuiEx::Label label(STR); return label; }())
+
+    // ImGui equivalents identified by compile time hashed labels
+    ImGuiID GetID(const Label& label);
+    void PushID(const Label& label);
+    bool Button(const Label& label, const ImVec2& size = ImVec2(0, 0));
+    bool Checkbox(const Label& label, bool* v);
+    bool TreeNode(const Label& label);
+    bool CollapsingHeader(const Label& label, ImGuiTreeNodeFlags flags = 0);
+
+    class DamageTracker
+    {
+    public:
+        // Diffs draw commands against the previous frame, returns false if nothing changed
+        bool Update(const ImDrawData* drawData);
+        // Forces full redraw on next update
+        void Invalidate();
+
+        // Restricts draw commands to damaged rectangle, must be followed by Restore()
+        void Clip(ImDrawData* drawData, const ImVec4& rect);
+        void Restore(ImDrawData* drawData);
+
+        const std::vector<ImVec4>& GetRects() const;
+
+    private:
+        struct Entry
+        {
+            ImGuiID hash;
+            ImVec4 rect;
+        };
+
+        void AddRect(const ImVec4& rect);
+
+        bool m_invalid = true;
+        ImVec4 m_bounds;
+
+        std::vector<Entry> m_previous;
+        std::vector<Entry> m_current;
+        std::vector<ImVec4> m_rects;
+        std::vector<ImVec4> m_clipRects;
+        std::vector<ImVec4> m_transformed;  // Screen area drawn by each command with a transform, in order
+
+        // Scratch buffers kept across frames
+        ImVector<ImDrawIdx> m_indices;
+        std::vector<std::pair<ImGuiID, int>> m_sorted;
+        std::vector<bool> m_matched;
+    };
+
+    class WindowCache
+    {
+    public:
+        // Interactive windows are submitted live while hovered or active so that their widgets keep responding
+        WindowCache(bool interactive = true);
+        ~WindowCache();
+
+        WindowCache(const WindowCache&) = delete;
+        WindowCache& operator=(const WindowCache&) = delete;
+
+        // Wraps ImGui::Begin(), returns true when the contents must be submitted, false while the cached image is shown
+        bool Begin(const char* name, bool* open = nullptr, ImGuiWindowFlags flags = 0);
+        // Wraps ImGui::End(), always call it like ImGui::End()
+        void End();
+        // Contents changed, submits them again on next frame
+        void Invalidate();
+
+        bool IsCached() const;
+
+    private:
+        void Capture(ImGuiWindow* window);
+        void Render();
+
+        bool m_interactive = true;
+        bool m_invalid = true;
+        bool m_live = true;
+        bool m_captured = false;
+        bool m_rendered = false;
+
+        ImVec2 m_size;
+        ImVec2 m_offset;
+        ImVec2 m_scroll;
+        ImVec2 m_scale;
+        ImVec2 m_contentSize;
+        ImVec2 m_idealSize;
+        ImVec4 m_rect;
+        int m_idxStart = 0;
+        int m_instStart = 0;
+        int m_cmdStart = 0;
+
+        ImDrawList* m_list = nullptr;
+        uint32_t m_framebuffer = 0;
+        uint32_t m_texture = 0;
+        int m_width = 0, m_height = 0;
+    };
+
+    class ImageAtlas
+    {
+    public:
+        using Handle = uint32_t;
+
+        // Images up to half the page size share pages so that consecutive draws batch, bigger ones get a page of their own.
+        // Least recently drawn pages are evicted when all pages are full, their images are repacked when drawn again.
+        ImageAtlas(int pageSize = 1024, int maxPages = 4);
+        ~ImageAtlas();
+
+        ImageAtlas(const ImageAtlas&) = delete;
+        ImageAtlas& operator=(const ImageAtlas&) = delete;
+
+        // Copies RGBA32 pixels, returns 0 on failure
+        Handle Add(const void* pixels, int width, int height);
+        void Remove(Handle handle);
+
+        // Makes image resident and marks it used this frame, outputs texture and UV rect to draw it with
+        bool Get(Handle handle, ImTextureID& texture, ImVec2& uv0, ImVec2& uv1);
+
+        // ImGui::Image() and ImDrawList::AddImage() equivalents
+        void Image(Handle handle, const ImVec2& size, const ImVec4& tint = ImVec4(1, 1, 1, 1), const ImVec4& border = ImVec4(0, 0, 0, 0));
+        bool ImageButton(const char* id, Handle handle, const ImVec2& size);
+        void AddImage(ImDrawList* drawList, Handle handle, const ImVec2& min, const ImVec2& max, ImU32 col = IM_COL32_WHITE);
+
+        int GetPageCount() const;
+
+    private:
+        struct Page;
+        struct Entry
+        {
+            std::vector<unsigned char> pixels;
+            int width = 0, height = 0;
+            int page = -1;
+            int x = 0, y = 0;
+        };
+
+        bool Place(Entry& entry);
+        int CreatePage(int width, int height, bool shared);
+        void EvictPage(int index);
+        void DestroyPage(int index);
+
+        int m_pageSize = 1024;
+        int m_maxPages = 4;
+
+        std::vector<Entry> m_entries;
+        std::vector<Handle> m_free;
+        std::vector<Page*> m_pages;
+    };
+
+    enum class CaptureFormat
+    {
+        QOI,            // "<path>_000001.qoi" per frame, lossless and fast
+        PNG,            // "<path>_000001.png" per frame, uncompressed
+        Y4M,            // "<path>.y4m" raw YUV 4:2:0 video, playable and encodable with ffmpeg
+    };
+
+    enum class CaptureDrop
+    {
+        Newest,         // Frames captured while all buffers are pending are skipped
+        Oldest,         // Queued frames not being encoded yet are replaced by newer ones
+    };
+
+    struct CaptureSettings
+    {
+        std::string path = "capture";
+        CaptureFormat format = CaptureFormat::QOI;
+        int frameInterval = 1;          // Captures every n-th frame
+        int fps = 60;                   // Frame rate written to video header
+        int workers = 2;
+        int maxPendingFrames = 8;       // Frames read back but not encoded yet, bounds memory use
+        CaptureDrop drop = CaptureDrop::Newest;
+    };
+
+    struct CaptureStats
+    {
+        uint64_t captured = 0;
+        uint64_t dropped = 0;
+        uint64_t encoded = 0;
+        uint64_t failed = 0;
+        uint64_t bytesWritten = 0;
+        double readbackTime = 0.0;      // Average UI thread time per captured frame, in milliseconds
+    };
+
+    class FrameCapture
+    {
+    public:
+        FrameCapture() = default;
+        ~FrameCapture();
+
+        FrameCapture(const FrameCapture&) = delete;
+        FrameCapture& operator=(const FrameCapture&) = delete;
+
+        bool Start(const CaptureSettings& settings);
+        // Reads back pending frames and waits for workers to encode them
+        void Stop();
+        bool IsCapturing() const;
+
+        // Call after rendering, readback goes through pixel buffers so the frame arrives a couple of captures later
+        void Capture(uint32_t framebuffer, int width, int height);
+
+        CaptureStats GetStats() const;
+
+    private:
+        struct Frame
+        {
+            std::vector<unsigned char> pixels;  // RGBA, bottom row first as read from GL
+            int width = 0, height = 0;
+            uint64_t sequence = 0;
+        };
+
+        void ReadBack(int slot);
+        void Submit(const unsigned char* pixels, int width, int height);
+        void Work();
+        void Encode(const Frame& frame, std::vector<unsigned char>& output, std::vector<unsigned char>& scratch) const;
+        bool Write(const Frame& frame, const std::vector<unsigned char>& output);
+
+        CaptureSettings m_settings;
+        bool m_capturing = false;
+        uint64_t m_frameIndex = 0;
+
+        // Readback ring
+        std::vector<uint32_t> m_buffers;
+        std::vector<bool> m_pending;
+        int m_slot = 0;
+        int m_width = 0, m_height = 0;
+        double m_readbackTime = 0.0;
+        uint64_t m_readbacks = 0;
+
+        // Worker pool, frames cycle between free list, queue and workers
+        std::vector<std::thread> m_workers;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_written;
+        std::vector<Frame*> m_frames;
+        std::vector<Frame*> m_free;
+        std::deque<Frame*> m_queue;
+        uint64_t m_nextSequence = 0;
+        bool m_stopping = false;
+        CaptureStats m_stats;
+
+        // Video frames are appended in capture order
+        std::mutex m_videoMutex;
+        FILE* m_video = nullptr;
+        uint64_t m_nextWrite = 0;
+        int m_videoWidth = 0, m_videoHeight = 0;
+    };
+
+    // QOI images, written by FrameCapture and read by TextureLoader
+    // Encodes tightly packed RGB pixels, decodes to RGBA pixels. Decoding returns false on invalid data.
+    void EncodeQOI(const unsigned char* rgb, int width, int height, std::vector<unsigned char>& out);
+    bool DecodeQOI(const unsigned char* data, size_t size, std::vector<unsigned char>& pixels, int& width, int& height);
+
+    enum class TextureState
+    {
+        Invalid,
+        Loading,        // Decoding or waiting for upload, drawn with the placeholder
+        Ready,
+        Evicted,        // Over the memory budget, reloaded when drawn again
+        Failed,
+    };
+
+    struct TextureLoaderStats
+    {
+        uint32_t loading = 0;
+        uint32_t ready = 0;
+        uint32_t evicted = 0;
+        uint32_t failed = 0;
+        uint64_t residentBytes = 0;     // Texture memory of loaded images
+        uint64_t uploadedBytes = 0;
+        uint64_t evictions = 0;
+        uint64_t reloads = 0;
+        double uploadTime = 0.0;        // Spent in the last Update(), in milliseconds
+    };
+
+    class TextureLoader
+    {
+    public:
+        using Handle = uint32_t;
+
+        // Decoding and downscaling run on worker threads, started on first load
+        TextureLoader(int workers = 2);
+        ~TextureLoader();
+
+        TextureLoader(const TextureLoader&) = delete;
+        TextureLoader& operator=(const TextureLoader&) = delete;
+
+        // Queues an image file or encoded image in memory (copied). QOI is always supported, other formats need stb_image.h.
+        // Images larger than maxWidth x maxHeight (when > 0) are downscaled to fit, keeping aspect ratio.
+        // Handles hold one reference, loading the same file with the same maximum size again adds one to the existing image.
+        Handle Load(const std::string& path, int maxWidth = 0, int maxHeight = 0);
+        Handle LoadMemory(const void* data, size_t size, int maxWidth = 0, int maxHeight = 0);
+        // Queues RGBA32 pixels (copied), only downscaling and upload are deferred
+        Handle LoadPixels(const void* pixels, int width, int height, int maxWidth = 0, int maxHeight = 0);
+        void AddRef(Handle handle);
+        // Drops a reference, the image goes with the last one
+        void Release(Handle handle);
+        // Drops the image whatever its references
+        void Remove(Handle handle);
+        // Removes all images, call while the GL context is current
+        void Clear();
+
+        // Uploads decoded images in row strips within the budget, Window calls it once per frame.
+        // At least one strip goes per frame so that huge images still progress.
+        void Update();
+        // Marks images whose textures are drawn by the draw data as used, evicted ones are reloaded.
+        // Window calls it for every viewport after rendering.
+        void Track(const ImDrawData* drawData);
+        void SetBudget(size_t bytesPerFrame, double millisecondsPerFrame);
+        // Least recently drawn images are evicted past this much texture memory, 0 = unlimited.
+        // Images drawn in the last frame are never evicted.
+        void SetMemoryBudget(size_t bytes);
+        // Drawn while loading or on failure, 0 = built-in grey texture
+        void SetPlaceholder(ImTextureID texture);
+
+        TextureState GetState(Handle handle) const;
+        // Placeholder until the image is uploaded, query it every frame. The image's own texture ID stays valid
+        // until it is released, evicted images are shrunk to a grey pixel and reloaded when drawn.
+        ImTextureID GetTexture(Handle handle);
+        // Size after downscaling, false until decoded
+        bool GetSize(Handle handle, int& width, int& height) const;
+
+        // ImGui::Image() and ImDrawList::AddImage() equivalents
+        void Image(Handle handle, const ImVec2& size, const ImVec4& tint = ImVec4(1, 1, 1, 1), const ImVec4& border = ImVec4(0, 0, 0, 0));
+        void AddImage(ImDrawList* drawList, Handle handle, const ImVec2& min, const ImVec2& max, ImU32 col = IM_COL32_WHITE);
+
+        TextureLoaderStats GetStats() const;
+
+    private:
+        using Source = std::shared_ptr<const std::vector<unsigned char>>;
+
+        struct Job
+        {
+            Handle handle = 0;
+            std::string path;
+            Source source;                      // Encoded image, or pixels when width > 0
+            std::vector<unsigned char> pixels;  // Decoded RGBA32
+            int width = 0, height = 0;
+            int maxWidth = 0, maxHeight = 0;
+            bool failed = false;
+            bool cancelled = false;
+        };
+
+        struct Entry
+        {
+            TextureState state = TextureState::Invalid;
+            int refs = 0;
+            Job* job = nullptr;                 // Until ready
+            bool decoded = false;               // Job moved from workers to the upload list
+            uint32_t texture = 0;
+            int width = 0, height = 0;
+            int uploadedRows = 0;
+            size_t memory = 0;                  // Texture storage allocated
+            int lastUsed = -1;                  // Frame last drawn in
+
+            // Kept to reload after eviction
+            std::string path;
+            Source source;
+            int sourceWidth = 0, sourceHeight = 0;
+            int maxWidth = 0, maxHeight = 0;
+        };
+
+        Handle Queue(Entry&& entry);
+        void Submit(Handle handle);
+        void Evict(Handle handle);
+        bool Upload(Handle handle, size_t& bytes, std::chrono::steady_clock::time_point start);
+        void Work();
+
+        int m_workerCount = 2;
+        size_t m_budgetBytes = 4 << 20;
+        double m_budgetTime = 2.0;
+        size_t m_memoryBudget = 0;
+        ImTextureID m_placeholder = 0;
+        uint32_t m_defaultPlaceholder = 0;
+
+        std::vector<Entry> m_entries;
+        std::vector<Handle> m_free;
+        std::unordered_map<std::string, Handle> m_paths;
+        std::unordered_map<uint32_t, Handle> m_textures;    // GL texture to image, for draw tracking
+        std::deque<Handle> m_uploads;       // Decoded, in decode completion order
+        uint64_t m_residentBytes = 0;
+        uint64_t m_uploadedBytes = 0;
+        uint64_t m_evictions = 0;
+        uint64_t m_reloads = 0;
+        double m_uploadTime = 0.0;
+
+        // Worker pool, jobs go from queue to workers to done list
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::deque<Job*> m_queue;
+        std::vector<Job*> m_done;
+        bool m_stopping = false;
+    };
+
+    enum class Platform
+    {
+        GLFW,           // Native window
+        Offscreen,      // EGL if available, OSMesa otherwise
+        EGL,            // Offscreen, EGL surfaceless, no display server needed
+        OSMesa,         // Offscreen, software rendering, no display server nor GPU needed
+    };
+
     class Window
     {
     public:
@@ -187,28 +665,55 @@ namespace ImGuiEx
         using ScrollCallback = std::function<void(double, double)>;
         using FramebufferSizeCallback = std::function<void(double, double)>;
 
-        Window(const std::string& title = "ImGuiEx", uint32_t width = 1280, uint32_t height = 800, bool viewports = false, bool docking = false);
+        // Offscreen platforms render to a framebuffer object without any window, they have no inputs and no viewports.
+        // Execute() returns false when no offscreen context could be created.
+        Window(const std::string& title = "ImGuiEx", uint32_t width = 1280, uint32_t height = 800, bool viewports = false, bool docking = false, Platform platform = Platform::GLFW);
         virtual ~Window();
 
         // Collect layers for further execution
         void PushLayer(Layer* layer);
         // Executes all pushed layers in loop
         bool Execute();
-        // Executes one layer one time
+        // Executes one layer one time, the caller polls events and presents. With damage tracking only changed
+        // regions are redrawn, but the whole frame is copied to the window framebuffer every time.
         bool Execute(Layer* layer);
         // Forcefully exits the application.
         void Close();
 
+        // Redraws only regions changed since previous frame. Execute() skips presentation when nothing changed,
+        // and waits for events instead of running the next frame right away.
+        void SetDamageTracking(bool enabled);
+        bool GetDamageTracking() const;
+
+        // Waits for vsync once per frame, on the main window or on a secondary viewport while the main window is minimized
+        void SetVSync(bool enabled);
+        bool GetVSync() const;
+
         void Viewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
         void Clear(float r = 0.3f, float g = 0.3f, float b = 0.3f, float a = 1.0f);
 
         bool ShouldClose();
         void SwapBuffers();
+        // Reads last rendered frame as RGBA, top row first
+        void ReadPixels(std::vector<unsigned char>& pixels) const;
+
+        // Records presented frames, readback and encoding stay off the frame time as much as possible
+        bool StartCapture(const CaptureSettings& settings = CaptureSettings());
+        void StopCapture();
+        bool IsCapturing() const;
+        CaptureStats GetCaptureStats() const;
+
+        // Images decoded off the UI thread, uploads are spread over frames by Execute()
+        TextureLoader& GetTextureLoader();
+
         void WaitEvents();
+        // Waits at most timeout seconds
+        void WaitEvents(double timeout);
         void PollEvents();
 
         double GetTime() const;
         void* GetHandle() const;
+        Platform GetPlatform() const;
 
         const std::string& GetTitle() const;
         uint32_t GetWidth() const;
@@ -232,18 +737,34 @@ namespace ImGuiEx
         friend void OnCursorCallbackWrapper(GLFWwindow* window, double xpos, double ypos);;
 
     private:
+        // Return whether the frame changed, nothing is drawn when it didn't unless always is set
+        bool RenderFrame(ImDrawData* drawData, bool always);
+        bool RenderDamaged(ImDrawData* drawData, bool always);
+        void CaptureFrame(ImDrawData* drawData);
+
         std::string m_title = "ImGuiEx";
         uint32_t m_width = 1280;
         uint32_t m_height = 960;
 
         bool m_viewports = false;
         bool m_docking = false;
+        Platform m_platform = Platform::GLFW;
+        uint32_t m_framebuffer = 0;
 
         bool m_running = true;
         double m_lastTime = 0.0;
         double m_deltaTime = 0.0;
         double m_xoffset = 0.0, m_yoffset = 0.0;
 
+        bool m_vsync = false;
+        bool m_damageTracking = false;
+        uint32_t m_damageFramebuffer = 0;
+        uint32_t m_damageTexture = 0;
+        int m_damageWidth = 0, m_damageHeight = 0;
+        DamageTracker m_damage;
+        FrameCapture m_capture;
+        TextureLoader m_textures;
+
         GLFWwindow* m_handle = nullptr;
         std::vector<Layer*> m_layers;
 
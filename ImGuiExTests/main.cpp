@@ -0,0 +1,734 @@
+// Regression tests, running headless (no window or GL context needed).
+// Returns non-zero and prints the failed checks when something is wrong.
+
+#include "imguiex.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+
+static int g_checks = 0;
+static int g_failures = 0;
+
+#define CHECK(EXPR)     do { g_checks++; if (!(EXPR)) { g_failures++; printf("%s(%d): CHECK(%s) failed\n", __FILE__, __LINE__, #EXPR); } } while (0)
+
+static ImGuiContext* CreateTestContext()
+{
+    ImGuiContext* ctx = ImGui::CreateContext();
+    ImGui::SetCurrentContext(ctx);
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1280.0f, 720.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    return ctx;
+}
+
+// Hash of what gets rendered: runs of commands sharing a header, and their non-degenerate triangles.
+// Also checks every command only refers to existing indices and vertices.
+static ImU32 HashDrawData(const ImDrawData* draw_data)
+{
+    ImU32 hash = 0;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[n];
+        const ImDrawCmd* prev_cmd = NULL;
+        for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+        {
+            CHECK(cmd.IdxOffset + cmd.ElemCount <= (unsigned int)draw_list->IdxBuffer.Size);
+            if (cmd.IdxOffset + cmd.ElemCount > (unsigned int)draw_list->IdxBuffer.Size)
+                return 0;
+            if (cmd.ElemCount == 0)
+                continue;
+            if (prev_cmd == NULL || memcmp(prev_cmd, &cmd, offsetof(ImDrawCmd, IdxOffset)) != 0)
+                hash = ImHashData(&cmd, offsetof(ImDrawCmd, IdxOffset), hash);
+            prev_cmd = &cmd;
+            for (unsigned int elem_n = 0; elem_n + 2 < cmd.ElemCount; elem_n += 3)
+            {
+                const ImDrawIdx* tri = &draw_list->IdxBuffer.Data[cmd.IdxOffset + elem_n];
+                if (tri[0] == tri[1] && tri[1] == tri[2])
+                    continue;
+                for (int k = 0; k < 3; k++)
+                {
+                    CHECK(cmd.VtxOffset + tri[k] < (unsigned int)draw_list->VtxBuffer.Size);
+                    hash = ImHashData(&draw_list->VtxBuffer.Data[cmd.VtxOffset + tri[k]], sizeof(ImDrawVert), hash);
+                }
+            }
+        }
+    }
+    return hash;
+}
+
+// Tables reorder their draw channels before merging them (see TableMergeDrawChannels()).
+// Channel indices laid out in place by ImDrawListSplitter must follow, and still render the same as copied channels.
+static void TestSplitterReorderedChannels()
+{
+    ImGuiContext* ctx_in_place = CreateTestContext();
+    ImGuiContext* ctx_copied = CreateTestContext();
+    ImGuiTable* table_copied = NULL;
+    for (int frame = 0; frame < 10; frame++)
+    {
+        ImU32 hashes[2];
+        for (int ctx_n = 0; ctx_n < 2; ctx_n++)
+        {
+            ImGui::SetCurrentContext(ctx_n == 0 ? ctx_in_place : ctx_copied);
+            if (ctx_n == 1 && table_copied != NULL)
+                table_copied->DrawSplitter->_IdxCounts.clear(); // Merge by copying, as on the first frame
+
+            ImGui::NewFrame();
+            ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+            ImGui::SetNextWindowSize(ImVec2(800.0f, 600.0f));
+            ImGui::Begin("Test");
+            ImGuiTable* table = NULL;
+            if (ImGui::BeginTable("table", 8, ImGuiTableFlags_ScrollY | ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg, ImVec2(0.0f, 400.0f)))
+            {
+                ImGui::TableSetupScrollFreeze(0, 1);
+                for (int column_n = 0; column_n < 8; column_n++)
+                    ImGui::TableSetupColumn("Column", ImGuiTableColumnFlags_WidthFixed, column_n == 3 ? 12.0f : 80.0f);
+                ImGui::TableHeadersRow();
+                for (int row_n = 0; row_n < 100; row_n++)
+                {
+                    ImGui::TableNextRow();
+                    for (int column_n = 0; column_n < 8; column_n++)
+                    {
+                        ImGui::TableSetColumnIndex(column_n);
+                        ImGui::Text("%d,%d", row_n, column_n);
+                    }
+                }
+                table = ImGui::GetCurrentTable();
+                if (ctx_n == 0 && frame >= 2)
+                    CHECK(table->InnerWindow->DrawList->_IdxSplitter == table->DrawSplitter);
+                ImGui::EndTable();
+            }
+            ImGui::End();
+            ImGui::Render();
+            hashes[ctx_n] = HashDrawData(ImGui::GetDrawData());
+
+            // Channel buffers are left empty when indices were merged in place
+            if (ctx_n == 0 && frame >= 2)
+                for (int channel_n = 1; channel_n < table->DrawSplitter->_Channels.Size; channel_n++)
+                    CHECK(table->DrawSplitter->_Channels[channel_n]._IdxBuffer.Capacity == 0);
+            if (ctx_n == 1)
+                table_copied = table;
+        }
+        CHECK(hashes[0] == hashes[1]);
+    }
+    ImGui::DestroyContext(ctx_in_place);
+    ImGui::DestroyContext(ctx_copied);
+}
+
+// EndFrame() only sorts g.Windows when its order may have changed, focus changes move windows in place.
+// The order must match a full sort every frame (inactive child windows aside, their place isn't used).
+static void TestWindowDisplayOrder()
+{
+    ImGuiContext* ctx_sorted = CreateTestContext();
+    ImGuiContext* ctx_full = CreateTestContext();
+    for (int frame = 0; frame < 60; frame++)
+    {
+        ImVector<ImGuiID> orders[2];
+        for (int ctx_n = 0; ctx_n < 2; ctx_n++)
+        {
+            ImGuiContext& g = *(ctx_n == 0 ? ctx_sorted : ctx_full);
+            ImGui::SetCurrentContext(&g);
+            ImGui::NewFrame();
+            for (int window_n = 0; window_n < 12; window_n++)
+            {
+                if ((frame / 7 + window_n) % 5 == 0)
+                    continue;
+                char name[16];
+                ImFormatString(name, IM_ARRAYSIZE(name), "Window %d", window_n);
+                ImGui::Begin(name);
+                for (int child_n = 0; child_n < window_n % 3; child_n++)
+                {
+                    ImGui::BeginChild((ImGuiID)(((frame / 11) & 1) ? 1 + child_n : 10 - child_n), ImVec2(50.0f, 50.0f));
+                    ImGui::EndChild();
+                }
+                if ((frame * 5 + 3) % 12 == window_n)
+                    ImGui::FocusWindow(ImGui::GetCurrentWindow());
+                ImGui::End();
+            }
+            if (ctx_n == 1)
+                g.WindowsSortDirty = true;
+            ImGui::EndFrame();
+            for (ImGuiWindow* window : g.Windows)
+                if (window->Active || !(window->Flags & ImGuiWindowFlags_ChildWindow))
+                    orders[ctx_n].push_back(window->ID);
+        }
+        CHECK(orders[0].Size == orders[1].Size && memcmp(orders[0].Data, orders[1].Data, (size_t)orders[0].size_in_bytes()) == 0);
+    }
+    ImGui::DestroyContext(ctx_sorted);
+    ImGui::DestroyContext(ctx_full);
+}
+
+// Hit grid cells left empty by windows moving away, or by hidden windows being compacted, must be freed eventually.
+// Windows only move across the desktop along with their viewport, here the main viewport moves a cell or more every frame.
+// Hovering must keep working when the grid is rebuilt.
+static ImVec2 g_MainViewportPos;
+static void   PlatformStub(ImGuiViewport*) {}
+static void   PlatformStubSetVec2(ImGuiViewport*, ImVec2) {}
+static ImVec2 PlatformGetWindowPos(ImGuiViewport*) { return g_MainViewportPos; }
+static ImVec2 PlatformGetWindowSize(ImGuiViewport*) { return ImVec2(1280.0f, 720.0f); }
+
+static void TestWindowHitGridCompaction()
+{
+    ImGuiContext* ctx = CreateTestContext();
+    ImGuiContext& g = *ctx;
+    g.IO.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
+    g.IO.BackendFlags |= ImGuiBackendFlags_PlatformHasViewports | ImGuiBackendFlags_RendererHasViewports;
+    g.IO.ConfigMemoryCompactTimer = 0.5f;
+    ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
+    platform_io.Platform_CreateWindow = platform_io.Platform_DestroyWindow = PlatformStub;
+    platform_io.Platform_SetWindowPos = platform_io.Platform_SetWindowSize = PlatformStubSetVec2;
+    platform_io.Platform_GetWindowPos = PlatformGetWindowPos;
+    platform_io.Platform_GetWindowSize = PlatformGetWindowSize;
+    ImGui::GetMainViewport()->PlatformHandle = &g_MainViewportPos;
+    ImGuiPlatformMonitor monitor;
+    monitor.MainPos = monitor.WorkPos = ImVec2(-1000000.0f, -1000000.0f);
+    monitor.MainSize = monitor.WorkSize = ImVec2(2000000.0f, 2000000.0f);
+    platform_io.Monitors.push_back(monitor);
+
+    int max_cells = 0;
+    for (int frame = 0; frame < 2000; frame++)
+    {
+        g_MainViewportPos = ImVec2((float)(frame % 500) * 300.0f, (float)(frame / 500) * 300.0f);
+        const float x = g_MainViewportPos.x, y = g_MainViewportPos.y;
+        g.IO.MousePos = ImVec2(x + 60.0f, y + 60.0f);
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(x + 10.0f, y + 10.0f));
+        ImGui::SetNextWindowSize(ImVec2(100.0f, 100.0f));
+        ImGui::Begin("Hovered");
+        ImGui::End();
+        for (int window_n = 0; window_n < 20 && frame < 1000; window_n++)
+        {
+            char name[16];
+            ImFormatString(name, IM_ARRAYSIZE(name), "Hidden %d", window_n);
+            ImGui::SetNextWindowPos(ImVec2(x + (float)(window_n % 5) * 250.0f, y + 200.0f + (float)(window_n / 5) * 120.0f));
+            ImGui::SetNextWindowSize(ImVec2(100.0f, 100.0f));
+            ImGui::Begin(name);
+            ImGui::End();
+        }
+        ImGui::Render();
+        ImGui::UpdatePlatformWindows();
+
+        int cells_used_count = 0;
+        for (const ImVector<ImGuiWindow*>& cell : g.WindowsHitGrid.Cells)
+            cells_used_count += (cell.Size > 0) ? 1 : 0;
+        CHECK(cells_used_count == g.WindowsHitGrid.CellsUsedCount);
+        if (frame > 0)
+            CHECK(g.HoveredWindow != NULL && strcmp(g.HoveredWindow->Name, "Hovered") == 0);
+        max_cells = ImMax(max_cells, g.WindowsHitGrid.Cells.Size);
+        g.IO.DeltaTime = (frame < 1000) ? 1.0f / 60.0f : 1.0f; // Let hidden windows get compacted
+    }
+    CHECK(max_cells <= 256 + 64);
+    CHECK(g.WindowsHitGrid.CellsUsedCount <= 16); // "Hovered" and the implicit "Debug" window
+    ImGui::DestroyContext(ctx);
+}
+
+// Without renderer support external geometry is copied into the draw list. With 16-bit indices, buffers of more
+// than 64K vertices used to get their indices wrapped around.
+static void TestExternalGeometryCopy()
+{
+    ImGuiContext* ctx = CreateTestContext();
+    const int vtx_count = 70000;
+    ImVector<ImDrawVert> vertices;
+    vertices.resize(vtx_count);
+    for (int n = 0; n < vtx_count; n++)
+    {
+        vertices[n].pos = ImVec2((float)(n % 1000), (float)(n / 1000));
+        vertices[n].uv = ImVec2(0.0f, 0.0f);
+        vertices[n].col = IM_COL32_WHITE;
+    }
+    ImVector<ImU32> indices;
+    for (int n = 0; n < 3 * 30000; n++)
+        indices.push_back((ImU32)((n * 7919) % vtx_count));
+
+    ImDrawExternalBuffer buffer;
+    buffer.VtxData = vertices.Data;
+    buffer.VtxCount = vertices.Size;
+    buffer.IdxData = indices.Data;
+    buffer.IdxCount = indices.Size;
+    buffer.IdxSize = sizeof(ImU32);
+
+    ImGui::NewFrame();
+    ImDrawList* draw_list = ImGui::GetForegroundDrawList();
+    draw_list->AddExternalGeometry(&buffer, ImGui::GetIO().Fonts->TexID, 3, indices.Size - 3);
+    ImGui::Render();
+
+    // Walk the copied triangles back, they must go through the same vertices
+    int idx_n = 3, mismatches = 0;
+    for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+        for (unsigned int elem_n = 0; elem_n < cmd.ElemCount && idx_n < indices.Size; elem_n++, idx_n++)
+        {
+            const unsigned int vtx_n = cmd.VtxOffset + draw_list->IdxBuffer[cmd.IdxOffset + elem_n];
+            if (vtx_n >= (unsigned int)draw_list->VtxBuffer.Size || memcmp(&draw_list->VtxBuffer[vtx_n], &vertices[indices[idx_n]], sizeof(ImDrawVert)) != 0)
+                mismatches++;
+        }
+    CHECK(idx_n == indices.Size);
+    CHECK(mismatches == 0);
+    ImGui::DestroyContext(ctx);
+}
+
+// A command draws its instances before its triangles. Instances overlapping triangles of the command used to
+// make every window fall back to triangles: ordinary widgets must now be instanced and share few commands.
+static void TestInstancedWindowCommands()
+{
+    ImGuiContext* ctx = CreateTestContext();
+    ImGui::GetIO().BackendFlags |= ImGuiBackendFlags_RendererHasInstancing;
+    ImGui::GetStyle().FrameBorderSize = 1.0f;
+    static bool checked = true;
+    static float value = 0.5f;
+    ImDrawList* draw_list = NULL;
+    for (int frame = 0; frame < 3; frame++)
+    {
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f));
+        ImGui::SetNextWindowSize(ImVec2(300.0f, 200.0f));
+        ImGui::Begin("Instanced");
+        ImGui::Text("Some text");
+        ImGui::Button("Button");
+        ImGui::Checkbox("Checkbox", &checked);
+        ImGui::SliderFloat("Slider", &value, 0.0f, 1.0f);
+        if (ImGui::CollapsingHeader("Header", ImGuiTreeNodeFlags_DefaultOpen))
+            ImGui::Text("More text");
+        draw_list = ImGui::GetWindowDrawList();
+        ImGui::End();
+        ImGui::Render();
+    }
+
+    // Text, frames and borders are instances, only the check mark and the arrows are triangles
+    int inst_count = 0, elem_count = 0;
+    for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+    {
+        CHECK(cmd.InstOffset + cmd.InstCount <= (unsigned int)draw_list->InstBuffer.Size);
+        inst_count += cmd.InstCount;
+        elem_count += cmd.ElemCount;
+    }
+    CHECK(inst_count == draw_list->InstBuffer.Size && inst_count > 50);
+    CHECK(elem_count == draw_list->IdxBuffer.Size && elem_count < 200);
+    CHECK(draw_list->CmdBuffer.Size <= 4);
+    ImGui::DestroyContext(ctx);
+}
+
+// Filled circles and rounded rectangles are single instances when the renderer computes their coverage. They used
+// to fall back to triangles after anything drawn with triangles in the same command, e.g. a line.
+static void TestInstancedShapesAfterTriangles()
+{
+    ImGuiContext* ctx = CreateTestContext();
+    ImGui::GetIO().BackendFlags |= ImGuiBackendFlags_RendererHasInstancing;
+    ImGui::NewFrame();
+    ImDrawList* draw_list = ImGui::GetForegroundDrawList();
+    CHECK((draw_list->Flags & ImDrawListFlags_AllowInstancing) && (draw_list->Flags & ImDrawListFlags_AntiAliasedFill));
+
+    draw_list->AddLine(ImVec2(10.0f, 10.0f), ImVec2(100.0f, 10.5f), IM_COL32_WHITE, 2.0f);
+    const int cmd_count = draw_list->CmdBuffer.Size, idx_count = draw_list->IdxBuffer.Size, inst_count = draw_list->InstBuffer.Size;
+    CHECK(idx_count > 0);
+
+    // Away from the line: instanced, in the same command
+    draw_list->AddCircleFilled(ImVec2(50.0f, 50.0f), 20.0f, IM_COL32(255, 0, 0, 255));
+    CHECK(draw_list->InstBuffer.Size == inst_count + 1 && draw_list->InstBuffer.back().Rounding == 20.0f);
+    draw_list->AddRectFilled(ImVec2(120.0f, 20.0f), ImVec2(160.0f, 40.0f), IM_COL32(0, 255, 0, 255), 6.0f);
+    CHECK(draw_list->InstBuffer.Size == inst_count + 2 && draw_list->InstBuffer.back().Rounding == 6.0f);
+    CHECK(draw_list->IdxBuffer.Size == idx_count);
+    CHECK(draw_list->CmdBuffer.Size == cmd_count && draw_list->CmdBuffer.back().ElemCount == (unsigned int)idx_count);
+
+    // Over the line: still instanced, in a new command drawn after the line
+    draw_list->AddCircleFilled(ImVec2(40.0f, 12.0f), 8.0f, IM_COL32(0, 0, 255, 255));
+    CHECK(draw_list->InstBuffer.Size == inst_count + 3 && draw_list->InstBuffer.back().Rounding == 8.0f);
+    CHECK(draw_list->IdxBuffer.Size == idx_count);
+    CHECK(draw_list->CmdBuffer.Size == cmd_count + 1 && draw_list->CmdBuffer.back().InstCount == 1 && draw_list->CmdBuffer.back().ElemCount == 0);
+
+    ImGui::Render();
+    ImGui::DestroyContext(ctx);
+}
+
+// Clip rects of transformed commands are in local space, they used to be intersected with screen space damaged
+// rectangles. Such commands must be damaged whole and drawn unclipped, or skipped.
+static void TestDamageClipTransformed()
+{
+    ImGuiContext* ctx = CreateTestContext();
+    ImGui::GetIO().BackendFlags |= ImGuiBackendFlags_RendererHasTransform;
+    ImDrawTransform rotation;
+    rotation.AxisX = ImVec2(0.8f, 0.6f);
+    rotation.AxisY = ImVec2(-0.6f, 0.8f);
+    rotation.Origin = ImVec2(300.0f, 300.0f);
+
+    ImGuiEx::DamageTracker damage;
+    for (int frame = 0; frame < 3; frame++)
+    {
+        ImGui::NewFrame();
+        ImDrawList* draw_list = ImGui::GetForegroundDrawList();
+        draw_list->PushClipRect(ImVec2(700.0f, 0.0f), ImVec2(1280.0f, 720.0f));
+        draw_list->AddRectFilled(ImVec2(800.0f, 100.0f), ImVec2(810.0f, 110.0f), IM_COL32(frame * 100, 0, 0, 255)); // Changes away from the transformed square
+        draw_list->PopClipRect();
+        draw_list->AddRectFilled(ImVec2(290.0f, 290.0f), ImVec2(296.0f, 296.0f), IM_COL32(0, frame == 2 ? 255 : 0, 0, 255)); // Changes over it on the last frame
+        draw_list->PushTransform(rotation);
+        draw_list->AddRectFilled(ImVec2(-50.0f, -50.0f), ImVec2(50.0f, 50.0f), IM_COL32_WHITE);
+        draw_list->PopTransform();
+        ImGui::Render();
+
+        ImDrawData* draw_data = ImGui::GetDrawData();
+        const bool changed = damage.Update(draw_data);
+        CHECK(changed);
+        if (frame == 0)
+            continue;
+
+        const ImVec4 square = rotation.ApplyToRect(ImVec4(-50.0f, -50.0f, 50.0f, 50.0f));
+        const ImVec4 local_clip = draw_list->CmdBuffer.back().ClipRect;
+        int drawn = 0;
+        for (const ImVec4& rect : damage.GetRects())
+        {
+            damage.Clip(draw_data, rect);
+            for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+                if (cmd.TransformIdx != 0 && cmd.ElemCount != 0)
+                {
+                    const bool skipped = cmd.ClipRect.z <= cmd.ClipRect.x;
+                    CHECK(skipped || memcmp(&cmd.ClipRect, &local_clip, sizeof(ImVec4)) == 0);
+                    CHECK(skipped || (rect.x <= square.x && rect.y <= square.y && rect.z >= square.z && rect.w >= square.w));
+                    drawn += skipped ? 0 : 1;
+                }
+            damage.Restore(draw_data);
+        }
+        CHECK(drawn == (frame == 2 ? 1 : 0));
+    }
+    ImGui::DestroyContext(ctx);
+}
+
+// Occluders were trusted as soon as they had been opaque for one frame, popups and modals included. Windows behind
+// a modal or a window shown for a single frame then showed without contents once it was gone.
+static void TestOcclusionCullingOccluders()
+{
+    ImGuiContext* ctx = CreateTestContext();
+    ImGui::GetIO().ConfigWindowsOcclusionCulling = true;
+    ImGui::GetStyle().Colors[ImGuiCol_WindowBg].w = 1.0f;
+    ImGui::GetStyle().Colors[ImGuiCol_PopupBg].w = 1.0f;
+
+    // 0: front window, 1: nothing, 2: front window for a single frame, 3: modal
+    const int scenario[] = { 0, 0, 0, 0, 1, 1, 2, 1, 3, 3, 3, 3 };
+    bool back_visible[IM_ARRAYSIZE(scenario)];
+    for (int frame = 0; frame < IM_ARRAYSIZE(scenario); frame++)
+    {
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(100.0f, 100.0f));
+        ImGui::SetNextWindowSize(ImVec2(200.0f, 200.0f));
+        back_visible[frame] = ImGui::Begin("Back", NULL, ImGuiWindowFlags_NoFocusOnAppearing);
+        ImGui::End();
+        if (scenario[frame] == 0 || scenario[frame] == 2)
+        {
+            ImGui::SetNextWindowPos(ImVec2(50.0f, 50.0f));
+            ImGui::SetNextWindowSize(ImVec2(400.0f, 400.0f));
+            ImGui::Begin("Front");
+            ImGui::End();
+        }
+        if (scenario[frame] == 3)
+        {
+            if (!ImGui::IsPopupOpen("Modal"))
+                ImGui::OpenPopup("Modal");
+            ImGui::SetNextWindowPos(ImVec2(50.0f, 50.0f));
+            ImGui::SetNextWindowSize(ImVec2(400.0f, 400.0f));
+            if (ImGui::BeginPopupModal("Modal"))
+                ImGui::EndPopup();
+        }
+        ImGui::Render();
+    }
+
+    // Culled once the front window was stable for 2 frames, and on the frame it disappears (not known in advance)
+    CHECK(back_visible[0] && back_visible[1]);
+    CHECK(!back_visible[2] && !back_visible[3] && !back_visible[4]);
+    CHECK(back_visible[5] && back_visible[6] && back_visible[7]);
+    for (int frame = 8; frame < IM_ARRAYSIZE(scenario); frame++)
+        CHECK(back_visible[frame]);
+    ImGui::DestroyContext(ctx);
+}
+
+// ImHashData()/ImHashStr() run the CRC32 several bytes at a time, and ImHashStr() searches the last "###" of long strings
+// instead of testing every byte. Both must match a plain byte-wise CRC32 resetting to the seed at each "###".
+static ImU32 Crc32Reference(ImU32 crc, const unsigned char* data, size_t data_size)
+{
+    for (size_t n = 0; n < data_size; n++)
+    {
+        crc ^= data[n];
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+    return crc;
+}
+
+static ImGuiID HashStrReference(const char* data, size_t data_size, ImGuiID seed)
+{
+    ImU32 crc = ~seed;
+    for (size_t n = 0; n < data_size; n++)
+    {
+        if (n + 2 < data_size && data[n] == '#' && data[n + 1] == '#' && data[n + 2] == '#')
+            crc = ~seed;
+        crc = Crc32Reference(crc, (const unsigned char*)data + n, 1);
+    }
+    return ~crc;
+}
+
+static void TestHashMatchesReference()
+{
+    CHECK(ImHashData("123456789", 9, 0) == 0xCBF43926); // CRC-32 check value
+    CHECK(ImHashStr("123456789", 0, 0) == 0xCBF43926);
+
+    char buf[8 + 64 + 3];
+    ImU32 state = 12345;
+    int mismatches = 0;
+    for (int len = 0; len <= 64; len++)
+        for (int iter = 0; iter < 200; iter++)
+        {
+            // Unaligned starts, '#' dense contents, "##" right after the end which sized hashes must not see
+            state = state * 1664525u + 1013904223u;
+            char* str = buf + (state >> 29);
+            const ImGuiID seed = (iter & 1) ? state : 0;
+            for (int n = 0; n < len; n++)
+            {
+                state = state * 1664525u + 1013904223u;
+                const unsigned int r = state >> 24;
+                str[n] = (r < 160) ? '#' : (r < 230) ? (char)('a' + r % 26) : (char)(0x80 + r % 64);
+            }
+            str[len] = '#';
+            str[len + 1] = '#';
+
+            const ImGuiID expected = HashStrReference(str, len, seed);
+            if (len > 0 && ImHashStr(str, len, seed) != expected)
+                mismatches++;
+            if (ImHashData(str, len, seed) != ~Crc32Reference(~seed, (const unsigned char*)str, len))
+                mismatches++;
+            str[len] = 0;
+            if (ImHashStr(str, 0, seed) != expected)
+                mismatches++;
+        }
+    CHECK(mismatches == 0);
+
+    // "###" at every position around the end of the byte-wise head, with heads and tails of 0-16 bytes
+    for (int head = 0; head <= 16; head++)
+        for (int tail = 0; tail <= 16; tail++)
+        {
+            char str[16 + 3 + 16 + 1];
+            memset(str, 'x', sizeof(str));
+            memcpy(str + head, "###", 3);
+            str[head + 3 + tail] = 0;
+            const size_t len = strlen(str);
+            CHECK(ImHashStr(str, 0, 42) == HashStrReference(str, len, 42));
+            CHECK(ImHashStr(str, len, 42) == HashStrReference(str, len, 42));
+            CHECK(ImHashStr(str, 0, 42) == ImHashStr(str + head, 0, 42));
+        }
+}
+
+// Hashed ImGuiStorage (SetHashed()) must behave as the sorted one through random operations: sets, gets, references
+// inserting on demand, bulk building, mode switches with live data, clears, and growth past many groups of slots.
+static void TestStorageHashedMatchesSorted()
+{
+    const int key_count = 5000;     // Even key indices hold ints, odd ones pointers
+    ImVector<bool> present;
+    present.resize(key_count, false);
+    ImGuiStorage sorted, hashed, switched;
+    hashed.SetHashed(true);
+    ImGuiStorage* storages[] = { &sorted, &hashed, &switched };
+
+    ImU32 state = 7;
+    int mismatches = 0, max_size = 0;
+    for (int step = 0; step < 60000; step++)
+    {
+        state = state * 1664525u + 1013904223u;
+        const int op = (state >> 24) % 100;
+        state = state * 1664525u + 1013904223u;
+        const int key_n = (int)((state >> 8) % (ImU32)(step < 30000 ? key_count : key_count / 4));
+        const ImGuiID key = (ImGuiID)key_n * 2654435761u;  // Spread, and 0 for key_n == 0
+        const int val = (int)(state >> 4) | 1;    // Never 0 (NULL) nor -1
+        if (op < 30)
+        {
+            for (ImGuiStorage* storage : storages)
+                if (key_n & 1) storage->SetVoidPtr(key, (void*)(intptr_t)val); else storage->SetInt(key, val);
+            present[key_n] = true;
+        }
+        else if (op < 60)
+        {
+            for (ImGuiStorage* storage : storages)
+                if (key_n & 1)
+                    mismatches += storage->GetVoidPtr(key) != sorted.GetVoidPtr(key);
+                else
+                    mismatches += storage->GetInt(key, -1) != sorted.GetInt(key, -1) || (sorted.GetInt(key, -1) == -1 && present[key_n]);
+        }
+        else if (op < 80)
+        {
+            // Insert on demand, then write through the reference
+            void* expected = sorted.GetVoidPtr(key | 1);
+            for (ImGuiStorage* storage : storages)
+            {
+                void** ref = storage->GetVoidPtrRef(key | 1, (void*)(intptr_t)1);
+                mismatches += *ref != (expected ? expected : (void*)(intptr_t)1);
+                *ref = (void*)(intptr_t)val;
+            }
+        }
+        else if (op < 90)
+        {
+            // Bulk build: append missing pairs unsorted, then sort once
+            for (int n = 0; n < 20; n++)
+            {
+                const int bulk_n = (key_n + n * 2) % key_count | 1;
+                if (present[bulk_n])
+                    continue;
+                present[bulk_n] = true;
+                for (ImGuiStorage* storage : storages)
+                    storage->Data.push_back(ImGuiStorage::ImGuiStoragePair((ImGuiID)bulk_n * 2654435761u, (void*)(intptr_t)(val + n)));
+            }
+            for (ImGuiStorage* storage : storages)
+                storage->BuildSortByKey();
+            mismatches += hashed.Data.Size != sorted.Data.Size || memcmp(hashed.Data.Data, sorted.Data.Data, (size_t)sorted.Data.size_in_bytes()) != 0;
+        }
+        else if (op < 99)
+        {
+            switched.SetHashed(!switched.IsHashed());
+        }
+        else if (step % 7 == 0)
+        {
+            for (ImGuiStorage* storage : storages)
+                storage->Clear();
+            for (bool& p : present)
+                p = false;
+        }
+        max_size = ImMax(max_size, sorted.Data.Size);
+    }
+
+    // Same contents
+    for (int key_n = 0; key_n < key_count; key_n++)
+    {
+        const ImGuiID key = (ImGuiID)key_n * 2654435761u;
+        for (ImGuiStorage* storage : storages)
+            mismatches += storage->GetVoidPtr(key) != sorted.GetVoidPtr(key) || storage->GetVoidPtr(key | 1) != sorted.GetVoidPtr(key | 1) || storage->Data.Size != sorted.Data.Size;
+    }
+    CHECK(mismatches == 0);
+    CHECK(hashed.IsHashed() && max_size > 1000);
+}
+
+// ImGuiEx::Label hashes its text at compile time and only combines it with the ID stack seed at runtime. IDs must be
+// those of ImGui::GetID(label), "##" and "###" labels included: checked at compile time against a byte-wise CRC32,
+// and at runtime against ImGui::GetID() under a pushed ID.
+static constexpr ImGuiID LabelHashReference(const char* str, ImGuiID seed)
+{
+    ImU32 crc = ~seed;
+    for (const char* p = str; *p; p++)
+    {
+        if (p[0] == '#' && p[1] == '#' && p[2] == '#')
+            crc = ~seed;
+        crc ^= (unsigned char)*p;
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320u : 0u);
+    }
+    return ~crc;
+}
+
+static constexpr ImGuiID LabelCombineReference(const ImGuiEx::Label& label, ImGuiID seed)
+{
+    ImU32 shifted = 0;
+    for (int bit = 0; bit < 32; bit++)
+        if ((~seed >> (31 - bit)) & 1)
+            shifted ^= label.seedBits[bit];
+    return ~(shifted ^ label.hash);
+}
+
+#define LABEL_STATIC_CHECK(STR, SEED) static_assert(LabelCombineReference(ImGuiEx::Label(STR), SEED) == LabelHashReference(STR, SEED), "Label(" STR ") hash")
+LABEL_STATIC_CHECK("", 0);
+LABEL_STATIC_CHECK("OK", 0);
+LABEL_STATIC_CHECK("OK", 0x12345678);
+LABEL_STATIC_CHECK("Button##hidden", 0xDEADBEEF);
+LABEL_STATIC_CHECK("Shown label###id", 0xDEADBEEF);
+LABEL_STATIC_CHECK("a###b###c", 0xFFFFFFFF);
+LABEL_STATIC_CHECK("####", 42);
+LABEL_STATIC_CHECK("A label longer than the sixteen bytes hashed one at a time", 7);
+#undef LABEL_STATIC_CHECK
+
+static void TestLabelMatchesGetID()
+{
+    ImGuiContext* ctx = CreateTestContext();
+    ImGui::NewFrame();
+    ImGui::Begin("Labels");
+    for (int pass = 0; pass < 2; pass++)
+    {
+        ImGui::PushID(pass ? "Pushed" : "Other");
+        CHECK(ImGuiEx::GetID(IMGUIEX_LABEL("OK")) == ImGui::GetID("OK"));
+        CHECK(ImGuiEx::GetID(IMGUIEX_LABEL("")) == ImGui::GetID(""));
+        CHECK(ImGuiEx::GetID(IMGUIEX_LABEL("Button##hidden")) == ImGui::GetID("Button##hidden"));
+        CHECK(ImGuiEx::GetID(IMGUIEX_LABEL("##hidden")) == ImGui::GetID("##hidden"));
+        CHECK(ImGuiEx::GetID(IMGUIEX_LABEL("Shown label###id")) == ImGui::GetID("Shown label###id"));
+        CHECK(ImGuiEx::GetID(IMGUIEX_LABEL("Other label###id")) == ImGui::GetID("Shown label###id"));
+        CHECK(ImGuiEx::GetID(IMGUIEX_LABEL("a###b###c")) == ImGui::GetID("a###b###c"));
+        CHECK(ImGuiEx::GetID(IMGUIEX_LABEL("A label longer than the sixteen bytes hashed one at a time")) == ImGui::GetID("A label longer than the sixteen bytes hashed one at a time"));
+        static constexpr ImGuiEx::Label label("Variable##label");
+        CHECK(ImGuiEx::GetID(label) == ImGui::GetID("Variable##label"));
+        CHECK(label.Combine(ImGui::GetID("seed")) == ImHashStr("Variable##label", 0, ImGui::GetID("seed")));
+
+        // Pushed labels seed what follows the same way
+        ImGuiEx::PushID(IMGUIEX_LABEL("Scope###scope"));
+        const ImGuiID inner = ImGui::GetID("Inner");
+        ImGui::PopID();
+        ImGui::PushID("Scope###scope");
+        CHECK(inner == ImGui::GetID("Inner"));
+        ImGui::PopID();
+        ImGui::PopID();
+    }
+    ImGui::End();
+    ImGui::EndFrame();
+    ImGui::DestroyContext(ctx);
+}
+
+// Encoded QOI images must decode to the same pixels, opaque. Black pixels used to match the encoder's never written
+// index entry, and decode as transparent.
+static void TestQOIRoundTrip()
+{
+    const int width = 37, height = 23;
+    std::vector<unsigned char> rgb(width * height * 3);
+    ImU32 state = 1;
+    for (size_t n = 0; n < rgb.size(); n += 3)
+    {
+        state = state * 1664525u + 1013904223u;
+        const int kind = (n == 0) ? 2 : (state >> 24) % 4; // Black first would be written to the index by the decoder too
+        for (int c = 0; c < 3; c++)
+        {
+            if (kind == 0)
+                rgb[n + c] = 0;                                                 // Black
+            else if (kind == 1 && n >= 3)
+                rgb[n + c] = (unsigned char)(rgb[n - 3 + c] + (state >> (8 * c)) % 3); // Small difference
+            else
+                rgb[n + c] = (unsigned char)(state >> (8 * c + 4));              // Anything
+        }
+    }
+
+    std::vector<unsigned char> encoded;
+    ImGuiEx::EncodeQOI(rgb.data(), width, height, encoded);
+    std::vector<unsigned char> rgba;
+    int decoded_width = 0, decoded_height = 0;
+    CHECK(ImGuiEx::DecodeQOI(encoded.data(), encoded.size(), rgba, decoded_width, decoded_height));
+    CHECK(decoded_width == width && decoded_height == height);
+    if (rgba.size() != (size_t)width * height * 4)
+        return;
+
+    int mismatches = 0;
+    for (int n = 0; n < width * height; n++)
+        if (memcmp(&rgba[n * 4], &rgb[n * 3], 3) != 0 || rgba[n * 4 + 3] != 255)
+            mismatches++;
+    CHECK(mismatches == 0);
+}
+
+int main()
+{
+    IMGUI_CHECKVERSION();
+
+    TestSplitterReorderedChannels();
+    TestWindowDisplayOrder();
+    TestWindowHitGridCompaction();
+    TestExternalGeometryCopy();
+    TestInstancedWindowCommands();
+    TestInstancedShapesAfterTriangles();
+    TestDamageClipTransformed();
+    TestOcclusionCullingOccluders();
+    TestHashMatchesReference();
+    TestStorageHashedMatchesSorted();
+    TestLabelMatchesGetID();
+    TestQOIRoundTrip();
+
+    printf("%d checks, %d failed\n", g_checks, g_failures);
+    return g_failures == 0 ? 0 : 1;
+}